@@ -0,0 +1,131 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+    @file Benchmark_Execution.cpp
+    @brief Contains the benchmarks for the Execution class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <any>        // for any, any_cast, bad_any_cast
+#include <map>        // for map
+#include <stdexcept>  // for out_of_range
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include "Benchmark_Utility.hpp"
+#include "Execution.hpp"
+
+namespace
+{
+//! @brief The pipeline state query as it was implemented before pipeline
+//! stages were stored as columns. A Normal state was detected by catching
+//! std::bad_any_cast and a missing value by catching std::out_of_range,
+//! meaning that every normally executing clock cycle threw an exception.
+//! This is kept only as a point of comparison.
+bool legacy_is_normal_state_unsafe(
+    const std::vector<std::map<const std::string, std::any>>& p_pipeline,
+    const std::uint32_t p_cycle,
+    const std::string& p_pipeline_stage_name)
+{
+    GILES::Internal::Execution::State state;
+    try
+    {
+        try
+        {
+            state = std::any_cast<GILES::Internal::Execution::State>(
+                p_pipeline.at(p_cycle).at(p_pipeline_stage_name));
+        }
+        catch (const std::bad_any_cast&)
+        {
+            state = GILES::Internal::Execution::State::Normal;
+        }
+    }
+    catch (const std::out_of_range&)
+    {
+        state = GILES::Internal::Execution::State::Stalled;
+    }
+    return GILES::Internal::Execution::State::Normal == state;
+}
+}  // namespace
+
+TEST_CASE("Execution pipeline state queries",
+          "[execution][benchmark]")
+{
+    constexpr std::size_t cycles{10000};
+    const auto execution = GILES::Benchmark::Make_Execution(cycles);
+    const auto execute   = execution.Get_Stage_Handle("Execute");
+
+    // Rebuild the same pipeline stage in the previous storage format.
+    std::vector<std::map<const std::string, std::any>> legacy_pipeline(cycles);
+    for (std::uint32_t i{0}; i < cycles; ++i)
+    {
+        if (execution.Is_Normal_State(i, execute))
+        {
+            legacy_pipeline[i]["Execute"] =
+                execution.Get_Value<std::string>(i, execute);
+        }
+        else
+        {
+            legacy_pipeline[i]["Execute"] = execution.Get_State(i, execute);
+        }
+    }
+
+    BENCHMARK("Is_Normal_State_Unsafe, exception based (previous)")
+    {
+        std::size_t normal{0};
+        for (std::uint32_t i{0}; i < cycles; ++i)
+        {
+            normal +=
+                legacy_is_normal_state_unsafe(legacy_pipeline, i, "Execute");
+        }
+        return normal;
+    };
+
+    BENCHMARK("Is_Normal_State_Unsafe, by name")
+    {
+        std::size_t normal{0};
+        for (std::uint32_t i{0}; i < cycles; ++i)
+        {
+            normal += execution.Is_Normal_State_Unsafe(i, "Execute");
+        }
+        return normal;
+    };
+
+    BENCHMARK("Is_Normal_State_Unsafe, by handle")
+    {
+        std::size_t normal{0};
+        for (std::uint32_t i{0}; i < cycles; ++i)
+        {
+            normal += execution.Is_Normal_State_Unsafe(i, execute);
+        }
+        return normal;
+    };
+
+    BENCHMARK("Is_Normal_State, by handle")
+    {
+        std::size_t normal{0};
+        for (std::uint32_t i{0}; i < cycles; ++i)
+        {
+            normal += execution.Is_Normal_State(i, execute);
+        }
+        return normal;
+    };
+}
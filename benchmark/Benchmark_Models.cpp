@@ -0,0 +1,264 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+    @file Benchmark_Models.cpp
+    @brief Contains the benchmarks for the leakage models.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <algorithm>  // for max
+#include <chrono>     // for steady_clock, duration
+#include <cmath>      // for abs
+#include <memory>     // for make_shared, shared_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include <fmt/format.h>  // for print
+
+#include "Abstract_Factory.hpp"  // for Model_Factory
+#include "Benchmark_Utility.hpp"
+#include "Expression/Model_Expression.hpp"  // for Model_Expression
+#include "Model.hpp"
+#include "Model_Kernels.hpp"        // for Model_Kernels
+#include "Power/Model_Power.hpp"  // for Model_Power
+
+TEST_CASE("Model trace generation",
+          "[models][benchmark]")
+{
+    constexpr std::size_t cycles{10000};
+    const auto execution = std::make_shared<const GILES::Internal::Execution>(
+        GILES::Benchmark::Make_Execution(cycles));
+    const auto coefficients = GILES::Benchmark::Load_Coefficients();
+
+    BENCHMARK("Hamming Weight")
+    {
+        return GILES::Internal::Model_Factory::Construct(
+                   "Hamming Weight", execution, coefficients)
+            ->Generate_Traces();
+    };
+
+    BENCHMARK("Power")
+    {
+        return GILES::Internal::Model_Factory::Construct(
+                   "Power", execution, coefficients)
+            ->Generate_Traces();
+    };
+}
+
+TEST_CASE("Power model batches",
+          "[models][benchmark]")
+{
+    using Executions =
+        std::vector<std::shared_ptr<const GILES::Internal::Execution>>;
+
+    // Runs of a constant time program on different data.
+    constexpr std::size_t cycles{10000};
+    constexpr std::size_t traces{16};
+    Executions executions;
+    for (std::size_t i{0}; i < traces; ++i)
+    {
+        executions.push_back(std::make_shared<const GILES::Internal::Execution>(
+            GILES::Benchmark::Make_Execution(cycles, i + 1)));
+    }
+    const auto coefficients = GILES::Benchmark::Load_Coefficients();
+
+    BENCHMARK("Power (16 traces, one at a time)")
+    {
+        std::vector<std::vector<float>> generated;
+        for (const auto& execution : executions)
+        {
+            generated.emplace_back(
+                GILES::Internal::Model_Factory::Construct(
+                    "Power", execution, coefficients)
+                    ->Generate_Traces());
+        }
+        return generated;
+    };
+
+    BENCHMARK("Power (16 traces, batched)")
+    {
+        return GILES::Internal::Model_Factory::Construct(
+                   "Power", executions.front(), coefficients)
+            ->Generate_Batch_Traces(
+                Executions(executions.begin() + 1, executions.end()));
+    };
+}
+
+TEST_CASE("Power model kernels",
+          "[models][model_kernels][benchmark]")
+{
+    using GILES::Internal::Model_Kernels;
+
+    constexpr std::size_t cycles{10000};
+    const auto execution = std::make_shared<const GILES::Internal::Execution>(
+        GILES::Benchmark::Make_Execution(cycles));
+    const auto coefficients = GILES::Benchmark::Load_Coefficients();
+
+    const auto generate_traces = [&execution, &coefficients] {
+        return GILES::Internal::Model_Factory::Construct(
+                   "Power", execution, coefficients)
+            ->Generate_Traces();
+    };
+
+    // Compare every level of instruction set supported by this CPU.
+    for (const auto level : Model_Kernels::All_ISAs)
+    {
+        if (!Model_Kernels::Is_Supported(level))
+        {
+            continue;
+        }
+        Model_Kernels::Select(level);
+        const auto name = Model_Kernels::Get_Name(level);
+
+        BENCHMARK("Power (" + name + ")")
+        {
+            return generate_traces();
+        };
+
+        // The throughput in clock cycles per second is easier to compare
+        // against the length of real Executions.
+        constexpr std::size_t runs{20};
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i{0}; i < runs; ++i)
+        {
+            generate_traces();
+        }
+        const std::chrono::duration<double> elapsed{
+            std::chrono::steady_clock::now() - start};
+        fmt::print("Power ({}): {:.0f} clock cycles/second\n",
+                   name,
+                   cycles * runs / elapsed.count());
+    }
+    Model_Kernels::Select(Model_Kernels::Get_Supported());
+}
+
+TEST_CASE("Power model precision",
+          "[models][benchmark]")
+{
+    using GILES::Internal::Model_Power;
+
+    // Runs of the benchmark program on different data.
+    constexpr std::size_t cycles{10000};
+    constexpr std::size_t runs{8};
+    std::vector<std::shared_ptr<const GILES::Internal::Execution>> executions;
+    for (std::size_t i{0}; i < runs; ++i)
+    {
+        executions.push_back(std::make_shared<const GILES::Internal::Execution>(
+            GILES::Benchmark::Make_Execution(cycles, i + 1)));
+    }
+    const auto coefficients = GILES::Benchmark::Load_Coefficients();
+
+    const auto generate_traces =
+        [&coefficients, &executions](const std::string& p_model,
+                                     const std::size_t p_run) {
+            return GILES::Internal::Model_Factory::Construct(
+                       p_model, executions[p_run], coefficients)
+                ->Generate_Traces();
+        };
+
+    std::vector<std::vector<float>> reference;
+    for (std::size_t run{0}; run < runs; ++run)
+    {
+        reference.push_back(generate_traces(
+            Model_Power::Get_Name(Model_Power::Precision::Double), run));
+    }
+
+    for (const auto precision : {Model_Power::Precision::Double,
+                                 Model_Power::Precision::Float,
+                                 Model_Power::Precision::Fixed_Point})
+    {
+        const auto name = Model_Power::Get_Name(precision);
+
+        BENCHMARK(std::string{name})
+        {
+            return generate_traces(name, 0);
+        };
+
+        // The deviation from the double precision reference over every
+        // sample of every run.
+        double max_deviation{0};
+        double total_deviation{0};
+        double max_relative_deviation{0};
+        std::size_t samples{0};
+        for (std::size_t run{0}; run < runs; ++run)
+        {
+            const auto traces = generate_traces(name, run);
+            for (std::size_t i{0}; i < traces.size(); ++i)
+            {
+                const double deviation{
+                    std::abs(static_cast<double>(traces[i]) -
+                             reference[run][i])};
+                max_deviation = std::max(max_deviation, deviation);
+                total_deviation += deviation;
+                if (0 != reference[run][i])
+                {
+                    max_relative_deviation =
+                        std::max(max_relative_deviation,
+                                 deviation / std::abs(reference[run][i]));
+                }
+                ++samples;
+            }
+        }
+        fmt::print("{}: max deviation {:.3g}, mean deviation {:.3g}, max "
+                   "relative deviation {:.3g}\n",
+                   name,
+                   max_deviation,
+                   total_deviation / samples,
+                   max_relative_deviation);
+    }
+}
+
+TEST_CASE("Expression models",
+          "[models][benchmark]")
+{
+    constexpr std::size_t cycles{10000};
+    const auto execution = std::make_shared<const GILES::Internal::Execution>(
+        GILES::Benchmark::Make_Execution(cycles));
+    const auto coefficients = GILES::Benchmark::Load_Coefficients();
+
+    // The same leakage as the native Hamming Weight model, and most of the
+    // Power model, written in the expression language.
+    GILES::Internal::Model_Expression::Register("Expression Hamming Weight",
+                                                "leakage = hw(op1);");
+    GILES::Internal::Model_Expression::Register(
+        "Expression Power",
+        "flips1 = op1 ^ prev.op1;\n"
+        "flips2 = op2 ^ prev.op2;\n"
+        "leakage = constant * (bits(\"Operand1\", op1)\n"
+        "    + bits(\"Operand2\", op2)\n"
+        "    + pairs(\"Operand1_Bit_Interactions\", op1)\n"
+        "    + bits(\"Bit_Flip1\", flips1)\n"
+        "    + bits(\"Bit_Flip2\", flips2)\n"
+        "    + coefficient(\"Previous_Instruction\", prev)\n"
+        "    + coefficient(\"Subsequent_Instruction\", next)\n"
+        "    + hw(op1) + hd(op1, op2));\n");
+
+    for (const std::string name :
+         {"Hamming Weight", "Expression Hamming Weight", "Expression Power"})
+    {
+        BENCHMARK(std::string{name})
+        {
+            return GILES::Internal::Model_Factory::Construct(
+                       name, execution, coefficients)
+                ->Generate_Traces();
+        };
+    }
+}
@@ -0,0 +1,153 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+    @file Benchmark_Utility.hpp
+    @brief Contains helpers for creating the inputs used by the benchmarks.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef BENCHMARK_UTILITY_HPP
+#define BENCHMARK_UTILITY_HPP
+
+#include <array>    // for array
+#include <cstdint>  // for uint32_t, uint64_t
+#include <fstream>  // for ifstream
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include <nlohmann/json.hpp>  // for json
+
+#include "Coefficients.hpp"
+#include "Execution.hpp"
+#include "Test_Utility.hpp"  // for Make_Execution
+
+namespace GILES
+{
+namespace Benchmark
+{
+//! The text stored by Emulator_Thumb_Sim whilst the pipeline is stalled.
+const std::string stalled{"Stalled, pending decode"};
+
+//! @brief Creates an Execution resembling one produced by Emulator_Thumb_Sim,
+//! with a repeating program containing stalls and registers that change
+//! pseudo randomly every clock cycle.
+//! @param p_number_of_cycles The number of clock cycles in the Execution.
+//! @param p_seed The seed of the values of the registers. Executions with
+//! different seeds run the same program on different data.
+//! @returns The Execution.
+inline GILES::Internal::Execution
+Make_Execution(const std::size_t p_number_of_cycles,
+               const std::uint64_t p_seed = 1)
+{
+    const std::vector<std::string> program{"adds r0, r1",
+                                           "eors r2, r3",
+                                           "ldr r0, [r1, #4]",
+                                           stalled,
+                                           "str r0, [r1]",
+                                           "lsls r1, r2, #3",
+                                           "muls r0, r1",
+                                           "movs r0, 10",
+                                           "ands r4, r5",
+                                           "subs r6, r7",
+                                           "cmp r0, r1",
+                                           "lsrs r3, r4, 2",
+                                           "ldr r5, [sp, #8]",
+                                           stalled,
+                                           "adds r0, r1, r2",
+                                           "eors r7, r6"};
+
+    const std::array<std::string, 17> register_names{
+        "r0", "r1", "r2",  "r3",  "r4",  "r5", "r6", "r7",  "r8",
+        "r9", "r10", "r11", "r12", "sp", "lr", "pc", "xpsr"};
+
+    // A linear congruential generator is used so that every run of the
+    // benchmarks uses the same values.
+    std::uint64_t random{p_seed};
+    auto execution = GILES::Test::Make_Execution(
+        p_number_of_cycles,
+        {{"Fetch", program}, {"Decode", program}, {"Execute", program}},
+        register_names,
+        [&random](const std::size_t,
+                  std::array<std::uint32_t, 17>& p_registers) {
+            random = random * 6364136223846793005u + 1442695040888963407u;
+            p_registers[(random >> 33) % p_registers.size()] =
+                static_cast<std::uint32_t>((random >> 16) & 0xFFFFFFFF);
+        });
+
+    for (std::size_t i{0}; i < p_number_of_cycles; ++i)
+    {
+        if (stalled == program[i % program.size()])
+        {
+            execution.Add_Value(
+                i, "Execute", GILES::Internal::Execution::State::Stalled);
+        }
+    }
+    return execution;
+}
+
+//! @brief Loads the coefficients that are distributed with GILES.
+//! @returns The coefficients.
+inline GILES::Internal::Coefficients Load_Coefficients()
+{
+    std::ifstream file{GILES_BENCHMARK_COEFFICIENTS};
+    return GILES::Internal::Coefficients{nlohmann::json::parse(file)};
+}
+
+//! @brief Generates a valid set of coefficients resembling per opcode
+//! profiles, with many categories that each list a few instructions.
+//! @param p_number_of_categories The number of categories.
+//! @returns The coefficients as JSON, which has not been validated.
+inline nlohmann::json
+Make_Coefficients(const std::size_t p_number_of_categories)
+{
+    const auto category_name = [](const std::size_t p_category) {
+        return "Category_" + std::to_string(p_category);
+    };
+
+    // Terms that are keyed by the category of another instruction.
+    nlohmann::json by_category;
+    for (std::size_t i{0}; i < p_number_of_categories; ++i)
+    {
+        by_category[category_name(i)] = 0.5;
+    }
+
+    nlohmann::json coefficients;
+    for (std::size_t i{0}; i < p_number_of_categories; ++i)
+    {
+        auto& category       = coefficients[category_name(i)];
+        category["Constant"] = 1.0;
+        for (const auto& term :
+             {"Operand1", "Operand2", "Bit_Flip1", "Bit_Flip2"})
+        {
+            category["Coefficients"][term] = std::vector<double>(32, 0.25);
+        }
+        category["Coefficients"]["Previous_Instruction"]   = by_category;
+        category["Coefficients"]["Subsequent_Instruction"] = by_category;
+        for (std::size_t j{0}; j < 4; ++j)
+        {
+            category["Instructions"].push_back(
+                "opcode_" + std::to_string(i) + "_" + std::to_string(j));
+        }
+    }
+    return coefficients;
+}
+}  // namespace Benchmark
+}  // namespace GILES
+
+#endif
@@ -0,0 +1,43 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Benchmark_Validator_Coefficients.cpp
+    @brief Contains the benchmarks for the Validator_Coefficients class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <nlohmann/json.hpp>  // for json
+
+#include "Benchmark_Utility.hpp"
+#include "Validator_Coefficients.hpp"
+
+TEST_CASE("Coefficients validation",
+          "[validator_coefficients][benchmark]")
+{
+    const auto coefficients = GILES::Benchmark::Make_Coefficients(500);
+
+    BENCHMARK("Validate_Json, 500 categories")
+    {
+        GILES::Internal::Validator_Coefficients::Validate_Json(coefficients);
+        return coefficients.size();
+    };
+}
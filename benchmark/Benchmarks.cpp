@@ -0,0 +1,43 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+    @file Benchmarks.cpp
+    @brief Contains the entry point for the benchmarks
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+//! Required when using Catch testing framework - Tells Catch to provide a
+//! main()
+//! @see https://github.com/catchorg/Catch2
+#ifndef CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_MAIN
+#endif  // CATCH_CONFIG_MAIN
+
+//! Required to make the BENCHMARK macro available.
+//! @see https://github.com/catchorg/Catch2/blob/v2.x/docs/benchmarks.md
+#ifndef CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#endif  // CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch.hpp>  // for catch
+
+// The actual benchmarks
+#include "Benchmark_Execution.cpp"
+#include "Benchmark_Models.cpp"
+#include "Benchmark_Validator_Coefficients.cpp"
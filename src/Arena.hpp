@@ -0,0 +1,191 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Arena.hpp
+    @brief A per worker memory arena that is reset in bulk between traces.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <algorithm>        // for max
+#include <cstddef>          // for size_t, byte
+#include <memory_resource>  // for memory_resource, monotonic_buffer_resource
+#include <optional>         // for optional
+#include <vector>           // for vector
+
+namespace GILES
+{
+namespace Internal
+{
+//! @class Arena
+//! @brief A memory resource that hands out memory from a single buffer and
+//! frees all of it at once when Reset() is called. Each worker thread owns
+//! one Arena, which the Execution and the Model allocate from whilst one
+//! trace is generated. This avoids the global allocator, and any contention
+//! on it between threads, during every trace after the first.
+//! The buffer grows to the largest amount of memory used by any trace so far,
+//! only allocating from the global allocator when a trace uses more memory
+//! than any before it.
+//! @see https://en.cppreference.com/w/cpp/memory/monotonic_buffer_resource
+//! @see https://en.wikipedia.org/wiki/Region-based_memory_management
+class Arena final : public std::pmr::memory_resource
+{
+public:
+    //! @brief Statistics about the memory handed out by one or more Arenas.
+    struct Statistics
+    {
+        //! The number of allocations made from the Arena.
+        std::size_t Allocations{0};
+
+        //! The total number of bytes allocated from the Arena.
+        std::size_t Bytes_Allocated{0};
+
+        //! The number of times the Arena was reset.
+        std::size_t Resets{0};
+
+        //! The number of times a trace used more memory than the buffer
+        //! held, requiring memory from the global allocator.
+        std::size_t Overflows{0};
+
+        //! The size of the largest buffer, in bytes.
+        std::size_t Capacity{0};
+
+        //! @brief Combines the statistics of two Arenas.
+        //! @param p_other The statistics to add to these.
+        //! @returns These statistics.
+        Statistics& operator+=(const Statistics& p_other)
+        {
+            Allocations += p_other.Allocations;
+            Bytes_Allocated += p_other.Bytes_Allocated;
+            Resets += p_other.Resets;
+            Overflows += p_other.Overflows;
+            Capacity = std::max(Capacity, p_other.Capacity);
+            return *this;
+        }
+    };
+
+private:
+    //! The memory that allocations are made from.
+    std::vector<std::byte> m_buffer;
+
+    //! Hands out memory from m_buffer, falling back to the global allocator
+    //! once m_buffer is used up.
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+
+    //! The number of bytes allocated since the last reset, including the
+    //! padding needed to align each allocation.
+    std::size_t m_bytes_in_use;
+
+    //! The statistics of this Arena.
+    Statistics m_statistics;
+
+    //! @brief Allocates p_bytes bytes with the alignment given by
+    //! p_alignment.
+    //! @param p_bytes The number of bytes.
+    //! @param p_alignment The alignment of the memory.
+    //! @returns A pointer to the memory.
+    void* do_allocate(const std::size_t p_bytes,
+                      const std::size_t p_alignment) override
+    {
+        ++m_statistics.Allocations;
+        m_statistics.Bytes_Allocated += p_bytes;
+        m_bytes_in_use += p_bytes + p_alignment;
+        return m_resource->allocate(p_bytes, p_alignment);
+    }
+
+    //! @brief Memory is only freed when the Arena is reset so this does
+    //! nothing.
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    //! @brief Memory allocated from one Arena can only be freed by that same
+    //! Arena.
+    //! @param p_other The memory resource to compare against.
+    //! @returns True if p_other is this Arena, false if not.
+    bool do_is_equal(
+        const std::pmr::memory_resource& p_other) const noexcept override
+    {
+        return this == &p_other;
+    }
+
+    //! @brief Starts handing out memory from the start of m_buffer.
+    void restart()
+    {
+        m_resource.reset();
+        if (m_buffer.empty())
+        {
+            m_resource.emplace(std::pmr::new_delete_resource());
+        }
+        else
+        {
+            m_resource.emplace(m_buffer.data(),
+                               m_buffer.size(),
+                               std::pmr::new_delete_resource());
+        }
+        m_bytes_in_use = 0;
+    }
+
+public:
+    //! @brief Constructs an Arena.
+    //! @param p_initial_capacity The initial size of the buffer in bytes.
+    explicit Arena(const std::size_t p_initial_capacity = 0)
+        : m_buffer(p_initial_capacity), m_resource(), m_bytes_in_use(0),
+          m_statistics()
+    {
+        m_statistics.Capacity = p_initial_capacity;
+        restart();
+    }
+
+    //! @brief Copying an Arena would duplicate the memory it has handed out
+    //! so this has been deleted.
+    Arena(const Arena&) = delete;
+
+    //! @brief Copying an Arena would duplicate the memory it has handed out
+    //! so this has been deleted.
+    Arena& operator=(const Arena&) = delete;
+
+    //! @brief Frees everything allocated from the Arena at once, ready for
+    //! the next trace. If the last trace needed more memory than the buffer
+    //! held then the buffer is enlarged so the next trace does not.
+    //! @warning Nothing allocated from the Arena may be used after this.
+    void Reset()
+    {
+        ++m_statistics.Resets;
+        if (m_buffer.size() < m_bytes_in_use)
+        {
+            ++m_statistics.Overflows;
+
+            // Leave some room for traces that are slightly longer.
+            m_resource.reset();
+            m_buffer.resize(m_bytes_in_use + m_bytes_in_use / 4);
+            m_statistics.Capacity = m_buffer.size();
+        }
+        restart();
+    }
+
+    //! @brief Retrieves the statistics of this Arena.
+    //! @returns The statistics.
+    const Statistics& Get_Statistics() const noexcept { return m_statistics; }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
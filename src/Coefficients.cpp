@@ -24,6 +24,7 @@
 */
 
 #include <algorithm>  // for find
+#include <atomic>     // for atomic
 #include <stdexcept>  // for out_of_range
 
 #include "Coefficients.hpp"
@@ -74,31 +75,36 @@ const std::string& GILES::Internal::Coefficients::Get_Instruction_Category(
                             ") was not found within the Coefficients");
 }
 
-//! @brief Retrieves a list of all interaction terms contained within the
-//! coefficients. This is needed in order to ensure the Model will be
-//! provided with the terms it requires. The interaction terms of the first
-//! coefficient are used as they should be identical to all other
-//! coefficients.
-//! @returns All interaction terms contained, as an unordered set. An
-//! unordered set is used as the json standard dictates that json data is
-//! unordered therefore we should not expect any particular order.
-const std::unordered_set<std::string>
-GILES::Internal::Coefficients::Get_Interaction_Terms() const
+//! @brief Finds the interaction terms of the first category, which should be
+//! identical to those of all other categories.
+//! @param p_coefficients The coefficients, as they are stored in the file.
+//! @returns All interaction terms contained.
+std::unordered_set<std::string>
+GILES::Internal::Coefficients::find_interaction_terms(
+    const nlohmann::json& p_coefficients)
 {
     // Coefficients are optional, this handles that case.
-    if (m_coefficients.empty())
+    if (p_coefficients.empty())
     {
         return {};
     }
     std::unordered_set<std::string> interaction_terms;
     for (const auto& interaction_term :
-         m_coefficients.front()["Coefficients"].items())
+         p_coefficients.front()["Coefficients"].items())
     {
         interaction_terms.insert(interaction_term.key());
     }
     return interaction_terms;
 }
 
+//! @brief Generates the ID of a newly loaded set of Coefficients.
+//! @returns The ID, which is never 0.
+std::uint64_t GILES::Internal::Coefficients::next_id()
+{
+    static std::atomic<std::uint64_t> id{0};
+    return ++id;
+}
+
 //! @brief Retrieves the coefficients for the interaction term given by
 //! p_interaction_term under the instruction category that contains the
 //! instruction given by p_opcode.
@@ -26,6 +26,7 @@
 #ifndef COEFFICIENTS_HPP
 #define COEFFICIENTS_HPP
 
+#include <cstdint>        // for uint64_t
 #include <string>         // for string
 #include <typeinfo>       // for typeid
 #include <unordered_set>  // for unordered_set
@@ -34,7 +35,8 @@
 #include <boost/core/demangle.hpp>  // for demangle
 #include <nlohmann/json.hpp>        // for json
 
-#include "Error.hpp"  // for Report_Error
+#include "Compiled_Coefficients.hpp"  // for Compiled_Coefficients
+#include "Error.hpp"                  // for Report_Error
 
 #include <iostream>
 
@@ -48,12 +50,31 @@ namespace Internal
 //! measuring real hardware traces. Each instruction will have a set of terms
 //! with a list of corresponding values that will be used to calculate
 //! predicted traces by the Model class.
+//! The Coefficients are also compiled into a flat table when they are loaded.
+//! Models should use that, through Get_Compiled(), during every clock cycle.
+//! The functions here look up everything by name and are kept for
+//! everything else, such as reporting errors.
 //! @see https://eprint.iacr.org/2016/517
 class Coefficients
 {
 private:
     const nlohmann::json m_coefficients;
 
+    //! The Coefficients compiled into a table indexed by category and term.
+    const Compiled_Coefficients m_compiled;
+
+    //! The interaction terms of the first category, found once on load.
+    const std::unordered_set<std::string> m_interaction_terms;
+
+    //! Identifies these Coefficients, and any copies of them, so that the
+    //! terms they provide only need to be checked once for each Model.
+    const std::uint64_t m_id;
+
+    static std::unordered_set<std::string>
+    find_interaction_terms(const nlohmann::json& p_coefficients);
+
+    static std::uint64_t next_id();
+
     //! @brief Retrieves a value from the Coefficients. This is a generic
     //! function that can retrieve anything, dependent on its parameters. The
     //! parameters in p_categories are all evaluated in the order they are
@@ -199,14 +220,40 @@ public:
     //! occurred, using the Validator_Coefficients class, before calling the
     //! constructor.
     explicit Coefficients(const nlohmann::json& p_coefficients)
-        : m_coefficients(p_coefficients)
+        : m_coefficients(p_coefficients), m_compiled(m_coefficients),
+          m_interaction_terms(find_interaction_terms(m_coefficients)),
+          m_id(next_id())
     {
     }
 
+    //! @brief Retrieves an ID that is unique to these Coefficients and is
+    //! shared only by copies of them.
+    //! @returns The ID, which is never 0.
+    std::uint64_t Get_ID() const noexcept { return m_id; }
+
+    //! @brief Retrieves the Coefficients compiled into a table, which is
+    //! indexed by dense category and interaction term IDs rather than names.
+    //! @returns The compiled Coefficients.
+    const Compiled_Coefficients& Get_Compiled() const noexcept
+    {
+        return m_compiled;
+    }
+
     const std::string&
     Get_Instruction_Category(const std::string& p_opcode) const;
 
-    const std::unordered_set<std::string> Get_Interaction_Terms() const;
+    //! @brief Retrieves a list of all interaction terms contained within the
+    //! coefficients. This is needed in order to ensure the Model will be
+    //! provided with the terms it requires. The interaction terms of the
+    //! first coefficient are used as they should be identical to all other
+    //! coefficients.
+    //! @returns All interaction terms contained, as an unordered set. An
+    //! unordered set is used as the json standard dictates that json data is
+    //! unordered therefore we should not expect any particular order.
+    const std::unordered_set<std::string>& Get_Interaction_Terms() const
+    {
+        return m_interaction_terms;
+    }
 
     const std::vector<double>
     Get_Coefficients(const std::string& p_opcode,
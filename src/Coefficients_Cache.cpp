@@ -0,0 +1,286 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Coefficients_Cache.cpp
+    @brief A binary copy of a validated Coefficients file, allowing it to be
+    loaded without parsing or validating the JSON again.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include "Coefficients_Cache.hpp"
+
+#include <algorithm>  // for equal
+#include <cerrno>     // for errno, EEXIST
+#include <cstdio>     // for rename, remove
+#include <cstdlib>    // for getenv
+#include <cstring>    // for memcpy
+#include <fstream>    // for ifstream, ofstream
+#include <iterator>   // for istreambuf_iterator
+#include <vector>     // for vector
+
+#include <fmt/format.h>  // for format
+
+#include <sys/stat.h>  // for mkdir
+#include <unistd.h>    // for getpid
+
+namespace
+{
+//! @brief Finds the directory that caches are stored in unless another is
+//! given using Coefficients_Cache::Set_Directory(). This is the user's cache
+//! directory, as given by the XDG Base Directory Specification.
+//! @returns "$XDG_CACHE_HOME/giles", "$HOME/.cache/giles" if XDG_CACHE_HOME is
+//! not set, or std::nullopt if neither is set.
+//! @see https://specifications.freedesktop.org/basedir-spec/latest/
+std::optional<std::string> get_default_directory()
+{
+    if (const char* const cache_home{std::getenv("XDG_CACHE_HOME")};
+        nullptr != cache_home && '\0' != *cache_home)
+    {
+        return std::string{cache_home} + "/giles";
+    }
+    if (const char* const home{std::getenv("HOME")};
+        nullptr != home && '\0' != *home)
+    {
+        return std::string{home} + "/.cache/giles";
+    }
+    return std::nullopt;
+}
+
+//! @brief Creates the directory given by p_path, along with any of its parents
+//! that do not exist yet.
+//! @param p_path The path of the directory.
+//! @returns True if the directory exists, false if it could not be created.
+bool create_directories(const std::string& p_path)
+{
+    auto separator = p_path.find('/', 1);
+    while (true)
+    {
+        const auto directory = p_path.substr(0, separator);
+        if (0 != mkdir(directory.c_str(), 0755) && EEXIST != errno)
+        {
+            return false;
+        }
+        if (std::string::npos == separator)
+        {
+            return true;
+        }
+        separator = p_path.find('/', separator + 1);
+    }
+}
+
+//! @brief Decodes a cache file.
+//! @param p_data The contents of the cache file.
+//! @param p_size The size of the cache file in bytes.
+//! @param p_hash The hash of the Coefficients file that the cache must have
+//! been produced from.
+//! @returns The Coefficients or std::nullopt if the cache is not valid for
+//! p_hash.
+std::optional<nlohmann::json> decode(const unsigned char* const p_data,
+                                     const std::size_t p_size,
+                                     const std::uint64_t p_hash)
+{
+    using GILES::Internal::Coefficients_Cache;
+
+    const auto read_u32 = [p_data](const std::size_t p_offset) {
+        std::uint32_t value;
+        std::memcpy(&value, p_data + p_offset, sizeof(value));
+        return value;
+    };
+    const auto read_u64 = [p_data](const std::size_t p_offset) {
+        std::uint64_t value;
+        std::memcpy(&value, p_data + p_offset, sizeof(value));
+        return value;
+    };
+
+    if (!std::equal(std::begin(Coefficients_Cache::magic),
+                    std::end(Coefficients_Cache::magic),
+                    p_data) ||
+        Coefficients_Cache::version != read_u32(8) || p_hash != read_u64(16) ||
+        p_size - Coefficients_Cache::header_size != read_u64(24))
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        return nlohmann::json::from_cbor(
+            p_data + Coefficients_Cache::header_size, p_data + p_size);
+    }
+    // A truncated or otherwise damaged cache is treated as stale.
+    catch (const nlohmann::json::exception&)
+    {
+        return std::nullopt;
+    }
+}
+}  // namespace
+
+//! @brief Stores every cache in the directory given by p_directory, rather
+//! than in the user's cache directory.
+//! @param p_directory The directory, which is created if it does not exist,
+//! or std::nullopt to use the user's cache directory.
+void GILES::Internal::Coefficients_Cache::Set_Directory(
+    const std::optional<std::string>& p_directory)
+{
+    get_settings().Directory = p_directory;
+}
+
+//! @brief Sets whether caches are used. When they are not, every
+//! Coefficients file is parsed and validated on every run and nothing is
+//! written.
+//! @param p_enabled Whether caches are used.
+void GILES::Internal::Coefficients_Cache::Set_Enabled(const bool p_enabled)
+{
+    get_settings().Enabled = p_enabled;
+}
+
+//! @brief Checks whether caches are used.
+//! @returns True if caches are used, false if not.
+bool GILES::Internal::Coefficients_Cache::Is_Enabled()
+{
+    return get_settings().Enabled;
+}
+
+//! @brief Retrieves the path of the cache of a Coefficients file. This is
+//! within the directory given by Set_Directory() or, by default, the user's
+//! cache directory. The name of the Coefficients file is followed by a hash of
+//! its path so that Coefficients files with the same name in different
+//! directories are kept apart.
+//! @param p_coefficients_path The path of the Coefficients file.
+//! @returns The path of the cache, or std::nullopt if there is no directory
+//! to store it in as the user's cache directory could not be found.
+std::optional<std::string> GILES::Internal::Coefficients_Cache::Get_Path(
+    const std::string& p_coefficients_path)
+{
+    const auto directory = get_settings().Directory
+                               ? get_settings().Directory
+                               : get_default_directory();
+    if (!directory)
+    {
+        return std::nullopt;
+    }
+
+    const auto separator = p_coefficients_path.find_last_of('/');
+    return fmt::format("{}/{}.{:016x}.cache",
+                       directory.value(),
+                       p_coefficients_path.substr(
+                           std::string::npos == separator ? 0 : separator + 1),
+                       Hash(p_coefficients_path));
+}
+
+//! @brief Hashes the contents of a Coefficients file, which is used to check
+//! whether a cache was produced from it.
+//! @param p_contents The contents of the Coefficients file.
+//! @returns The 64 bit FNV-1a hash of p_contents.
+//! @see https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+std::uint64_t
+GILES::Internal::Coefficients_Cache::Hash(const std::string_view p_contents)
+{
+    std::uint64_t hash{0xcbf29ce484222325};
+    for (const auto character : p_contents)
+    {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+//! @brief Loads the Coefficients from a cache file, if it is present and was
+//! produced from a Coefficients file with the hash given by p_hash.
+//! @param p_cache_path The path of the cache file.
+//! @param p_hash The hash of the Coefficients file, as given by Hash().
+//! @returns The validated Coefficients or std::nullopt if the cache is
+//! missing, stale or damaged.
+std::optional<nlohmann::json>
+GILES::Internal::Coefficients_Cache::Load(const std::string& p_cache_path,
+                                          const std::uint64_t p_hash)
+{
+    std::ifstream file{p_cache_path, std::ios::binary};
+    if (!file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    const std::vector<unsigned char> contents{
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (contents.size() < header_size)
+    {
+        return std::nullopt;
+    }
+    return decode(contents.data(), contents.size(), p_hash);
+}
+
+//! @brief Stores the Coefficients in a cache file. The file is written under a
+//! temporary name and then renamed so that other instances of GILES, loading
+//! the same Coefficients at the same time, never read a partial cache.
+//! @param p_cache_path The path of the cache file.
+//! @param p_hash The hash of the Coefficients file, as given by Hash().
+//! @param p_coefficients The Coefficients. These must have been validated.
+//! @returns True if the cache was stored, false if it could not be written,
+//! for example because the directory is read only.
+bool GILES::Internal::Coefficients_Cache::Store(
+    const std::string& p_cache_path,
+    const std::uint64_t p_hash,
+    const nlohmann::json& p_coefficients)
+{
+    // The directory is created on the first run that stores a cache in it.
+    if (const auto separator = p_cache_path.find_last_of('/');
+        std::string::npos != separator &&
+        !create_directories(p_cache_path.substr(0, separator)))
+    {
+        return false;
+    }
+
+    const std::vector<std::uint8_t> payload{
+        nlohmann::json::to_cbor(p_coefficients)};
+
+    const std::string temporary_path{p_cache_path + ".tmp" +
+                                     std::to_string(getpid())};
+    {
+        std::ofstream file{temporary_path, std::ios::binary};
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        const std::uint32_t reserved{0};
+        const std::uint64_t payload_size{payload.size()};
+        file.write(magic.data(), magic.size());
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+        file.write(reinterpret_cast<const char*>(&p_hash), sizeof(p_hash));
+        file.write(reinterpret_cast<const char*>(&payload_size),
+                   sizeof(payload_size));
+        file.write(reinterpret_cast<const char*>(payload.data()),
+                   static_cast<std::streamsize>(payload.size()));
+        if (!file.good())
+        {
+            file.close();
+            std::remove(temporary_path.c_str());
+            return false;
+        }
+    }
+
+    if (0 != std::rename(temporary_path.c_str(), p_cache_path.c_str()))
+    {
+        std::remove(temporary_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,119 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Coefficients_Cache.hpp
+    @brief A binary copy of a validated Coefficients file, allowing it to be
+    loaded without parsing or validating the JSON again.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef COEFFICIENTS_CACHE_HPP
+#define COEFFICIENTS_CACHE_HPP
+
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <optional>     // for optional
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+#include <nlohmann/json.hpp>  // for json
+
+namespace GILES
+{
+namespace Internal
+{
+//! @class Coefficients_Cache
+//! @brief Stores a Coefficients file, once it has been validated, in a binary
+//! form. Loading this skips parsing the text of the JSON and validating it,
+//! which dominate the start up time of short runs. The Coefficients are still
+//! decoded into JSON and compiled on every run, as Coefficients keeps the
+//! JSON for its slower accessors.
+//! By default, the cache is stored in the user's cache directory, so that
+//! nothing is written next to the Coefficients file. It can be stored in
+//! another directory using Set_Directory(), or not used at all using
+//! Set_Enabled().
+//! The cache is keyed by a hash of the contents of the Coefficients file, so
+//! it is ignored as soon as the file changes. All values are stored in the
+//! native byte order of the machine that wrote them.
+//! A cache file starts with a header:
+//! - Magic: "GILESCOE" (8 bytes)
+//! - Version (uint32), Reserved (uint32)
+//! - Hash of the Coefficients file (uint64)
+//! - Size of the payload (uint64)
+//!
+//! This is followed by the payload, the Coefficients encoded as CBOR.
+//! @see https://cbor.io
+class Coefficients_Cache
+{
+public:
+    //! The first bytes of every cache file.
+    static constexpr std::array<char, 8> magic{
+        'G', 'I', 'L', 'E', 'S', 'C', 'O', 'E'};
+
+    //! The version of the file format. This must be incremented whenever the
+    //! layout changes, or the validation of the Coefficients becomes stricter,
+    //! so that existing caches are not used.
+    static constexpr std::uint32_t version{1};
+
+    //! The size of the header in bytes.
+    static constexpr std::size_t header_size{32};
+
+    static void Set_Directory(const std::optional<std::string>& p_directory);
+
+    static void Set_Enabled(bool p_enabled);
+
+    static bool Is_Enabled();
+
+    static std::optional<std::string>
+    Get_Path(const std::string& p_coefficients_path);
+
+    static std::uint64_t Hash(std::string_view p_contents);
+
+    static std::optional<nlohmann::json> Load(const std::string& p_cache_path,
+                                              std::uint64_t p_hash);
+
+    static bool Store(const std::string& p_cache_path,
+                      std::uint64_t p_hash,
+                      const nlohmann::json& p_coefficients);
+
+private:
+    //! @brief Where and whether caches are stored.
+    struct Settings
+    {
+        bool Enabled{true};
+
+        //! The directory that caches are stored in. std::nullopt stores
+        //! them in the user's cache directory.
+        std::optional<std::string> Directory{};
+    };
+
+    //! @brief Retrieves the settings shared by every cache.
+    //! @returns The settings.
+    static Settings& get_settings()
+    {
+        static Settings settings;
+        return settings;
+    }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
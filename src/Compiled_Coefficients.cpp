@@ -0,0 +1,482 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Compiled_Coefficients.cpp
+    @brief The Coefficients compiled into a flat table of values, indexed by
+    category and interaction term, for use during trace generation.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include "Compiled_Coefficients.hpp"
+
+#include <algorithm>  // for all_of, max, min
+#include <array>      // for array
+#include <cmath>      // for abs, frexp, ilogb, isfinite, ldexp
+#include <limits>     // for numeric_limits
+
+#include "Error.hpp"  // for Report_Error
+
+namespace
+{
+//! The number of values that fit within alignment.
+constexpr std::size_t values_per_line{
+    GILES::Internal::Compiled_Coefficients::alignment / sizeof(double)};
+
+//! The number of pairs of bits that are weighed, which is the most values
+//! that a term has any use for when weighting pairs of bits.
+constexpr std::size_t pairs_of_bits{
+    GILES::Internal::Compiled_Coefficients::weighed_bits *
+    (GILES::Internal::Compiled_Coefficients::weighed_bits - 1) / 2};
+
+//! @brief Rounds p_size up to a whole number of cache lines, so that whatever
+//! follows it is aligned. At least one cache line is always used.
+//! @param p_size The number of values.
+//! @returns The number of values, including padding.
+std::size_t round_up_to_line(const std::size_t p_size)
+{
+    return std::max<std::size_t>(1, (p_size + values_per_line - 1) /
+                                         values_per_line) *
+           values_per_line;
+}
+
+//! @brief Converts a value from the Coefficients into a double.
+//! @param p_value The value.
+//! @returns The value or NaN if it is not a number.
+double to_double(const nlohmann::json& p_value)
+{
+    return p_value.is_number() ? p_value.get<double>()
+                               : std::numeric_limits<double>::quiet_NaN();
+}
+
+//! @brief Builds the tables of pairs of bits of a single term, as used by
+//! Compiled_Coefficients::Weigh_Bit_Pairs(). Each entry adds up the values of
+//! the pairs of bits that it covers, once they are converted to value_t.
+//! @param p_values The values of the term, in the order used by ELMO.
+//! @param p_size The number of values, which must be no more than the
+//! number of pairs of bits.
+//! @param p_tables Where to build the tables. This must have room for
+//! pair_table_size values.
+//! @param p_convert Converts a value into value_t.
+template <typename value_t, typename convert_t>
+void slice_pairs(const double* const p_values,
+                 const std::size_t p_size,
+                 value_t* p_tables,
+                 const convert_t& p_convert)
+{
+    using Compiled = GILES::Internal::Compiled_Coefficients;
+    constexpr std::size_t bits{Compiled::weighed_bits};
+    constexpr std::size_t entries{Compiled::byte_values};
+
+    // Value (i, j) goes in row i and column j.
+    std::array<value_t, bits * bits> pairs{};
+    std::size_t value{0};
+    for (std::size_t bit_1{0}; bit_1 < bits; ++bit_1)
+    {
+        for (std::size_t bit_2{bit_1 + 1}; bit_2 < bits && value < p_size;
+             ++bit_2)
+        {
+            pairs[bit_1 * bits + bit_2] = p_convert(p_values[value++]);
+        }
+    }
+
+    for (std::size_t byte{0}; byte < bits / 8; ++byte, p_tables += entries)
+    {
+        for (std::size_t entry{0}; entry < entries; ++entry)
+        {
+            value_t total{0};
+            for (std::size_t bit_1{0}; bit_1 < 8; ++bit_1)
+            {
+                for (std::size_t bit_2{bit_1 + 1}; bit_2 < 8; ++bit_2)
+                {
+                    if (entry >> bit_1 & entry >> bit_2 & 1)
+                    {
+                        total +=
+                            pairs[(byte * 8 + bit_1) * bits + byte * 8 + bit_2];
+                    }
+                }
+            }
+            p_tables[entry] = total;
+        }
+    }
+
+    // In the same order as Weigh_Bit_Pairs() looks them up.
+    for (std::size_t low{0}; low < bits / 4; ++low)
+    {
+        for (std::size_t high{low / 2 * 2 + 2}; high < bits / 4;
+             ++high, p_tables += entries)
+        {
+            for (std::size_t entry{0}; entry < entries; ++entry)
+            {
+                value_t total{0};
+                for (std::size_t bit_1{0}; bit_1 < 4; ++bit_1)
+                {
+                    for (std::size_t bit_2{0}; bit_2 < 4; ++bit_2)
+                    {
+                        if (entry >> bit_1 & entry >> (4 + bit_2) & 1)
+                        {
+                            total += pairs[(low * 4 + bit_1) * bits +
+                                           high * 4 + bit_2];
+                        }
+                    }
+                }
+                p_tables[entry] = total;
+            }
+        }
+    }
+}
+}  // namespace
+
+//! @brief Compiles the Coefficients, as loaded from the Coefficients file.
+//! @param p_coefficients The validated coefficients, contained within a json
+//! object, as they are stored in the file.
+GILES::Internal::Compiled_Coefficients::Compiled_Coefficients(
+    const nlohmann::json& p_coefficients)
+{
+    if (!p_coefficients.is_object())
+    {
+        // Only the unprofiled category, which has no terms.
+        m_constants.push_back(0);
+        return;
+    }
+    if (p_coefficients.size() >= no_category)
+    {
+        Error::Report_Error("The Coefficients contain too many categories");
+    }
+
+    // Give each category an ID and resolve every opcode to the first category
+    // that contains it, in the same order as Get_Instruction_Category.
+    for (const auto& category : p_coefficients.items())
+    {
+        const auto id = static_cast<Category_ID>(m_category_names.size());
+        m_category_names.push_back(category.key());
+        m_category_ids.try_emplace(category.key(), id);
+
+        if (const auto instructions = category.value().find("Instructions");
+            category.value().end() != instructions)
+        {
+            for (const auto& instruction : *instructions)
+            {
+                if (instruction.is_string())
+                {
+                    m_category_ids.try_emplace(
+                        instruction.get<std::string>(), id);
+                }
+            }
+        }
+    }
+
+    // Give each interaction term an ID and find how many values it needs.
+    for (const auto& category : p_coefficients)
+    {
+        const auto terms = category.find("Coefficients");
+        if (category.end() == terms || !terms->is_object())
+        {
+            continue;
+        }
+        for (const auto& term : terms->items())
+        {
+            const auto [id, added] = m_term_ids.try_emplace(
+                term.key(), static_cast<Term_ID>(m_term_names.size()));
+            if (added)
+            {
+                if (no_term == id->second)
+                {
+                    Error::Report_Error(
+                        "The Coefficients contain too many interaction terms");
+                }
+                m_term_names.push_back(term.key());
+                m_term_keys.emplace_back();
+                m_term_sizes.push_back(0);
+                m_bit_table_indexes.push_back(no_slot);
+            }
+
+            auto& size = m_term_sizes[id->second];
+            if (term.value().is_array())
+            {
+                if (no_slot == m_bit_table_indexes[id->second])
+                {
+                    m_bit_table_indexes[id->second] =
+                        m_bit_tables_per_category++;
+                }
+                size = std::max(size, term.value().size());
+                continue;
+            }
+
+            // Keys that are category names use the ID of that category as
+            // their slot. Any others are given a slot after them.
+            size = std::max(size, m_category_names.size());
+            auto& keys = m_term_keys[id->second];
+            for (const auto& key : term.value().items())
+            {
+                if (no_slot == Find_Slot(id->second, key.key()))
+                {
+                    keys.try_emplace(key.key(),
+                                     m_category_names.size() + keys.size());
+                }
+            }
+            size = std::max(size, m_category_names.size() + keys.size());
+        }
+    }
+
+    // Lay out each row with every term starting on a new cache line.
+    for (const auto size : m_term_sizes)
+    {
+        m_term_offsets.push_back(m_row_size);
+        m_row_size += round_up_to_line(size);
+    }
+    m_values.assign(m_category_names.size() * m_row_size,
+                    std::numeric_limits<double>::quiet_NaN());
+    m_constants.assign(m_category_names.size(),
+                       std::numeric_limits<double>::quiet_NaN());
+
+    // The unprofiled category follows the last category.
+    m_values.resize(m_values.size() + m_row_size, 0.0);
+    m_constants.push_back(0);
+
+    // Copy the values into the table.
+    Category_ID category_id{0};
+    for (const auto& category : p_coefficients)
+    {
+        if (const auto constant = category.find("Constant");
+            category.end() != constant)
+        {
+            m_constants[category_id] = to_double(*constant);
+        }
+
+        const auto terms = category.find("Coefficients");
+        if (category.end() != terms && terms->is_object())
+        {
+            for (const auto& term : terms->items())
+            {
+                const auto term_id = m_term_ids.at(term.key());
+                auto* const values =
+                    m_values.data() + category_id * m_row_size +
+                    m_term_offsets[term_id];
+
+                if (term.value().is_array())
+                {
+                    // Shorter lists are padded with zeros.
+                    std::fill(values, values + m_term_sizes[term_id], 0.0);
+                    std::size_t i{0};
+                    for (const auto& value : term.value())
+                    {
+                        values[i++] = to_double(value);
+                    }
+                    continue;
+                }
+                for (const auto& value : term.value().items())
+                {
+                    values[Find_Slot(term_id, value.key())] =
+                        to_double(value.value());
+                }
+            }
+        }
+        ++category_id;
+    }
+
+    build_bit_tables();
+    build_pair_tables();
+    build_reduced_precision_tables();
+}
+
+//! @brief Builds the byte sliced tables of partial sums used by Weigh_Bits()
+//! from the values of every term that is a list.
+void GILES::Internal::Compiled_Coefficients::build_bit_tables()
+{
+    // The tables of the unprofiled category are left as zero.
+    m_bit_tables.assign((m_category_names.size() + 1) *
+                            m_bit_tables_per_category * bit_table_size,
+                        0.0);
+
+    for (Category_ID category{0}; category < m_category_names.size();
+         ++category)
+    {
+        for (Term_ID term{0}; term < m_term_names.size(); ++term)
+        {
+            if (no_slot == m_bit_table_indexes[term])
+            {
+                continue;
+            }
+
+            const double* const values = Get_Values(category, term);
+            const std::size_t size{std::min(weighed_bits, m_term_sizes[term])};
+            double* const tables =
+                m_bit_tables.data() +
+                (category * m_bit_tables_per_category +
+                 m_bit_table_indexes[term]) *
+                    bit_table_size;
+
+            for (std::size_t byte{0}; byte < weighed_bits / 8; ++byte)
+            {
+                for (std::size_t value{0}; value < byte_values; ++value)
+                {
+                    // Added up in the same order as weighting each bit in
+                    // turn, so a missing value is still NaN.
+                    double total{0};
+                    for (std::size_t bit{0}; bit < 8 && byte * 8 + bit < size;
+                         ++bit)
+                    {
+                        total += static_cast<double>(value >> bit & 1) *
+                                 values[byte * 8 + bit];
+                    }
+                    tables[byte * byte_values + value] = total;
+                }
+            }
+        }
+    }
+}
+
+//! @brief Builds the tables of pairs of bits used by Weigh_Bit_Pairs() from
+//! the values of every term that is a list and isn't all zero.
+void GILES::Internal::Compiled_Coefficients::build_pair_tables()
+{
+    // The terms of the unprofiled category are all zero.
+    m_pair_table_indexes.assign(
+        (m_category_names.size() + 1) * m_bit_tables_per_category, no_slot);
+    m_pair_tables.clear();
+
+    for (Category_ID category{0}; category < m_category_names.size();
+         ++category)
+    {
+        for (Term_ID term{0}; term < m_term_names.size(); ++term)
+        {
+            if (no_slot == m_bit_table_indexes[term])
+            {
+                continue;
+            }
+
+            // A missing value is NaN, which isn't zero.
+            const double* const values = Get_Values(category, term);
+            const std::size_t size{std::min(pairs_of_bits, m_term_sizes[term])};
+            if (std::all_of(values, values + size, [](const double p_value) {
+                    return 0 == p_value;
+                }))
+            {
+                continue;
+            }
+
+            const std::size_t index{m_pair_tables.size() / pair_table_size};
+            m_pair_table_indexes[category * m_bit_tables_per_category +
+                                 m_bit_table_indexes[term]] = index;
+            m_pair_tables.resize(m_pair_tables.size() + pair_table_size);
+            slice_pairs(values,
+                        size,
+                        m_pair_tables.data() + index * pair_table_size,
+                        [](const double p_value) { return p_value; });
+        }
+    }
+}
+
+//! @brief Builds the single precision and fixed point copies of the tables
+//! built by build_bit_tables() and build_pair_tables(). The fixed point
+//! partial sums are added up from the rounded values, rather than rounding
+//! each partial sum, so that every total is exactly the total of the rounded
+//! values no matter how it is added up.
+void GILES::Internal::Compiled_Coefficients::build_reduced_precision_tables()
+{
+    m_float_bit_tables.assign(m_bit_tables.begin(), m_bit_tables.end());
+    m_float_pair_tables.assign(m_pair_tables.begin(), m_pair_tables.end());
+
+    // Scale the largest value to just below fixed_point_limit.
+    double largest{0};
+    for (const auto value : m_values)
+    {
+        if (std::isfinite(value))
+        {
+            largest = std::max(largest, std::abs(value));
+        }
+    }
+    if (0 != largest)
+    {
+        int exponent{0};
+        std::frexp(largest, &exponent);
+        m_fixed_point_bits  = std::ilogb(fixed_point_limit) - exponent;
+        m_fixed_point_scale = std::ldexp(1.0, m_fixed_point_bits);
+    }
+
+    const auto to_fixed_point = [this](const double p_value) {
+        return static_cast<Fixed_Point>(To_Fixed_Point(p_value));
+    };
+    m_fixed_point_pair_tables.resize(m_pair_tables.size());
+    for (Category_ID category{0}; category < m_category_names.size();
+         ++category)
+    {
+        for (Term_ID term{0}; term < m_term_names.size(); ++term)
+        {
+            if (no_slot == m_bit_table_indexes[term])
+            {
+                continue;
+            }
+
+            const std::size_t index{
+                m_pair_table_indexes[category * m_bit_tables_per_category +
+                                     m_bit_table_indexes[term]]};
+            if (no_slot != index)
+            {
+                slice_pairs(Get_Values(category, term),
+                            std::min(pairs_of_bits, m_term_sizes[term]),
+                            m_fixed_point_pair_tables.data() +
+                                index * pair_table_size,
+                            to_fixed_point);
+            }
+        }
+    }
+
+    // The entry of a single set bit is the value of that bit. Every other
+    // entry adds the value of its lowest set bit to the entry without it.
+    m_fixed_point_bit_tables.resize(m_bit_tables.size());
+    for (std::size_t table{0}; table < m_bit_tables.size();
+         table += byte_values)
+    {
+        const double* const partial_sums = m_bit_tables.data() + table;
+        Fixed_Point* const fixed_point =
+            m_fixed_point_bit_tables.data() + table;
+
+        fixed_point[0] = 0;
+        for (std::size_t value{1}; value < byte_values; ++value)
+        {
+            const std::size_t lowest_bit{value & (~value + 1)};
+            fixed_point[value] = fixed_point[value ^ lowest_bit] +
+                                 to_fixed_point(partial_sums[lowest_bit]);
+        }
+    }
+}
+
+//! @brief Retrieves the slot of a key within an interaction term that is
+//! keyed by name, such as "Previous_Instruction".
+//! @param p_term The ID of the interaction term.
+//! @param p_key The key, which is usually the name of a category.
+//! @returns The slot to be given to Get_Value() or no_slot if the key is not
+//! present within any category.
+std::size_t GILES::Internal::Compiled_Coefficients::Find_Slot(
+    const Term_ID p_term, const std::string& p_key) const
+{
+    // Category names are their own slot.
+    if (const auto category = m_category_ids.find(p_key);
+        m_category_ids.end() != category &&
+        p_key == m_category_names[category->second])
+    {
+        return category->second;
+    }
+
+    const auto& keys = m_term_keys[p_term];
+    const auto key   = keys.find(p_key);
+    return keys.end() == key ? no_slot : key->second;
+}
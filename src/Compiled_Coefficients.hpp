@@ -0,0 +1,519 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Compiled_Coefficients.hpp
+    @brief The Coefficients compiled into a flat table of values, indexed by
+    category and interaction term, for use during trace generation.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef COMPILED_COEFFICIENTS_HPP
+#define COMPILED_COEFFICIENTS_HPP
+
+#include <cmath>          // for isfinite, ldexp
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int32_t, int64_t, uint16_t, uint32_t
+#include <limits>         // for numeric_limits
+#include <new>            // for align_val_t
+#include <string>         // for string
+#include <type_traits>    // for is_same_v
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include <nlohmann/json.hpp>  // for json
+
+namespace GILES
+{
+namespace Internal
+{
+//! @class Compiled_Coefficients
+//! @brief The Coefficients, compiled once when they are loaded into a form
+//! that can be read during every clock cycle without looking anything up by
+//! name.
+//! Every category is given a dense ID and every opcode is resolved to the ID
+//! of its category in advance. Every interaction term is given a dense ID and
+//! a fixed position within each category's row of the table, so the values
+//! of a term are found at a constant offset from the start of the row.
+//! Terms that are lists, such as "Operand1", occupy as many values as the
+//! longest list and are padded with zeros. Terms that are keyed by name,
+//! such as "Previous_Instruction", occupy one value per category, in the
+//! order of the category IDs, followed by any keys that are not category
+//! names. Values that are not present in the Coefficients are stored as NaN
+//! so that the caller can fall back to the Coefficients to report the error.
+//! After the last category there is one more row, given by Get_Unprofiled(),
+//! where every value and the constant is zero. Instructions that were not
+//! profiled can be given this category so that they contribute nothing,
+//! without being treated differently to profiled instructions.
+//! Terms that are lists are also compiled into byte sliced tables of partial
+//! sums, so weighting the bits of a 32 bit value by the first 32 values of a
+//! term costs four lookups rather than one multiplication per bit. Terms such
+//! as "Operand1_Bit_Interactions", that have one value for each pair of bits,
+//! are sliced the same way into a table of the pairs within each byte and a
+//! table of the pairs between each two nibbles of different bytes, so
+//! weighting every pair of set bits costs 28 lookups. These are only built
+//! for the terms of each category that aren't all zero.
+//! Both kinds of table are also kept in single precision and in fixed point,
+//! for models that trade accuracy for speed. The fixed point values are
+//! integers counting multiples of 2^-Get_Fixed_Point_Bits(), which is chosen
+//! for each set of Coefficients so that the largest value is scaled to no
+//! more than fixed_point_limit. Each value is rounded to the nearest
+//! multiple, so it is out by at most 2^-(Get_Fixed_Point_Bits() + 1), and the
+//! tables are added up exactly from the rounded values.
+//! @see Coefficients
+class Compiled_Coefficients
+{
+public:
+    //! The dense ID of a category of instructions.
+    using Category_ID = std::uint16_t;
+
+    //! The dense ID of an interaction term.
+    using Term_ID = std::uint16_t;
+
+    //! A value of the fixed point tables.
+    using Fixed_Point = std::int32_t;
+
+    //! The ID returned for an opcode that is not within any category.
+    static constexpr Category_ID no_category{
+        std::numeric_limits<Category_ID>::max()};
+
+    //! The ID returned for an interaction term that is not present.
+    static constexpr Term_ID no_term{std::numeric_limits<Term_ID>::max()};
+
+    //! The slot returned for a key that is not present within a term.
+    static constexpr std::size_t no_slot{
+        std::numeric_limits<std::size_t>::max()};
+
+    //! The alignment of each row, and each term within it, in bytes. This is
+    //! the size of a cache line, so the values of a term never straddle more
+    //! cache lines than necessary.
+    static constexpr std::size_t alignment{64};
+
+    //! The number of bits, starting from the least significant, weighted by
+    //! Weigh_Bits().
+    static constexpr std::size_t weighed_bits{32};
+
+    //! The number of entries in each byte sliced table of partial sums.
+    static constexpr std::size_t byte_values{256};
+
+    //! The number of values in the tables of a single term within a single
+    //! category. There is one table per byte of a weighed value.
+    static constexpr std::size_t bit_table_size{weighed_bits / 8 *
+                                                byte_values};
+
+    //! The number of values in the tables of pairs of bits of a single term
+    //! within a single category. There is one table per byte, indexed by
+    //! that byte, and one per two nibbles of different bytes, indexed by the
+    //! lower nibble in its low four bits and the higher one above them.
+    static constexpr std::size_t pair_table_size{
+        (weighed_bits / 8 + weighed_bits / 4 * (weighed_bits / 4 - 2) / 2) *
+        byte_values};
+
+    //! The largest magnitude of a value once it is scaled into fixed point.
+    //! There are 496 pairs of bits so the total of every one of them, or of
+    //! a whole table of partial sums, still fits within a Fixed_Point.
+    static constexpr double fixed_point_limit{1 << 22};
+
+    //! @brief An allocator that aligns every allocation to alignment.
+    //! @see https://en.cppreference.com/w/cpp/named_req/Allocator
+    template <typename T> struct Aligned_Allocator
+    {
+        using value_type = T;
+
+        Aligned_Allocator() = default;
+
+        template <typename U>
+        Aligned_Allocator(const Aligned_Allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(const std::size_t p_size)
+        {
+            return static_cast<T*>(::operator new(
+                p_size * sizeof(T), std::align_val_t{alignment}));
+        }
+
+        void deallocate(T* const p_pointer, std::size_t) noexcept
+        {
+            ::operator delete(p_pointer, std::align_val_t{alignment});
+        }
+
+        bool operator==(const Aligned_Allocator&) const noexcept
+        {
+            return true;
+        }
+
+        bool operator!=(const Aligned_Allocator&) const noexcept
+        {
+            return false;
+        }
+    };
+
+private:
+    //! The name of each category, indexed by Category_ID.
+    std::vector<std::string> m_category_names{};
+
+    //! The category of every opcode and every category name. When an opcode
+    //! is found within more than one category, the first one is used, the
+    //! same as Coefficients::Get_Instruction_Category.
+    std::unordered_map<std::string, Category_ID> m_category_ids{};
+
+    //! The name of each interaction term, indexed by Term_ID.
+    std::vector<std::string> m_term_names{};
+
+    //! The ID of each interaction term, indexed by name.
+    std::unordered_map<std::string, Term_ID> m_term_ids{};
+
+    //! The keys of each term that are not category names, along with their
+    //! slot, indexed by Term_ID.
+    std::vector<std::unordered_map<std::string, std::size_t>> m_term_keys{};
+
+    //! The offset of each term from the start of a row, indexed by Term_ID.
+    std::vector<std::size_t> m_term_offsets{};
+
+    //! The number of values of each term, indexed by Term_ID.
+    std::vector<std::size_t> m_term_sizes{};
+
+    //! The number of values in each row, including padding.
+    std::size_t m_row_size{0};
+
+    //! One row of values per category, one after another.
+    std::vector<double, Aligned_Allocator<double>> m_values{};
+
+    //! The constant of each category, indexed by Category_ID.
+    std::vector<double> m_constants{};
+
+    //! The position of the byte sliced tables of each term that is a list,
+    //! amongst the tables of its category, indexed by Term_ID. Terms that are
+    //! not lists have no tables and are given no_slot.
+    std::vector<std::size_t> m_bit_table_indexes{};
+
+    //! The number of terms that are lists.
+    std::size_t m_bit_tables_per_category{0};
+
+    //! The byte sliced tables of each category, one after another. Each
+    //! table is indexed by one byte of a value and contains the sum of the
+    //! values of the term that are weighted by the set bits of that byte.
+    std::vector<double, Aligned_Allocator<double>> m_bit_tables{};
+
+    //! The position of the tables of pairs of bits of each term within each
+    //! category, in the same order as m_bit_tables, counted in tables of
+    //! pair_table_size values. Terms that are all zero have no tables and are
+    //! given no_slot.
+    std::vector<std::size_t> m_pair_table_indexes{};
+
+    //! The tables of pairs of bits of every term that isn't all zero, one
+    //! after another.
+    std::vector<double, Aligned_Allocator<double>> m_pair_tables{};
+
+    //! m_bit_tables and m_pair_tables rounded to single precision.
+    std::vector<float, Aligned_Allocator<float>> m_float_bit_tables{};
+    std::vector<float, Aligned_Allocator<float>> m_float_pair_tables{};
+
+    //! m_bit_tables and m_pair_tables in fixed point. Missing values are
+    //! zero.
+    std::vector<Fixed_Point, Aligned_Allocator<Fixed_Point>>
+        m_fixed_point_bit_tables{};
+    std::vector<Fixed_Point, Aligned_Allocator<Fixed_Point>>
+        m_fixed_point_pair_tables{};
+
+    //! The number of fractional bits of the fixed point values.
+    int m_fixed_point_bits{0};
+
+    //! 2^m_fixed_point_bits, which scales a value into fixed point exactly.
+    double m_fixed_point_scale{1};
+
+    void build_bit_tables();
+
+    void build_pair_tables();
+
+    void build_reduced_precision_tables();
+
+    //! @brief Retrieves the byte sliced tables of the given precision.
+    //! @tparam value_t double, float or Fixed_Point.
+    //! @returns A pointer to the first table.
+    template <typename value_t> const value_t* get_bit_tables() const noexcept
+    {
+        if constexpr (std::is_same_v<value_t, float>)
+        {
+            return m_float_bit_tables.data();
+        }
+        else if constexpr (std::is_same_v<value_t, Fixed_Point>)
+        {
+            return m_fixed_point_bit_tables.data();
+        }
+        else
+        {
+            static_assert(std::is_same_v<value_t, double>);
+            return m_bit_tables.data();
+        }
+    }
+
+    //! @brief Retrieves the tables of pairs of bits of the given precision.
+    //! @tparam value_t double, float or Fixed_Point.
+    //! @returns A pointer to the first table.
+    template <typename value_t> const value_t* get_pair_tables() const noexcept
+    {
+        if constexpr (std::is_same_v<value_t, float>)
+        {
+            return m_float_pair_tables.data();
+        }
+        else if constexpr (std::is_same_v<value_t, Fixed_Point>)
+        {
+            return m_fixed_point_pair_tables.data();
+        }
+        else
+        {
+            static_assert(std::is_same_v<value_t, double>);
+            return m_pair_tables.data();
+        }
+    }
+
+public:
+    //! @brief Constructs an empty table, as used when there are no
+    //! Coefficients. This only contains the unprofiled category.
+    Compiled_Coefficients() : Compiled_Coefficients(nlohmann::json{}) {}
+
+    explicit Compiled_Coefficients(const nlohmann::json& p_coefficients);
+
+    //! @brief Retrieves the category that the given instruction is contained
+    //! within.
+    //! @param p_opcode The opcode of the instruction or the name of a
+    //! category.
+    //! @returns The ID of the category or no_category if it is not within
+    //! any category.
+    Category_ID Find_Category(const std::string& p_opcode) const
+    {
+        const auto category = m_category_ids.find(p_opcode);
+        return m_category_ids.end() == category ? no_category
+                                                : category->second;
+    }
+
+    //! @brief Retrieves the name of a category.
+    //! @param p_category The ID of the category.
+    //! @returns The name of the category.
+    const std::string& Get_Category_Name(const Category_ID p_category) const
+    {
+        return m_category_names[p_category];
+    }
+
+    //! @brief Retrieves the category given to instructions that were not
+    //! profiled. Every value within it, as well as its constant, is zero.
+    //! @returns The ID of the unprofiled category. This is equal to
+    //! Get_Category_Count().
+    Category_ID Get_Unprofiled() const noexcept
+    {
+        return static_cast<Category_ID>(m_category_names.size());
+    }
+
+    //! @brief Retrieves the number of categories.
+    //! @returns The number of categories, not including the unprofiled
+    //! category. Every other Category_ID is less than this.
+    std::size_t Get_Category_Count() const noexcept
+    {
+        return m_category_names.size();
+    }
+
+    //! @brief Retrieves the ID of an interaction term.
+    //! @param p_term_name The name of the interaction term.
+    //! @returns The ID of the term or no_term if it is not present.
+    Term_ID Find_Term(const std::string& p_term_name) const
+    {
+        const auto term = m_term_ids.find(p_term_name);
+        return m_term_ids.end() == term ? no_term : term->second;
+    }
+
+    //! @brief Retrieves the name of an interaction term.
+    //! @param p_term The ID of the interaction term.
+    //! @returns The name of the interaction term.
+    const std::string& Get_Term_Name(const Term_ID p_term) const
+    {
+        return m_term_names[p_term];
+    }
+
+    //! @brief Retrieves the number of values stored for an interaction term.
+    //! @param p_term The ID of the interaction term.
+    //! @returns The number of values.
+    std::size_t Get_Term_Size(const Term_ID p_term) const noexcept
+    {
+        return m_term_sizes[p_term];
+    }
+
+    //! @brief Checks whether an interaction term is a list of values, whose
+    //! bits can be weighed by Weigh_Bits() and Weigh_Bit_Pairs(), rather
+    //! than values keyed by name.
+    //! @param p_term The ID of the interaction term.
+    //! @returns True if the term is a list, false if not.
+    bool Is_List(const Term_ID p_term) const noexcept
+    {
+        return no_slot != m_bit_table_indexes[p_term];
+    }
+
+    std::size_t Find_Slot(const Term_ID p_term, const std::string& p_key) const;
+
+    //! @brief Retrieves the values of an interaction term within a category.
+    //! There are Get_Term_Size(p_term) values.
+    //! @param p_category The ID of the category.
+    //! @param p_term The ID of the interaction term.
+    //! @returns A pointer to the first value, aligned to alignment.
+    const double* Get_Values(const Category_ID p_category,
+                             const Term_ID p_term) const noexcept
+    {
+        return m_values.data() + p_category * m_row_size +
+               m_term_offsets[p_term];
+    }
+
+    //! @brief Retrieves a single value of an interaction term within a
+    //! category.
+    //! @param p_category The ID of the category.
+    //! @param p_term The ID of the interaction term.
+    //! @param p_slot The index of the value, as given by Find_Slot() for
+    //! terms that are keyed by name.
+    //! @returns The value or NaN if it is not present.
+    double Get_Value(const Category_ID p_category,
+                     const Term_ID p_term,
+                     const std::size_t p_slot) const noexcept
+    {
+        return Get_Values(p_category, p_term)[p_slot];
+    }
+
+    //! @brief Weights each bit of p_bits by the corresponding value of an
+    //! interaction term and returns the total. This is the same as adding
+    //! p_bits[i] * Get_Values(p_category, p_term)[i] for every i less than
+    //! weighed_bits, but the total is added up one byte at a time so it may
+    //! be rounded differently.
+    //! @tparam value_t The precision of the tables used, double, float or
+    //! Fixed_Point.
+    //! @param p_category The ID of the category.
+    //! @param p_term The ID of the interaction term, which must be a list.
+    //! @param p_bits The bits to be weighted.
+    //! @returns The total of the weighted bits.
+    template <typename value_t = double>
+    value_t Weigh_Bits(const Category_ID p_category,
+                       const Term_ID p_term,
+                       const std::uint32_t p_bits) const noexcept
+    {
+        const value_t* const tables =
+            get_bit_tables<value_t>() +
+            (p_category * m_bit_tables_per_category +
+             m_bit_table_indexes[p_term]) *
+                bit_table_size;
+
+        return tables[p_bits & 0xFF] +
+               tables[byte_values + (p_bits >> 8 & 0xFF)] +
+               tables[2 * byte_values + (p_bits >> 16 & 0xFF)] +
+               tables[3 * byte_values + (p_bits >> 24)];
+    }
+
+    //! @brief Weights each pair of bits of p_bits that are both set by the
+    //! corresponding value of an interaction term and returns the total. The
+    //! values are given in the order used by ELMO, (0, 1), (0, 2) ... (0, 31),
+    //! (1, 2) ... (30, 31), and any pair beyond the end of the term weighs
+    //! zero. This is the same as adding the value of every pair of set bits,
+    //! but the total is added up from 28 partial sums so it may be rounded
+    //! differently.
+    //! @tparam value_t The precision of the tables used, double, float or
+    //! Fixed_Point.
+    //! @param p_category The ID of the category.
+    //! @param p_term The ID of the interaction term, which must be a list.
+    //! @param p_bits The bits to be weighted.
+    //! @returns The total of the weighted pairs of bits.
+    template <typename value_t = double>
+    value_t Weigh_Bit_Pairs(const Category_ID p_category,
+                            const Term_ID p_term,
+                            const std::uint32_t p_bits) const noexcept
+    {
+        const std::size_t index{
+            m_pair_table_indexes[p_category * m_bit_tables_per_category +
+                                 m_bit_table_indexes[p_term]]};
+        if (no_slot == index)
+        {
+            return 0;
+        }
+        const value_t* tables =
+            get_pair_tables<value_t>() + index * pair_table_size;
+
+        // The pairs within each byte, and then those between the nibbles of
+        // different bytes.
+        value_t total{tables[p_bits & 0xFF] +
+                      tables[byte_values + (p_bits >> 8 & 0xFF)] +
+                      tables[2 * byte_values + (p_bits >> 16 & 0xFF)] +
+                      tables[3 * byte_values + (p_bits >> 24)]};
+        tables += weighed_bits / 8 * byte_values;
+        for (std::size_t low{0}; low < weighed_bits / 4; ++low)
+        {
+            for (std::size_t high{low / 2 * 2 + 2}; high < weighed_bits / 4;
+                 ++high)
+            {
+                total += tables[(p_bits >> low * 4 & 0xF) |
+                                (p_bits >> high * 4 & 0xF) << 4];
+                tables += byte_values;
+            }
+        }
+        return total;
+    }
+
+    //! @brief Retrieves the number of fractional bits of the fixed point
+    //! values.
+    //! @returns The number of bits. This is negative if the largest value is
+    //! too large for fixed_point_limit.
+    int Get_Fixed_Point_Bits() const noexcept { return m_fixed_point_bits; }
+
+    //! @brief Converts a value into fixed point, rounding it to the nearest
+    //! multiple of 2^-Get_Fixed_Point_Bits().
+    //! @param p_value The value, which should be no larger than the largest
+    //! value of the Coefficients.
+    //! @returns The value in fixed point, or zero if it is not finite.
+    std::int64_t To_Fixed_Point(const double p_value) const noexcept
+    {
+        if (!std::isfinite(p_value))
+        {
+            return 0;
+        }
+
+        // This is called for every clock cycle so it is rounded half away
+        // from zero by hand, rather than by calling llround. Scaling by a
+        // power of two and taking the fraction are both exact.
+        const double scaled{p_value * m_fixed_point_scale};
+        auto rounded         = static_cast<std::int64_t>(scaled);
+        const double fraction{scaled - static_cast<double>(rounded)};
+        rounded += (0.5 <= fraction) - (fraction <= -0.5);
+        return rounded;
+    }
+
+    //! @brief Converts a total of fixed point values back into a double.
+    //! @param p_value The total in fixed point.
+    //! @returns The total.
+    double From_Fixed_Point(const std::int64_t p_value) const noexcept
+    {
+        return std::ldexp(static_cast<double>(p_value), -m_fixed_point_bits);
+    }
+
+    //! @brief Retrieves the constant of a category.
+    //! @param p_category The ID of the category.
+    //! @returns The constant or NaN if it is not present.
+    double Get_Constant(const Category_ID p_category) const noexcept
+    {
+        return m_constants[p_category];
+    }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
@@ -0,0 +1,86 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Data_Requirements.hpp
+    @brief The parts of an Execution that a Model makes use of.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef DATA_REQUIREMENTS_HPP
+#define DATA_REQUIREMENTS_HPP
+
+#include <optional>       // for optional, nullopt
+#include <string>         // for string
+#include <unordered_set>  // for unordered_set
+
+namespace GILES
+{
+namespace Internal
+{
+//! @brief Describes which of the data recorded by an Emulator is consumed by a
+//! Model. Each Model declares this alongside its interaction terms, allowing
+//! the Emulator to skip recording and converting anything that would never be
+//! read.
+//! A default constructed Data_Requirements requires everything.
+struct Data_Requirements
+{
+    //! The names of the pipeline stages that are required, such as "Execute".
+    //! std::nullopt requires every pipeline stage.
+    std::optional<std::unordered_set<std::string>> Pipeline_Stages{};
+
+    //! The names of the registers whose values are required.
+    //! std::nullopt requires every register.
+    std::optional<std::unordered_set<std::string>> Registers{};
+
+    //! Whether the contents of memory are required.
+    bool Memory{true};
+
+    //! @brief Checks whether the pipeline stage given by p_stage_name is
+    //! required.
+    //! @param p_stage_name The name of the pipeline stage.
+    //! @returns True if the pipeline stage is required, false if not.
+    bool Requires_Pipeline_Stage(const std::string& p_stage_name) const
+    {
+        return !Pipeline_Stages ||
+               Pipeline_Stages->end() != Pipeline_Stages->find(p_stage_name);
+    }
+
+    //! @brief Checks whether the value of the register given by
+    //! p_register_name is required.
+    //! @param p_register_name The name of the register, as it appears in
+    //! disassembled instructions.
+    //! @returns True if the register is required, false if not.
+    bool Requires_Register(const std::string& p_register_name) const
+    {
+        return !Registers ||
+               Registers->end() != Registers->find(p_register_name);
+    }
+
+    //! @brief Checks whether any registers are required at all.
+    //! @returns True if at least one register is required, false if not.
+    bool Requires_Registers() const
+    {
+        return !Registers || !Registers->empty();
+    }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
@@ -0,0 +1,101 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Decoded_Instruction.hpp
+    @brief A compact, pre decoded form of an individual assembly instruction.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef DECODED_INSTRUCTION_HPP
+#define DECODED_INSTRUCTION_HPP
+
+#include <array>    // for array
+#include <cstdint>  // for uint8_t, uint16_t, uint32_t, int32_t
+#include <limits>   // for numeric_limits
+
+namespace GILES
+{
+namespace Internal
+{
+//! The kinds of operand that an assembly instruction can contain.
+//! @see https://en.wikipedia.org/wiki/Operand#Computer_science
+//! @see https://en.wikipedia.org/wiki/Addressing_mode
+enum class Operand_Type : std::uint8_t
+{
+    //! The instruction does not have an operand at this position.
+    None,
+    //! The operand is the name of a register e.g. "r1".
+    Register,
+    //! The operand is a numeric literal e.g. "10".
+    Immediate,
+    //! The operand is part of a memory address e.g. "[r1" or "#4]".
+    Memory,
+    //! The operand could not be decoded e.g. "{r4".
+    Other
+};
+
+//! @brief A single operand of a Decoded_Instruction.
+struct Decoded_Operand
+{
+    //! The value of Register used when no register is referred to.
+    static constexpr std::uint16_t no_register{
+        std::numeric_limits<std::uint16_t>::max()};
+
+    //! The kind of operand.
+    Operand_Type Type;
+
+    //! The index of the register referred to by a Register operand or the
+    //! base register of a Memory operand, as an index into the register
+    //! names stored in the Execution.
+    std::uint16_t Register;
+
+    //! The numeric value of the operand, if it has one, as parsed by
+    //! std::stoi. This is 0 for operands that are not numeric.
+    std::int32_t Immediate;
+};
+
+//! @brief An assembly instruction decoded into plain integers so that leakage
+//! models can retrieve the opcode and operands of an instruction during every
+//! clock cycle without parsing or copying any strings. Each distinct
+//! instruction is only decoded once by the Execution.
+//! @see Assembly_Instruction
+struct Decoded_Instruction
+{
+    //! The maximum number of operands that are decoded. Any operands beyond
+    //! this are counted in Number_of_Operands but not stored.
+    static constexpr std::uint8_t max_operands{4};
+
+    //! The opcode of the instruction as a dense index into the opcodes stored
+    //! in the Execution. Every distinct opcode has its own index, starting
+    //! from 0.
+    //! @see https://en.wikipedia.org/wiki/Opcode
+    std::uint32_t Opcode;
+
+    //! The number of operands the instruction has.
+    std::uint8_t Number_of_Operands;
+
+    //! The operands of the instruction. Positions past Number_of_Operands are
+    //! of type None.
+    std::array<Decoded_Operand, max_operands> Operands;
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
@@ -27,19 +27,28 @@
 #ifndef EXECUTION_HPP
 #define EXECUTION_HPP
 
-#include <algorithm>  // for min
-#include <any>        // for any, any_cast, bad_any_cast
-#include <deque>      // for deque
-#include <map>        // for map
-#include <memory>     // for shared_ptr
-#include <stdexcept>  // for range_error
-#include <string>     // for string
-#include <vector>     // for vector
+#include <algorithm>        // for min
+#include <any>              // for any, any_cast
+#include <array>            // for array
+#include <cstdint>          // for uint32_t
+#include <limits>           // for numeric_limits
+#include <map>              // for map
+#include <memory>           // for unique_ptr, make_unique
+#include <memory_resource>  // for memory_resource, get_default_resource
+#include <optional>         // for optional
+#include <stdexcept>        // for range_error, out_of_range
+#include <string>           // for string
+#include <type_traits>      // for is_same_v
+#include <unordered_map>    // for unordered_map
+#include <utility>          // for swap
+#include <vector>           // for vector, pmr::vector
 
 #include <boost/algorithm/string.hpp>  // TODO: Convert Uility.h over to boost algorithms (or the other way around?)
 
 #include "Assembly_Instruction.hpp"
-#include "Error.hpp"    // for Report_Error
+#include "Decoded_Instruction.hpp"  // for Decoded_Instruction
+#include "Error.hpp"                // for Report_Error
+#include "Register_History.hpp"     // for Register_History
 #include "Utility.hpp"  // for string_split
 
 #include <iostream>  // for temp debugging
@@ -48,6 +57,10 @@ namespace GILES
 {
 namespace Internal
 {
+// Forward Declarations
+class Execution_Record_Reader;
+class Execution_Record_Writer;
+
 //! @class Execution
 //! @todo Change this
 //! @brief The internal representation of the Execution of a program. This
@@ -57,6 +70,10 @@ namespace Internal
 //! @see https://en.wikipedia.org/wiki/Clock_cycle
 class Execution
 {
+    // These store and restore the internal representation directly.
+    friend class Execution_Record_Reader;
+    friend class Execution_Record_Writer;
+
 public:
     //! The states that a processor pipeline stage can be in. These are needed
     //! to be stored as if the pipeline stage is not running smoothly (i.e.
@@ -71,60 +88,514 @@ public:
         Flushing
     };
 
+    //! @brief A lightweight reference to a pipeline stage. Looking up a
+    //! pipeline stage by name requires a string comparison so models should
+    //! retrieve a handle once, using Get_Stage_Handle(), and make use of that
+    //! handle during every clock cycle instead.
+    //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
+    struct Stage_Handle
+    {
+        //! The index of the pipeline stage within m_pipeline.
+        std::size_t Index;
+
+        //! @brief Checks whether this handle refers to a pipeline stage that
+        //! exists within the Execution it was retrieved from.
+        //! @returns True if the pipeline stage exists, false if not.
+        bool Is_Valid() const noexcept { return invalid_index != Index; }
+
+        //! The index used to indicate that the pipeline stage does not exist.
+        static constexpr std::size_t invalid_index{
+            std::numeric_limits<std::size_t>::max()};
+    };
+
 private:
+    //! The value stored in Instruction_IDs to indicate that the value for a
+    //! clock cycle is not an instruction.
+    static constexpr std::uint32_t no_instruction{
+        std::numeric_limits<std::uint32_t>::max()};
+
+    //! @brief A non templated base class for a single column of typed values.
+    //! This allows columns of differing types to be stored alongside each
+    //! other.
+    struct Column_Base
+    {
+        //! @brief Virtual destructor to ensure proper memory cleanup.
+        //! @see https://stackoverflow.com/a/461224
+        virtual ~Column_Base() = default;
+
+        //! @brief Creates a deep copy of this column.
+        //! @returns A pointer to the copy.
+        virtual std::unique_ptr<Column_Base> Clone() const = 0;
+
+        //! @brief Retrieves the value stored during the clock cycle given by
+        //! p_cycle, without knowledge of its type.
+        //! @param p_cycle The clock cycle to retrieve the value from.
+        //! @returns The value contained within a std::any.
+        virtual std::any Get_Any(const std::size_t p_cycle) const = 0;
+    };
+
+    //! @brief A contiguous column storing a single value of type T_Value_Type
+    //! for every clock cycle.
+    //! @tparam T_Value_Type The type of values stored.
+    template <typename T_Value_Type> struct Column final : Column_Base
+    {
+        Column(const std::size_t p_number_of_cycles,
+               std::pmr::memory_resource* const p_resource)
+            : Values(p_number_of_cycles,
+                     std::pmr::polymorphic_allocator<T_Value_Type>{p_resource})
+        {
+        }
+
+        std::unique_ptr<Column_Base> Clone() const override
+        {
+            return std::make_unique<Column>(*this);
+        }
+
+        std::any Get_Any(const std::size_t p_cycle) const override
+        {
+            return T_Value_Type(Values[p_cycle]);
+        }
+
+        //! The per clock cycle values, indexed by clock cycle.
+        std::pmr::vector<T_Value_Type> Values;
+    };
+
+    //! @brief The recorded contents of one pipeline stage during every clock
+    //! cycle, stored as columns. The State column records whether anything
+    //! was in the pipeline stage during a clock cycle and, if so, what state
+    //! it was in. Instructions (values stored as strings) are stored as
+    //! indexes into m_instructions, all other values are stored in a column
+    //! of their own type.
+    struct Pipeline_Stage
+    {
+        Pipeline_Stage(const std::string& p_name,
+                       const std::size_t p_number_of_cycles,
+                       std::pmr::memory_resource* const p_resource)
+            : Name(p_name), States(p_number_of_cycles, p_resource),
+              Instruction_IDs(p_number_of_cycles, no_instruction, p_resource),
+              Values()
+        {
+        }
+
+        Pipeline_Stage(const Pipeline_Stage& p_other)
+            : Name(p_other.Name), States(p_other.States),
+              Instruction_IDs(p_other.Instruction_IDs),
+              Values(p_other.Values ? p_other.Values->Clone() : nullptr)
+        {
+        }
+
+        Pipeline_Stage(Pipeline_Stage&&) = default;
+
+        Pipeline_Stage& operator=(Pipeline_Stage p_other)
+        {
+            std::swap(Name, p_other.Name);
+            std::swap(States, p_other.States);
+            std::swap(Instruction_IDs, p_other.Instruction_IDs);
+            std::swap(Values, p_other.Values);
+            return *this;
+        }
+
+        //! The name of the pipeline stage e.g. "Execute".
+        std::string Name;
+
+        //! The state of the pipeline stage during each clock cycle. If
+        //! nothing was stored for a clock cycle then this is empty.
+        std::pmr::vector<std::optional<State>> States;
+
+        //! The instruction present during each clock cycle as an index into
+        //! m_instructions or no_instruction if the value is not an
+        //! instruction.
+        std::pmr::vector<std::uint32_t> Instruction_IDs;
+
+        //! Any other values, stored in a column of their own type. This is
+        //! only allocated when a value that is not an instruction is added.
+        std::unique_ptr<Column_Base> Values;
+    };
+
     //! @brief A data structure for storing the per clock cycle pipeline of any
-    //! given processor. The values are indexed by clock cycle and then by
-    //! pipeline stage. For each clock cycle (stored as a vector) there will be
-    //! a map storing the value for that pipeline stage, during that cycle, as
-    //! indexed by the name of the pipeline stage.
-    //! clock cycle no<pipe stage<pipe_name, <value state, value>>>
-    //! e.g. 20<<"Decode", <Normal, <"str r1, r2">>>>
+    //! given processor. There is one Pipeline_Stage for each stage of the
+    //! pipeline and each of these contains a contiguous column of values,
+    //! indexed by clock cycle.
+    //! e.g. m_pipeline[Decode].Instruction_IDs[20] -> "str r1, r2"
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
-    //! @note Ideally this would contain unique_ptr objects instead of
-    //! shared_ptr however there were issues implementing this due to the
-    //! containers. Resizing of the vector caused the copy constructor to be
-    //! called on unique_ptr causing a compile error.
-    // TODO: const correctness
-    std::vector<std::map<const std::string, std::any>> m_pipeline;
+    std::pmr::vector<Pipeline_Stage> m_pipeline;
+
+    //! The text of every distinct instruction that occurs in the Execution.
+    //! Each instruction is only stored once and referred to by its index.
+    std::vector<std::string> m_instructions;
+
+    //! A lookup from the text of an instruction to its index within
+    //! m_instructions.
+    std::unordered_map<std::string, std::uint32_t> m_instruction_ids;
+
+    //! Every distinct instruction in m_instructions, decoded once. These are
+    //! indexed in the same way as m_instructions.
+    std::pmr::vector<Decoded_Instruction> m_decoded_instructions;
+
+    //! The text of every distinct opcode that occurs in the Execution,
+    //! indexed by Decoded_Instruction::Opcode.
+    std::vector<std::string> m_opcodes;
+
+    //! A lookup from the text of an opcode to its index within m_opcodes.
+    std::unordered_map<std::string, std::uint32_t> m_opcode_ids;
+
+    //! The number of clock cycles that occurred during the Execution.
+    std::size_t m_number_of_cycles;
+
+    //! The layout of the register file. This contains the name of every
+    //! register, indexed by register ID. Register IDs are also used by
+    //! Decoded_Operand::Register.
+    //! @see https://en.wikipedia.org/wiki/Register_file
+    std::vector<std::string> m_register_names;
 
     // TODO: const correctness
     //! The state of the processor registers during each cycle of the execution
-    //! of the target program.
+    //! of the target program. Registers are stored in the fixed layout given
+    //! by m_register_names but only the registers that changed are stored for
+    //! each clock cycle.
     //! @see https://en.wikipedia.org/wiki/Processor_register
-    std::vector<std::map<std::string, std::size_t>> m_registers;
+    Register_History m_register_history;
+
+    //! Whether or not the registers were recorded during each clock cycle.
+    std::pmr::vector<bool> m_registers_recorded;
+
+    //! @brief Retrieves the pipeline stage given by p_pipeline_stage_name,
+    //! creating it if it does not yet exist.
+    //! @param p_pipeline_stage_name The name of the pipeline stage.
+    //! @returns The pipeline stage.
+    Pipeline_Stage& get_or_add_stage(const std::string& p_pipeline_stage_name)
+    {
+        if (const auto handle = Get_Stage_Handle(p_pipeline_stage_name);
+            handle.Is_Valid())
+        {
+            return m_pipeline[handle.Index];
+        }
+        return m_pipeline.emplace_back(
+            p_pipeline_stage_name, m_number_of_cycles, Get_Memory_Resource());
+    }
+
+    //! @brief Retrieves the pipeline stage referred to by p_handle.
+    //! @throws std::out_of_range This is thrown if the pipeline stage does not
+    //! exist.
+    //! @param p_handle The handle of the pipeline stage.
+    //! @returns The pipeline stage.
+    const Pipeline_Stage& get_stage(const Stage_Handle p_handle) const
+    {
+        return m_pipeline.at(p_handle.Index);
+    }
+
+    //! @brief Retrieves the index of the instruction given by p_instruction
+    //! within m_instructions, adding it if it has not been seen before.
+    //! @param p_instruction The instruction as a string.
+    //! @returns The index of the instruction.
+    std::uint32_t intern_instruction(const std::string& p_instruction)
+    {
+        const auto [position, inserted] = m_instruction_ids.try_emplace(
+            p_instruction, static_cast<std::uint32_t>(m_instructions.size()));
+        if (inserted)
+        {
+            m_instructions.push_back(p_instruction);
+            m_decoded_instructions.push_back(
+                decode_instruction(p_instruction));
+        }
+        return position->second;
+    }
+
+    //! @brief Splits the text of an instruction into its opcode and operands.
+    //! @param p_instruction The instruction as a string e.g. "adds r1, r2".
+    //! @returns The instruction as an Assembly_Instruction.
+    // TODO: Settle on using boost for all string functions or not using
+    // boost.
+    static const GILES::Internal::Assembly_Instruction
+    parse_instruction(std::string p_instruction)
+    {
+        // Remove the opcode from the instruction and store it in a separate
+        // variable.
+        // TODO: Some instructions don't have operands, this fails with those.
+        std::string opcode = GILES::Internal::Utility::string_split_head_pop(
+            &p_instruction, " ");
+
+        // Remove white space
+        boost::algorithm::trim(p_instruction);
+
+        // Convert the rest of the instruction into a list of operands
+        std::vector<std::string> operands =
+            GILES::Internal::Utility::string_split(p_instruction, ",");
+
+        // Create a new instruction and return it.
+        return Assembly_Instruction(opcode, operands);
+    }
+
+    //! @brief Decodes the text of an instruction into a Decoded_Instruction.
+    //! This interns the opcode and resolves any registers using
+    //! m_register_names so it must be repeated if the register file layout
+    //! changes.
+    //! @param p_instruction The instruction as a string e.g. "adds r1, r2".
+    //! @returns The decoded instruction.
+    Decoded_Instruction decode_instruction(const std::string& p_instruction)
+    {
+        const auto instruction = parse_instruction(p_instruction);
+
+        const auto [position, inserted] = m_opcode_ids.try_emplace(
+            instruction.Get_Opcode(),
+            static_cast<std::uint32_t>(m_opcodes.size()));
+        if (inserted)
+        {
+            m_opcodes.push_back(instruction.Get_Opcode());
+        }
+
+        Decoded_Instruction decoded{};
+        decoded.Opcode             = position->second;
+        decoded.Number_of_Operands = static_cast<std::uint8_t>(
+            std::min<std::size_t>(instruction.Get_Number_of_Operands(),
+                                  std::numeric_limits<std::uint8_t>::max()));
+
+        for (std::size_t i{0}; i < Decoded_Instruction::max_operands; ++i)
+        {
+            decoded.Operands[i] =
+                i < instruction.Get_Number_of_Operands()
+                    ? decode_operand(instruction.Get_Operands()[i])
+                    : Decoded_Operand{
+                          Operand_Type::None, Decoded_Operand::no_register, 0};
+        }
+        return decoded;
+    }
+
+    //! @brief Decodes the text of a single operand into a Decoded_Operand.
+    //! Operands that are not registers are given the value that
+    //! Get_Operand_Value() has always used for them: the numeric prefix of the
+    //! text as parsed by std::stoi or 0 if there is none.
+    //! @param p_operand The operand as a string e.g. "r1" or "[r1".
+    //! @returns The decoded operand.
+    Decoded_Operand decode_operand(const std::string& p_operand) const
+    {
+        Decoded_Operand decoded{Operand_Type::Other,
+                                find_register(p_operand),
+                                0};
+        if (Decoded_Operand::no_register != decoded.Register)
+        {
+            decoded.Type = Operand_Type::Register;
+            return decoded;
+        }
+
+        if (!p_operand.empty() &&
+            ('[' == p_operand.front() || ']' == p_operand.back()))
+        {
+            decoded.Type     = Operand_Type::Memory;
+            decoded.Register = find_register(boost::algorithm::trim_copy_if(
+                p_operand, boost::is_any_of("[]")));
+        }
+
+        try
+        {
+            decoded.Immediate = std::stoi(p_operand);
+            if (Operand_Type::Other == decoded.Type)
+            {
+                decoded.Type = Operand_Type::Immediate;
+            }
+        }
+        // If p_operand is not numeric, i.e. corrupted data, try to recover by
+        // clearing that value.
+        catch (const std::logic_error&)
+        {
+            decoded.Immediate = 0;
+        }
+        return decoded;
+    }
+
+    //! @brief Finds the index of the register given by p_register_name
+    //! within m_register_names.
+    //! @param p_register_name The name of the register.
+    //! @returns The index of the register or Decoded_Operand::no_register if
+    //! p_register_name is not the name of a register.
+    std::uint16_t find_register(const std::string& p_register_name) const
+    {
+        const auto position = std::find(std::begin(m_register_names),
+                                         std::end(m_register_names),
+                                         p_register_name);
+        return std::end(m_register_names) == position
+                   ? Decoded_Operand::no_register
+                   : static_cast<std::uint16_t>(
+                         position - std::begin(m_register_names));
+    }
+
+    //! @brief Changes the layout of the register file to the one given by
+    //! p_register_names. The values of registers that are present in both the
+    //! old and new layouts are kept. As register operands refer to registers
+    //! by ID, every instruction is decoded again if the layout changes.
+    //! @param p_register_names The names of the registers, indexed by ID.
+    void set_register_layout(std::vector<std::string> p_register_names)
+    {
+        if (p_register_names == m_register_names)
+        {
+            return;
+        }
+
+        const std::size_t old_size{m_register_names.size()};
+        const std::size_t new_size{p_register_names.size()};
+
+        // Find where each register has moved to.
+        std::vector<std::uint16_t> new_ids;
+        for (const auto& name : m_register_names)
+        {
+            new_ids.push_back(static_cast<std::uint16_t>(
+                std::find(std::begin(p_register_names),
+                          std::end(p_register_names),
+                          name) -
+                std::begin(p_register_names)));
+        }
+
+        // Rebuild the history using the new layout.
+        const auto old_history = m_register_history;
+        auto cursor            = old_history.Get_Cursor();
+        std::vector<std::uint32_t> registers(new_size);
+
+        m_register_history.Clear(new_size);
+        for (std::size_t cycle{0}; cycle < old_history.Get_Cycle_Count();
+             ++cycle)
+        {
+            const auto* const old_registers = cursor.Seek(cycle);
+            for (std::size_t old_id{0}; old_id < old_size; ++old_id)
+            {
+                if (new_ids[old_id] < new_size)
+                {
+                    registers[new_ids[old_id]] = old_registers[old_id];
+                }
+            }
+            m_register_history.Append(registers.data());
+        }
+
+        m_register_names = std::move(p_register_names);
+
+        for (std::size_t i{0}; i < m_instructions.size(); ++i)
+        {
+            m_decoded_instructions[i] = decode_instruction(m_instructions[i]);
+        }
+    }
+
+    //! @brief Retrieves the ID of the register given by p_register_name,
+    //! adding it to the end of the register file layout if it is not
+    //! already present.
+    //! @param p_register_name The name of the register.
+    //! @returns The ID of the register.
+    std::uint16_t add_register(const std::string& p_register_name)
+    {
+        if (const auto id = find_register(p_register_name);
+            Decoded_Operand::no_register != id)
+        {
+            return id;
+        }
+
+        auto register_names = m_register_names;
+        register_names.push_back(p_register_name);
+        set_register_layout(std::move(register_names));
+        return static_cast<std::uint16_t>(m_register_names.size() - 1);
+    }
+
+    //! @brief Stores a value in the pipeline stage given by p_stage during the
+    //! clock cycle given by p_cycle. Instructions are stored as indexes into
+    //! m_instructions, States are stored within the State column and all other
+    //! values are stored in a column of their own type.
+    //! @param p_stage The pipeline stage to store the value in.
+    //! @param p_cycle The clock cycle at which to store the value.
+    //! @param p_value The value to be stored.
+    template <class T_Value_Type>
+    void set_value(Pipeline_Stage& p_stage,
+                   const std::size_t p_cycle,
+                   const T_Value_Type& p_value)
+    {
+        if constexpr (std::is_same_v<T_Value_Type, State>)
+        {
+            p_stage.States[p_cycle] = p_value;
+        }
+        else if constexpr (std::is_same_v<T_Value_Type, std::string>)
+        {
+            p_stage.States[p_cycle]          = State::Normal;
+            p_stage.Instruction_IDs[p_cycle] = intern_instruction(p_value);
+        }
+        else
+        {
+            p_stage.States[p_cycle]          = State::Normal;
+            p_stage.Instruction_IDs[p_cycle] = no_instruction;
+
+            if (auto* column = get_column<T_Value_Type>(p_stage))
+            {
+                column->Values[p_cycle] = p_value;
+            }
+            else
+            {
+                // This stage already contains values of another type, fall
+                // back to storing values of any type.
+                get_any_column(p_stage).Values[p_cycle] = p_value;
+            }
+        }
+    }
+
+    //! @brief Retrieves the column used to store values of type
+    //! T_Value_Type within p_stage, creating it if the pipeline stage does not
+    //! yet contain any values.
+    //! @param p_stage The pipeline stage to retrieve the column from.
+    //! @returns A pointer to the column or nullptr if the pipeline stage
+    //! already stores values of a different type.
+    template <class T_Value_Type>
+    Column<T_Value_Type>* get_column(Pipeline_Stage& p_stage) const
+    {
+        if (!p_stage.Values)
+        {
+            p_stage.Values = std::make_unique<Column<T_Value_Type>>(
+                m_number_of_cycles, Get_Memory_Resource());
+        }
+        return dynamic_cast<Column<T_Value_Type>*>(p_stage.Values.get());
+    }
+
+    //! @brief Converts the values stored within p_stage into a column of
+    //! std::any. This is only needed in the unusual case where a simulator
+    //! stores values of more than one type within a single pipeline stage.
+    //! @param p_stage The pipeline stage to convert.
+    //! @returns The converted column.
+    Column<std::any>& get_any_column(Pipeline_Stage& p_stage) const
+    {
+        if (auto* column = get_column<std::any>(p_stage))
+        {
+            return *column;
+        }
+
+        auto converted = std::make_unique<Column<std::any>>(
+            m_number_of_cycles, Get_Memory_Resource());
+        for (std::size_t cycle{0}; cycle < m_number_of_cycles; ++cycle)
+        {
+            converted->Values[cycle] = p_stage.Values->Get_Any(cycle);
+        }
+        auto& column   = *converted;
+        p_stage.Values = std::move(converted);
+        return column;
+    }
 
     //! @brief Retrieves the type of state of the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle. This is
+    //! p_handle at the clock cycle given by p_cycle. This is
     //! different from retrieving the value as this will return an enum
     //! representing the type of value. If the pipeline stage was behaving in a
     //! regular fashion at the given clock cycle, 'Normal' will be returned.
     //! Other states such as 'Stalled' may also be returned.
+    //! @throws std::out_of_range This is thrown if there is no value stored
+    //! for the given pipeline stage during the given clock cycle.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns The requested type of state using the State enum.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     //! @see https://en.wikipedia.org/wiki/Pipeline_stall
     GILES::Internal::Execution::State
-    get_state(const uint32_t p_cycle,
-              const std::string& p_pipeline_stage_name) const
+    get_state(const std::uint32_t p_cycle, const Stage_Handle p_handle) const
     {
-        try
-        {
-            // TODO: If entire program is outside of trigger points then this
-            // will crash (size=0 out of range)
-            return std::any_cast<State>(
-                m_pipeline.at(p_cycle).at(p_pipeline_stage_name));
-        }
-        catch (const std::bad_any_cast&)
+        if (const auto state = Find_State(p_cycle, p_handle))
         {
-            // if the cast failed then it is not a state and instead a value
-            // therefore the state is implicitly normal.
-            return State::Normal;
+            return state.value();
         }
+        throw std::out_of_range("No value is stored for this pipeline "
+                                "stage during this clock cycle");
     }
 
 public:
@@ -134,12 +605,34 @@ public:
     //! stored for each clock cycle.
     //! @param p_number_of_cycles The number of clock cycles that occurred
     //! during the target programs execution.
+    //! @param p_resource The memory resource that the per clock cycle data is
+    //! allocated from, such as the Arena of the current worker thread. This
+    //! must outlive the Execution. Copies of the Execution allocate from the
+    //! default memory resource instead.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     //! @see https://en.wikipedia.org/wiki/Processor_register
-    explicit Execution(const std::size_t p_number_of_cycles)
-        : m_pipeline(p_number_of_cycles), m_registers(p_number_of_cycles)
+    explicit Execution(const std::size_t p_number_of_cycles,
+                       std::pmr::memory_resource* const p_resource =
+                           std::pmr::get_default_resource())
+        : m_pipeline(p_resource), m_instructions(), m_instruction_ids(),
+          m_decoded_instructions(p_resource), m_opcodes(), m_opcode_ids(),
+          m_number_of_cycles(p_number_of_cycles), m_register_names(),
+          m_register_history(
+              0, Register_History::default_keyframe_interval, p_resource),
+          m_registers_recorded(
+              p_number_of_cycles,
+              std::pmr::polymorphic_allocator<bool>{p_resource})
+    {
+    }
+
+    //! @brief Retrieves the memory resource that the Execution allocates
+    //! from. Models may also allocate any scratch memory they need whilst
+    //! generating traces from this.
+    //! @returns The memory resource.
+    std::pmr::memory_resource* Get_Memory_Resource() const noexcept
     {
+        return m_pipeline.get_allocator().resource();
     }
 
     //! @brief This allows for adding an entire pre recorded pipeline stage
@@ -158,11 +651,15 @@ public:
     //! @param p_pipeline_stage A vector containing all of the per clock
     //! cycle states of that pipeline stage. These are indexed by the number
     //! of clock clock cycles that have passed.
+    //! @param p_first_cycle The index within p_pipeline_stage of the value
+    //! to be stored in the first clock cycle of the Execution. This allows
+    //! only part of a longer recording to be added without copying it.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     template <class T_Value_Type>
     void Add_Pipeline_Stage(const std::string& p_pipeline_stage_name,
-                            const std::vector<T_Value_Type>& p_pipeline_stage)
+                            const std::vector<T_Value_Type>& p_pipeline_stage,
+                            const std::size_t p_first_cycle = 0)
     {
         // Ensure all pipeline stages are the same length
         // TODO: Try not to enforce all values to be assigned/known
@@ -170,7 +667,7 @@ public:
         // call for a more dynamic approach.
         // TODO: Make this work with Andres' simulator.
         /*
-         *if (p_pipeline_stage.size() != m_pipeline.size())
+         *if (p_pipeline_stage.size() != m_number_of_cycles)
          *{
          *    throw std::range_error(
          *        "All pipeline stages must be of the same length");
@@ -181,13 +678,18 @@ public:
         // Pipeline stages should all be the same length but may not be in the
         // case of errors.
         const std::size_t size{
-            std::min(p_pipeline_stage.size(), m_pipeline.size())};
+            p_first_cycle < p_pipeline_stage.size()
+                ? std::min(p_pipeline_stage.size() - p_first_cycle,
+                           m_number_of_cycles)
+                : 0};
 
-        // Transpose the vector into m_pipeline.
+        auto& stage = get_or_add_stage(p_pipeline_stage_name);
+
+        // Copy the vector into the columns of the pipeline stage.
         for (std::size_t cycle = 0; cycle < size; ++cycle)
         {
-            // Add it to m_pipeline.
-            m_pipeline[cycle][p_pipeline_stage_name] = p_pipeline_stage[cycle];
+            set_value<T_Value_Type>(
+                stage, cycle, p_pipeline_stage[p_first_cycle + cycle]);
         }
     }
 
@@ -212,22 +714,82 @@ public:
                    const std::string& p_pipeline_stage_name,
                    const T_Value_Type p_value)
     {
-        // Add it to m_pipeline.
-        m_pipeline[p_cycle][p_pipeline_stage_name] = p_value;
+        set_value<T_Value_Type>(
+            get_or_add_stage(p_pipeline_stage_name), p_cycle, p_value);
+    }
+
+    //! @brief Retrieves a handle to the pipeline stage given by
+    //! p_pipeline_stage_name. The handle can then be used to retrieve values
+    //! from that pipeline stage without looking it up by name again.
+    //! @param p_pipeline_stage_name The name of the pipeline stage. e.g.
+    //! "Execute".
+    //! @returns A handle to the pipeline stage. If the pipeline stage does not
+    //! exist then the handle will not be valid, which can be checked using
+    //! Stage_Handle::Is_Valid().
+    //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
+    Stage_Handle
+    Get_Stage_Handle(const std::string& p_pipeline_stage_name) const noexcept
+    {
+        for (std::size_t i{0}; i < m_pipeline.size(); ++i)
+        {
+            if (p_pipeline_stage_name == m_pipeline[i].Name)
+            {
+                return {i};
+            }
+        }
+        return {Stage_Handle::invalid_index};
+    }
+
+    //! @brief Looks up the type of state of the pipeline stage given by
+    //! p_handle at the clock cycle given by p_cycle. Unlike Get_State(), this
+    //! never throws or reports an error and so is suitable for calling during
+    //! every clock cycle. It can distinguish between a Normal, Stalled or
+    //! Flushing pipeline stage and one that has nothing stored at the given
+    //! clock cycle, whether because the clock cycle is out of range, the
+    //! pipeline stage does not exist or no value was recorded.
+    //! @param p_cycle The clock cycle number from which to retrieve the
+    //! pipeline state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
+    //! @returns The requested type of state using the State enum or an empty
+    //! optional if there is nothing stored.
+    //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
+    //! @see https://en.wikipedia.org/wiki/Clock_cycle
+    //! @see https://en.wikipedia.org/wiki/Pipeline_stall
+    std::optional<State> Find_State(const std::uint32_t p_cycle,
+                                    const Stage_Handle p_handle) const noexcept
+    {
+        if (p_handle.Index >= m_pipeline.size())
+        {
+            return std::nullopt;
+        }
+
+        const auto& states = m_pipeline[p_handle.Index].States;
+        return p_cycle < states.size() ? states[p_cycle] : std::nullopt;
+    }
+
+    //! @copydoc Find_State(const std::uint32_t, const Stage_Handle) const
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
+    std::optional<State>
+    Find_State(const std::uint32_t p_cycle,
+               const std::string& p_pipeline_stage_name) const noexcept
+    {
+        return Find_State(p_cycle, Get_Stage_Handle(p_pipeline_stage_name));
     }
 
     //! @brief Retrieves the state of the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle. This is a
+    //! p_handle at the clock cycle given by p_cycle. This is a
     //! template function. The template type specifies which type you which
     //! to receive. The type stored will be dynamically cast into the
     //! requested type where possible. When this is not possible, an
     //! exception will be thrown.
-    //! @throws std::bad_any_cast This is thrown when dynamically casting the
-    //! requested value to the requested type fails.
+    //! @throws std::invalid_argument This is thrown when the value stored is
+    //! not of the requested type.
+    //! @throws std::out_of_range This is thrown when there is no value stored
+    //! in the pipeline stage during the requested clock cycle.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns The requested state in the type given by the template
     //! T_Value_Type.
     //! @todo Is it worth having a function to retrieve the entire pipeline
@@ -236,22 +798,83 @@ public:
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     template <typename T_Value_Type>
     const T_Value_Type Get_Value(const uint32_t p_cycle,
-                                 const std::string& p_pipeline_stage_name) const
+                                 const Stage_Handle p_handle) const
     {
-        try
+        const auto& stage = get_stage(p_handle);
+        const auto state  = get_state(p_cycle, p_handle);
+
+        if constexpr (std::is_same_v<T_Value_Type, State>)
         {
-            return std::any_cast<T_Value_Type>(
-                m_pipeline.at(p_cycle).at(p_pipeline_stage_name));
+            if (State::Normal != state)
+            {
+                return state;
+            }
         }
-        catch (const std::bad_any_cast&)
+        else if (State::Normal == state)
         {
-            throw std::invalid_argument("The requested pipeline state is "
-                                        "not stored as the requested type");
+            const auto instruction_id = stage.Instruction_IDs[p_cycle];
+
+            if constexpr (std::is_same_v<T_Value_Type, std::string>)
+            {
+                if (no_instruction != instruction_id)
+                {
+                    return m_instructions[instruction_id];
+                }
+            }
+            else if (no_instruction == instruction_id)
+            {
+                if (const auto* column =
+                        dynamic_cast<const Column<T_Value_Type>*>(
+                            stage.Values.get()))
+                {
+                    return column->Values[p_cycle];
+                }
+            }
+
+            // The value may be stored alongside values of other types.
+            if (const auto* column =
+                    dynamic_cast<const Column<std::any>*>(stage.Values.get());
+                column && no_instruction == instruction_id)
+            {
+                if (const auto* value =
+                        std::any_cast<T_Value_Type>(&column->Values[p_cycle]))
+                {
+                    return *value;
+                }
+            }
         }
+        throw std::invalid_argument("The requested pipeline state is "
+                                    "not stored as the requested type");
+    }
+
+    //! @brief Retrieves the state of the pipeline stage given by
+    //! p_pipeline_stage_name at the clock cycle given by p_cycle. This is a
+    //! template function. The template type specifies which type you which
+    //! to receive. The type stored will be dynamically cast into the
+    //! requested type where possible. When this is not possible, an
+    //! exception will be thrown.
+    //! @throws std::invalid_argument This is thrown when the value stored is
+    //! not of the requested type.
+    //! @throws std::out_of_range This is thrown when there is no value stored
+    //! in the pipeline stage during the requested clock cycle.
+    //! @param p_cycle The clock cycle number from which to retrieve the
+    //! pipeline state.
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
+    //! @returns The requested state in the type given by the template
+    //! T_Value_Type.
+    //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
+    //! @see https://en.wikipedia.org/wiki/Clock_cycle
+    template <typename T_Value_Type>
+    const T_Value_Type Get_Value(const uint32_t p_cycle,
+                                 const std::string& p_pipeline_stage_name) const
+    {
+        return Get_Value<T_Value_Type>(p_cycle,
+                                       Get_Stage_Handle(p_pipeline_stage_name));
     }
 
     //! @brief Retrieves the type of state of the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle. This is
+    //! p_handle at the clock cycle given by p_cycle. This is
     //! different from retrieving the value as this will return an enum
     //! representing the type of value. If the pipeline stage was behaving in a
     //! regular fashion at the given clock cycle, 'Normal' will be returned.
@@ -261,27 +884,30 @@ public:
     //! as unsafe as it will hide out of bounds access.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns The requested type of state using the State enum.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     //! @see https://en.wikipedia.org/wiki/Pipeline_stall
+    State Get_State_Unsafe(const uint32_t p_cycle,
+                           const Stage_Handle p_handle) const noexcept
+    {
+        return Find_State(p_cycle, p_handle).value_or(State::Stalled);
+    }
+
+    //! @copydoc Get_State_Unsafe(const uint32_t, const Stage_Handle) const
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
     State Get_State_Unsafe(const uint32_t p_cycle,
                            const std::string& p_pipeline_stage_name) const
+        noexcept
     {
-        try
-        {
-            return get_state(p_cycle, p_pipeline_stage_name);
-        }
-        catch (const std::out_of_range&)
-        {
-            return State::Stalled;
-        }
+        return Get_State_Unsafe(p_cycle,
+                                Get_Stage_Handle(p_pipeline_stage_name));
     }
 
     //! @brief Retrieves the type of state of the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle. This is
+    //! p_handle at the clock cycle given by p_cycle. This is
     //! different from retrieving the value as this will return an enum
     //! representing the type of value. If the pipeline stage was behaving in a
     //! regular fashion at the given clock cycle, 'Normal' will be returned.
@@ -291,40 +917,62 @@ public:
     //! program will exit.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns The requested type of state using the State enum.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     //! @see https://en.wikipedia.org/wiki/Pipeline_stall
-    State Get_State(const uint32_t p_cycle,
-                    const std::string& p_pipeline_stage_name) const
+    State Get_State(const uint32_t p_cycle, const Stage_Handle p_handle) const
     {
-        try
+        if (const auto state = Find_State(p_cycle, p_handle))
         {
-            return get_state(p_cycle, p_pipeline_stage_name);
+            return state.value();
         }
-        catch (const std::out_of_range&)
+        GILES::Internal::Error::Report_Error(
+            "Could not find a value in the pipeline stage \"{}\" "
+            "during clock cycle {}",
+            p_handle.Index < m_pipeline.size() ? m_pipeline[p_handle.Index].Name
+                                               : "",
+            p_cycle);
+    }
+
+    //! @copydoc Get_State(const uint32_t, const Stage_Handle) const
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
+    State Get_State(const uint32_t p_cycle,
+                    const std::string& p_pipeline_stage_name) const
+    {
+        if (const auto state =
+                Find_State(p_cycle, Get_Stage_Handle(p_pipeline_stage_name)))
         {
-            GILES::Internal::Error::Report_Error(
-                "Could not find a value in the pipeline stage \"{}\" "
-                "during clock cycle {}",
-                p_pipeline_stage_name,
-                p_cycle);
+            return state.value();
         }
+        GILES::Internal::Error::Report_Error(
+            "Could not find a value in the pipeline stage \"{}\" "
+            "during clock cycle {}",
+            p_pipeline_stage_name,
+            p_cycle);
     }
 
     //! @brief Checks to see if the type of state of the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle is Normal.
+    //! p_handle at the clock cycle given by p_cycle is Normal.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns Returns true if the state is normal, false if not.
-    //! @returns The requested type of state using the State enum.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     //! @see https://en.wikipedia.org/wiki/Pipeline_stall
+    bool Is_Normal_State(const std::uint32_t p_cycle,
+                         const Stage_Handle p_handle) const
+    {
+        return GILES::Internal::Execution::State::Normal ==
+               Get_State(p_cycle, p_handle);
+    }
+
+    //! @copydoc Is_Normal_State(const std::uint32_t, const Stage_Handle) const
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
     bool Is_Normal_State(const std::uint32_t p_cycle,
                          const std::string& p_pipeline_stage_name) const
     {
@@ -333,72 +981,226 @@ public:
     }
 
     //! @brief Checks to see if the type of state of the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle is Normal.
+    //! p_handle at the clock cycle given by p_cycle is Normal.
     //! This is marked an unsafe because it will not report an error in the case
     //! of out of bounds access, it will return false instead.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns Returns true if the state is normal, false if not.
-    //! @returns The requested type of state using the State enum.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     //! @see https://en.wikipedia.org/wiki/Pipeline_stall
+    bool Is_Normal_State_Unsafe(const std::uint32_t p_cycle,
+                                const Stage_Handle p_handle) const noexcept
+    {
+        return GILES::Internal::Execution::State::Normal ==
+               Get_State_Unsafe(p_cycle, p_handle);
+    }
+
+    //! @copydoc Is_Normal_State_Unsafe(const std::uint32_t, const
+    //! Stage_Handle) const
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
     bool Is_Normal_State_Unsafe(const std::uint32_t p_cycle,
                                 const std::string& p_pipeline_stage_name) const
+        noexcept
     {
         return GILES::Internal::Execution::State::Normal ==
                Get_State_Unsafe(p_cycle, p_pipeline_stage_name);
     }
 
     //! @brief Retrieves the instruction in the pipeline stage given by
-    //! p_pipeline_stage_name at the clock cycle given by p_cycle.
+    //! p_handle at the clock cycle given by p_cycle.
     //! @warning This function does not check the type of the Value before
     //! attempting to turn it into an assembly instruction. This should be
     //! done separately; Get_State() can help with this.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
-    //! @param p_pipeline_stage_name The pipeline stage from which to
-    //! retrieve the state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
     //! @returns The requested instruction.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
-    // TODO: Settle on using boost for all string functions or not using
-    // boost.
+    const GILES::Internal::Assembly_Instruction
+    Get_Instruction(const uint32_t p_cycle, const Stage_Handle p_handle) const
+    {
+        return parse_instruction(Get_Value<std::string>(p_cycle, p_handle));
+    }
+
+    //! @copydoc Get_Instruction(const uint32_t, const Stage_Handle) const
+    //! @param p_pipeline_stage_name The pipeline stage from which to
+    //! retrieve the state.
     const GILES::Internal::Assembly_Instruction
     Get_Instruction(const uint32_t p_cycle,
                     const std::string& p_pipeline_stage_name) const
     {
-        // Get the instruction as a string
-        std::string instruction =
-            Get_Value<std::string>(p_cycle, p_pipeline_stage_name);
+        return Get_Instruction(p_cycle,
+                               Get_Stage_Handle(p_pipeline_stage_name));
+    }
 
-        // Remove the opcode from the instruction and store it in a separate
-        // variable.
-        // TODO: Some instructions don't have operands, this fails with those.
-        std::string opcode =
-            GILES::Internal::Utility::string_split_head_pop(&instruction, " ");
+    //! @brief Retrieves the instruction in the pipeline stage given by
+    //! p_handle at the clock cycle given by p_cycle in its pre decoded form.
+    //! Unlike Get_Instruction(), this does not parse or copy any strings as
+    //! every distinct instruction was decoded once when it was added.
+    //! @throws std::invalid_argument This is thrown when the pipeline stage
+    //! does not contain an instruction in a Normal state during the requested
+    //! clock cycle.
+    //! @throws std::out_of_range This is thrown when there is no value stored
+    //! in the pipeline stage during the requested clock cycle.
+    //! @param p_cycle The clock cycle number from which to retrieve the
+    //! pipeline state.
+    //! @param p_handle The pipeline stage from which to retrieve the state.
+    //! @returns The requested instruction.
+    //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
+    //! @see https://en.wikipedia.org/wiki/Clock_cycle
+    const Decoded_Instruction&
+    Get_Decoded_Instruction(const uint32_t p_cycle,
+                            const Stage_Handle p_handle) const
+    {
+        const auto instruction_id =
+            get_stage(p_handle).Instruction_IDs.at(p_cycle);
 
-        // Remove white space
-        boost::algorithm::trim(instruction);
+        if (State::Normal != get_state(p_cycle, p_handle) ||
+            no_instruction == instruction_id)
+        {
+            throw std::invalid_argument("The requested pipeline state is "
+                                        "not an instruction");
+        }
+        return m_decoded_instructions[instruction_id];
+    }
 
-        // Convert the rest of the instruction into a list of operands
-        std::vector<std::string> operands =
-            GILES::Internal::Utility::string_split(instruction, ",");
+    //! @brief Retrieves the text of the opcode of p_instruction.
+    //! @param p_instruction The instruction to retrieve the opcode of.
+    //! @returns The opcode as a string e.g. "adds".
+    //! @see https://en.wikipedia.org/wiki/Opcode
+    const std::string&
+    Get_Opcode(const Decoded_Instruction& p_instruction) const
+    {
+        return m_opcodes[p_instruction.Opcode];
+    }
 
-        /*
-         *std::vector<std::uint32_t> operand_values;
-         *std::transform(operands.begin(),
-         *               operands.end(),
-         *               operand_values.begin(),
-         *               [&](const auto p_operand) {
-         *                   return Get_Operand_Value(p_cycle, p_operand);
-         *               });
-         */
+    //! @brief Retrieves the text of the opcode given by p_opcode_id.
+    //! @param p_opcode_id The ID of the opcode, which must be less than
+    //! Get_Opcode_Count().
+    //! @returns The opcode as a string e.g. "adds".
+    const std::string& Get_Opcode(const std::uint32_t p_opcode_id) const
+    {
+        return m_opcodes[p_opcode_id];
+    }
 
-        // Create a new instruction and return it.
-        return Assembly_Instruction(opcode, operands /*, operand_values*/);
+    //! @brief Retrieves the number of distinct opcodes that occur in the
+    //! Execution. Every Decoded_Instruction::Opcode is less than this.
+    //! @returns The number of distinct opcodes.
+    //! @see https://en.wikipedia.org/wiki/Opcode
+    std::size_t Get_Opcode_Count() const noexcept { return m_opcodes.size(); }
+
+    //! @brief Checks whether p_other had the same state, and the same opcode
+    //! whenever it was in a Normal state, as this Execution in the pipeline
+    //! stage given by p_pipeline_stage_name during every clock cycle. Only the
+    //! operands of the instructions, and so the data, may differ. Opcodes are
+    //! given their IDs in the order that they first occur so these are then
+    //! the same in both Executions.
+    //! @param p_other The other Execution.
+    //! @param p_pipeline_stage_name The pipeline stage to compare. e.g.
+    //! "Execute".
+    //! @returns True if the opcodes are the same, false if not.
+    //! @see https://en.wikipedia.org/wiki/Opcode
+    bool Has_Same_Opcodes(const Execution& p_other,
+                          const std::string& p_pipeline_stage_name) const
+    {
+        if (m_number_of_cycles != p_other.m_number_of_cycles ||
+            m_opcodes != p_other.m_opcodes)
+        {
+            return false;
+        }
+
+        const auto handle       = Get_Stage_Handle(p_pipeline_stage_name);
+        const auto other_handle =
+            p_other.Get_Stage_Handle(p_pipeline_stage_name);
+        if (!handle.Is_Valid() || !other_handle.Is_Valid())
+        {
+            return handle.Is_Valid() == other_handle.Is_Valid();
+        }
+
+        const auto& ids       = get_stage(handle).Instruction_IDs;
+        const auto& other_ids = p_other.get_stage(other_handle).Instruction_IDs;
+        for (std::uint32_t cycle{0}; cycle < m_number_of_cycles; ++cycle)
+        {
+            const auto state = Find_State(cycle, handle);
+            if (state != p_other.Find_State(cycle, other_handle))
+            {
+                return false;
+            }
+            if (State::Normal != state)
+            {
+                continue;
+            }
+
+            const auto id       = ids[cycle];
+            const auto other_id = other_ids[cycle];
+            if (no_instruction == id || no_instruction == other_id)
+            {
+                if (id != other_id)
+                {
+                    return false;
+                }
+            }
+            else if (m_decoded_instructions[id].Opcode !=
+                     p_other.m_decoded_instructions[other_id].Opcode)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! @brief Hashes the state, and the opcode whenever it was in a Normal
+    //! state, of the pipeline stage given by p_pipeline_stage_name during
+    //! every clock cycle, along with the text of every opcode. Executions for
+    //! which Has_Same_Opcodes() is true have the same hash, so this can be used
+    //! to recognise a schedule of instructions that has been seen before
+    //! without keeping the Execution that ran it.
+    //! @param p_pipeline_stage_name The pipeline stage to hash. e.g.
+    //! "Execute".
+    //! @returns The hash. This is FNV-1a, taking a clock cycle at a time
+    //! rather than a byte at a time.
+    //! @see https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+    std::uint64_t
+    Get_Opcode_Hash(const std::string& p_pipeline_stage_name) const
+    {
+        constexpr std::uint64_t prime{0x100000001b3};
+        std::uint64_t hash{0xcbf29ce484222325};
+
+        for (const auto& opcode : m_opcodes)
+        {
+            for (const char character : opcode)
+            {
+                hash = (hash ^ static_cast<unsigned char>(character)) * prime;
+            }
+            // Separates one opcode from the next.
+            hash = (hash ^ 0x100) * prime;
+        }
+
+        const auto handle = Get_Stage_Handle(p_pipeline_stage_name);
+        hash              = (hash ^ m_number_of_cycles) * prime;
+        for (std::uint32_t cycle{0}; cycle < m_number_of_cycles; ++cycle)
+        {
+            // The state is offset by one so that a missing state is 0. A
+            // state is only found if the pipeline stage exists.
+            const auto state = Find_State(cycle, handle);
+            std::uint64_t value{state ? static_cast<std::uint64_t>(*state) + 1
+                                      : 0};
+            if (State::Normal == state)
+            {
+                const auto id = m_pipeline[handle.Index].Instruction_IDs[cycle];
+                value |= std::uint64_t{no_instruction == id
+                                           ? no_instruction
+                                           : m_decoded_instructions[id].Opcode}
+                         << 32;
+            }
+            hash = (hash ^ value) * prime;
+        }
+        return hash;
     }
 
     //! @brief Adds the state of all registers as they were during every clock
@@ -409,11 +1211,76 @@ public:
     //! name.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
+    //! @note Prefer the overload taking fixed layout snapshots where the
+    //! simulator has a fixed set of registers, as this requires looking up
+    //! every register by name.
     //! @todo Validate that the same set of registers are given for each cycle?
     void Add_Registers_All(
         const std::vector<std::map<std::string, std::size_t>> p_registers)
     {
-        m_registers = p_registers;
+        // Every register seen during any clock cycle is part of the layout.
+        std::vector<std::string> register_names;
+        for (const auto& cycle : p_registers)
+        {
+            for (const auto& reg : cycle)
+            {
+                if (std::end(register_names) ==
+                    std::find(std::begin(register_names),
+                              std::end(register_names),
+                              reg.first))
+                {
+                    register_names.push_back(reg.first);
+                }
+            }
+        }
+
+        m_register_history.Clear(m_register_names.size());
+        set_register_layout(std::move(register_names));
+
+        m_registers_recorded.assign(p_registers.size(), true);
+        m_register_history.Clear(m_register_names.size());
+
+        std::vector<std::uint32_t> registers(m_register_names.size());
+        for (const auto& cycle : p_registers)
+        {
+            std::fill(std::begin(registers), std::end(registers), 0);
+            for (const auto& reg : cycle)
+            {
+                registers[find_register(reg.first)] =
+                    static_cast<std::uint32_t>(reg.second);
+            }
+            m_register_history.Append(registers.data());
+        }
+    }
+
+    //! @brief Adds the state of all registers as they were during every clock
+    //! cycle, as snapshots of a register file with a fixed layout. This is
+    //! much cheaper than adding a map of registers for every clock cycle as
+    //! no registers need to be looked up by name.
+    //! @tparam N The number of registers in the register file.
+    //! @param p_register_names The name of every register, indexed by
+    //! position within the snapshots. The position of a register is also its
+    //! ID within the Execution.
+    //! @param p_registers The snapshots of the register file, indexed by clock
+    //! cycle.
+    //! @see https://en.wikipedia.org/wiki/Register_file
+    //! @see https://en.wikipedia.org/wiki/Clock_cycle
+    template <std::size_t N>
+    void Add_Registers_All(
+        const std::array<std::string, N>& p_register_names,
+        const std::vector<std::array<std::uint32_t, N>>& p_registers)
+    {
+        m_register_history.Clear(m_register_names.size());
+        set_register_layout(std::vector<std::string>(
+            std::begin(p_register_names), std::end(p_register_names)));
+
+        m_registers_recorded.assign(p_registers.size(), true);
+        m_register_history.Clear(N);
+
+        for (const auto& snapshot : p_registers)
+        {
+            m_register_history.Append(snapshot.data());
+        }
     }
 
     //! @brief Adds the state of all registers as they were during the clock
@@ -424,35 +1291,130 @@ public:
     //! stored indexed by the register's name.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
+    //! @note Registers are stored as the changes from one clock cycle to the
+    //! next, so adding clock cycles in order is cheap but adding a clock cycle
+    //! before the last one added requires every clock cycle after it to be
+    //! stored again.
     //! @todo Validate that the same set of registers are given for each cycle?
     void
     Add_Registers_Cycle(const std::size_t p_cycle,
                         const std::map<std::string, std::size_t>& p_registers)
     {
-        m_registers[p_cycle] = p_registers;
+        for (const auto& reg : p_registers)
+        {
+            add_register(reg.first);
+        }
+        m_registers_recorded.at(p_cycle) = true;
+
+        std::vector<std::uint32_t> registers(m_register_names.size());
+        for (const auto& reg : p_registers)
+        {
+            registers[find_register(reg.first)] =
+                static_cast<std::uint32_t>(reg.second);
+        }
+
+        // Clock cycles that were skipped over have not been recorded and so
+        // are stored as unchanged.
+        while (m_register_history.Get_Cycle_Count() < p_cycle)
+        {
+            m_register_history.Append_Unchanged();
+        }
+
+        if (m_register_history.Get_Cycle_Count() == p_cycle)
+        {
+            m_register_history.Append(registers.data());
+            return;
+        }
+
+        // Otherwise the history must be rebuilt from this clock cycle on.
+        const auto old_history = m_register_history;
+        auto cursor            = old_history.Get_Cursor();
+
+        m_register_history.Clear(m_register_names.size());
+        for (std::size_t cycle{0}; cycle < old_history.Get_Cycle_Count();
+             ++cycle)
+        {
+            m_register_history.Append(p_cycle == cycle ? registers.data()
+                                                       : cursor.Seek(cycle));
+        }
     }
 
     //! @brief Checks whether or not a value is the name of a register by
-    //! checking if that register is present during the first clock cycle. This
-    //! is used to check whether or not operands are registers.
+    //! checking if that register is part of the register file. This is used
+    //! to check whether or not operands are registers.
     //! @param p_value The value to be checked.
     //! @returns Returns true if p_value is the name of a register. Returns
     //! false if it is not.
     bool Is_Register(const std::string& p_value) const
     {
-        return m_registers[0].end() != m_registers[0].find(p_value);
+        return Decoded_Operand::no_register != find_register(p_value);
+    }
+
+    //! @brief Retrieves the ID of the register given by p_register_name. This
+    //! should be looked up once and then used with Get_Register_Value() to
+    //! avoid looking up the register by name during every clock cycle.
+    //! @param p_register_name The name of the register.
+    //! @returns The ID of the register or Decoded_Operand::no_register if
+    //! p_register_name is not the name of a register.
+    std::uint16_t
+    Get_Register_ID(const std::string& p_register_name) const noexcept
+    {
+        return find_register(p_register_name);
     }
 
     //! @brief Get the state of the registers as they were after the number
     //! of clock cycles given by p_cycle have passed.
     //! @param p_cycle The cycle number at which to retrieve the registers
     //! from.
-    //! @returns The registers as they were during that cycle.
+    //! @returns The registers as they were during that cycle or an empty map
+    //! if no registers were recorded during that cycle.
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
-    const std::map<std::string, std::size_t>&
+    const std::map<std::string, std::size_t>
     Get_Registers(const std::size_t p_cycle) const
     {
-        return m_registers.at(p_cycle);
+        std::map<std::string, std::size_t> registers;
+        if (m_registers_recorded.at(p_cycle))
+        {
+            for (std::uint16_t id{0}; id < m_register_names.size(); ++id)
+            {
+                registers.emplace(m_register_names[id],
+                                  Get_Register_Value(p_cycle, id));
+            }
+        }
+        return registers;
+    }
+
+    //! @brief Retrieves the value of the register with the ID given by
+    //! p_register_id during the clock cycle given by p_cycle.
+    //! @throws std::out_of_range This is thrown if the registers were not
+    //! recorded during the given clock cycle or the register does not exist.
+    //! @param p_cycle The cycle number at which to retrieve the register
+    //! from.
+    //! @param p_register_id The ID of the register, as given by
+    //! Get_Register_ID().
+    //! @returns The value of the register.
+    //! @see https://en.wikipedia.org/wiki/Processor_register
+    std::uint32_t Get_Register_Value(const std::size_t p_cycle,
+                                     const std::uint16_t p_register_id) const
+    {
+        if (!m_registers_recorded.at(p_cycle) ||
+            p_register_id >= m_register_names.size())
+        {
+            throw std::out_of_range("The requested register was not "
+                                    "recorded during this clock cycle");
+        }
+        return m_register_history.Get_Value(p_cycle, p_register_id);
+    }
+
+    //! @brief Retrieves a Register_History::Cursor that can be used to scan
+    //! through the registers during successive clock cycles more cheaply than
+    //! retrieving them one at a time.
+    //! @returns The cursor. This is only valid for as long as this Execution
+    //! exists.
+    //! @see Get_Operand_Value()
+    Register_History::Cursor Get_Register_Cursor() const
+    {
+        return m_register_history.Get_Cursor();
     }
 
     //! @todo document
@@ -461,7 +1423,7 @@ public:
     std::size_t Get_Register_Value(const std::size_t p_cycle,
                                    const std::string& p_register_name) const
     {
-        return m_registers.at(p_cycle).at(p_register_name);
+        return Get_Register_Value(p_cycle, find_register(p_register_name));
     }
 
     //! @brief Retrieves the value of an operand in numerical form. If that
@@ -522,11 +1484,84 @@ public:
         }
     }
 
+    //! @brief Retrieves the value of an operand of a pre decoded instruction
+    //! in numerical form. If that operand is a register then the value
+    //! contained within that register is retrieved instead. If that operand
+    //! does not exist, 0 is returned.
+    //! @param p_cycle The cycle number at which to retrieve the operand
+    //! from.
+    //! @param p_instruction The instruction to retrieve the operand from.
+    //! @param p_operand_number The index of the operand to retrieve the value
+    //! from.
+    //! @returns The value stored in the operand, or the value in the register
+    //! pointed to by the operand in numeric form or, if there is not operand at
+    //! that index, 0.
+    //! @note This function is not zero indexed. Get_Operand_Value(x, y, 1) will
+    //! retrieve the first operand.
+    //! @note Operands past Decoded_Instruction::max_operands are not decoded
+    //! and so are also retrieved as 0.
+    std::size_t Get_Operand_Value(const std::size_t p_cycle,
+                                  const Decoded_Instruction& p_instruction,
+                                  const std::uint8_t p_operand_number) const
+    {
+        if (0 == p_operand_number ||
+            p_operand_number > Decoded_Instruction::max_operands)
+        {
+            return 0;
+        }
+
+        const auto& operand = p_instruction.Operands[p_operand_number - 1];
+        return Operand_Type::Register == operand.Type
+                   ? Get_Register_Value(p_cycle, operand.Register)
+                   : static_cast<std::size_t>(operand.Immediate);
+    }
+
+    //! @brief Retrieves the value of an operand of a pre decoded instruction
+    //! in numerical form, using p_registers to retrieve the value of
+    //! registers. This is cheaper than the overload without a cursor when
+    //! clock cycles are visited in order.
+    //! @param p_registers The cursor used to retrieve register values, as
+    //! given by Get_Register_Cursor().
+    //! @param p_cycle The cycle number at which to retrieve the operand
+    //! from.
+    //! @param p_instruction The instruction to retrieve the operand from.
+    //! @param p_operand_number The index of the operand to retrieve the value
+    //! from.
+    //! @returns The value stored in the operand, or the value in the register
+    //! pointed to by the operand in numeric form or, if there is not operand at
+    //! that index, 0.
+    //! @note This function is not zero indexed. Get_Operand_Value(x, y, z, 1)
+    //! will retrieve the first operand.
+    std::size_t Get_Operand_Value(Register_History::Cursor& p_registers,
+                                  const std::size_t p_cycle,
+                                  const Decoded_Instruction& p_instruction,
+                                  const std::uint8_t p_operand_number) const
+    {
+        if (0 == p_operand_number ||
+            p_operand_number > Decoded_Instruction::max_operands)
+        {
+            return 0;
+        }
+
+        const auto& operand = p_instruction.Operands[p_operand_number - 1];
+        if (Operand_Type::Register != operand.Type)
+        {
+            return static_cast<std::size_t>(operand.Immediate);
+        }
+
+        if (!m_registers_recorded.at(p_cycle))
+        {
+            throw std::out_of_range("The requested register was not "
+                                    "recorded during this clock cycle");
+        }
+        return p_registers.Get_Value(p_cycle, operand.Register);
+    }
+
     //! @brief Retrieves the total number of clock cycles that occurred
     //! during the running of the target program.
     //! @returns The total number of clock cycles.
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
-    std::size_t Get_Cycle_Count() const { return m_pipeline.size(); }
+    std::size_t Get_Cycle_Count() const { return m_number_of_cycles; }
 
     //! TODO: Future: Make use of this.
     //! TODO: Maybe move this to be under Execution instead.
@@ -0,0 +1,486 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Execution_Record.cpp
+    @brief Records Executions to a binary file and replays them from it,
+    allowing models to be ran without running the simulator again.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include "Execution_Record.hpp"
+
+#include <algorithm>    // for equal
+#include <cstring>      // for memcpy
+#include <type_traits>  // for is_trivially_copyable_v
+
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+
+#include "Decoded_Instruction.hpp"  // for Decoded_Instruction
+#include "Error.hpp"                // for Report_Error
+#include "Register_History.hpp"     // for Register_History
+
+// The columns below are copied to and from the file byte for byte.
+static_assert(
+    std::is_trivially_copyable_v<GILES::Internal::Decoded_Instruction> &&
+        std::is_trivially_copyable_v<GILES::Internal::Register_History::Delta>,
+    "Recorded columns must be trivially copyable");
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t),
+              "Recorded delta offsets are stored as 64 bit values");
+
+GILES::Internal::Execution_Record_Writer::Execution_Record_Writer(
+    const std::string& p_path)
+    : m_file(p_path, std::ios::binary | std::ios::trunc), m_path(p_path),
+      m_offsets(), m_closed(false)
+{
+    if (!m_file)
+    {
+        Error::Report_Error("Could not create the recorded Executions file "
+                            "'{}'",
+                            p_path);
+    }
+    // The header is written again, once the index has been written.
+    write_header(0);
+}
+
+GILES::Internal::Execution_Record_Writer::~Execution_Record_Writer()
+{
+    if (!m_closed)
+    {
+        Close();
+    }
+}
+
+void GILES::Internal::Execution_Record_Writer::write_bytes(
+    const void* p_data, const std::size_t p_size)
+{
+    m_file.write(static_cast<const char*>(p_data),
+                 static_cast<std::streamsize>(p_size));
+    if (!m_file)
+    {
+        Error::Report_Error("Could not write to the recorded Executions file "
+                            "'{}'",
+                            m_path);
+    }
+}
+
+void GILES::Internal::Execution_Record_Writer::write_u8(
+    const std::uint8_t p_value)
+{
+    write_bytes(&p_value, sizeof(p_value));
+}
+
+void GILES::Internal::Execution_Record_Writer::write_u32(
+    const std::uint32_t p_value)
+{
+    write_bytes(&p_value, sizeof(p_value));
+}
+
+void GILES::Internal::Execution_Record_Writer::write_u64(
+    const std::uint64_t p_value)
+{
+    write_bytes(&p_value, sizeof(p_value));
+}
+
+void GILES::Internal::Execution_Record_Writer::write_string(
+    const std::string_view p_string)
+{
+    write_u32(static_cast<std::uint32_t>(p_string.size()));
+    write_bytes(p_string.data(), p_string.size());
+}
+
+template <typename T>
+void GILES::Internal::Execution_Record_Writer::write_column(const T& p_column)
+{
+    write_u64(p_column.size());
+    write_bytes(p_column.data(),
+                p_column.size() * sizeof(typename T::value_type));
+}
+
+void GILES::Internal::Execution_Record_Writer::write_header(
+    const std::uint64_t p_index_offset)
+{
+    write_bytes(Execution_Record::magic.data(), Execution_Record::magic.size());
+    write_u32(Execution_Record::version);
+    write_u32(0);
+    write_u64(m_offsets.size());
+    write_u64(p_index_offset);
+}
+
+void GILES::Internal::Execution_Record_Writer::Write(
+    const Execution& p_execution, const std::string_view p_extra_data)
+{
+    if (m_closed)
+    {
+        Error::Report_Error("The recorded Executions file '{}' has already "
+                            "been closed",
+                            m_path);
+    }
+    m_offsets.push_back(static_cast<std::uint64_t>(m_file.tellp()));
+
+    write_u64(p_execution.m_number_of_cycles);
+    write_string(p_extra_data);
+
+    // Every distinct instruction, along with its decoded form.
+    write_u64(p_execution.m_instructions.size());
+    for (const auto& instruction : p_execution.m_instructions)
+    {
+        write_string(instruction);
+    }
+    write_column(p_execution.m_decoded_instructions);
+    write_u64(p_execution.m_opcodes.size());
+    for (const auto& opcode : p_execution.m_opcodes)
+    {
+        write_string(opcode);
+    }
+
+    // The registers.
+    write_u64(p_execution.m_register_names.size());
+    for (const auto& name : p_execution.m_register_names)
+    {
+        write_string(name);
+    }
+    write_u64(p_execution.m_registers_recorded.size());
+    for (const bool recorded : p_execution.m_registers_recorded)
+    {
+        write_u8(recorded);
+    }
+    const auto& history = p_execution.m_register_history;
+    write_u64(history.m_number_of_registers);
+    write_u64(history.m_keyframe_interval);
+    write_column(history.m_keyframes);
+    write_column(history.m_deltas);
+    write_column(history.m_delta_offsets);
+    write_column(history.m_last);
+
+    // The pipeline stages.
+    write_u64(p_execution.m_pipeline.size());
+    for (const auto& stage : p_execution.m_pipeline)
+    {
+        if (stage.Values)
+        {
+            Error::Report_Error("The pipeline stage '{}' contains values that "
+                                "are not instructions. These cannot be "
+                                "recorded",
+                                stage.Name);
+        }
+        write_string(stage.Name);
+
+        // States are stored as one byte each, 0 indicating that nothing was
+        // stored.
+        write_u64(stage.States.size());
+        for (const auto& state : stage.States)
+        {
+            write_u8(state ? 1 + static_cast<std::uint8_t>(state.value()) : 0);
+        }
+        write_column(stage.Instruction_IDs);
+    }
+}
+
+void GILES::Internal::Execution_Record_Writer::Close()
+{
+    const auto index_offset = static_cast<std::uint64_t>(m_file.tellp());
+    for (const auto offset : m_offsets)
+    {
+        write_u64(offset);
+    }
+    m_file.seekp(0);
+    write_header(index_offset);
+    m_file.flush();
+    m_closed = true;
+}
+
+//! @class Execution_Record_Reader::Cursor
+//! @brief Reads values from the memory mapped file one after another, ensuring
+//! that nothing is read from beyond the end of the file.
+class GILES::Internal::Execution_Record_Reader::Cursor
+{
+private:
+    //! The file being read from.
+    const Execution_Record_Reader& m_reader;
+
+    //! The position of the next value to be read.
+    std::size_t m_position;
+
+    //! @brief Reports that the file is corrupt and halts execution.
+    [[noreturn]] void corrupt() const
+    {
+        Error::Report_Error("The recorded Executions file '{}' is corrupt",
+                            m_reader.m_path);
+    }
+
+public:
+    Cursor(const Execution_Record_Reader& p_reader, const std::size_t p_offset)
+        : m_reader(p_reader), m_position(p_offset)
+    {
+        if (m_position > m_reader.m_size)
+        {
+            corrupt();
+        }
+    }
+
+    //! @brief Moves past p_size bytes.
+    //! @param p_size The number of bytes.
+    //! @returns A pointer to the first of the bytes moved past.
+    const unsigned char* Skip(const std::size_t p_size)
+    {
+        if (p_size > m_reader.m_size - m_position)
+        {
+            corrupt();
+        }
+        const auto* const data = m_reader.m_data + m_position;
+        m_position += p_size;
+        return data;
+    }
+
+    //! @brief Reads a single value of type T.
+    //! @returns The value.
+    template <typename T> T Read()
+    {
+        T value;
+        std::memcpy(&value, Skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    //! @brief Reads a string, without copying it.
+    //! @returns The string, pointing into the memory mapped file.
+    std::string_view Read_String()
+    {
+        const auto size = Read<std::uint32_t>();
+        return {reinterpret_cast<const char*>(Skip(size)), size};
+    }
+
+    //! @brief Reads a column of values into p_column, replacing its contents.
+    //! @param p_column The column to read into.
+    template <typename T> void Read_Column(T& p_column)
+    {
+        using value_t   = typename T::value_type;
+        const auto size = Read<std::uint64_t>();
+        if (size > (m_reader.m_size - m_position) / sizeof(value_t))
+        {
+            corrupt();
+        }
+        p_column.resize(size);
+        std::memcpy(p_column.data(), Skip(size * sizeof(value_t)),
+                    size * sizeof(value_t));
+    }
+
+    //! @brief Halts execution, reporting that the file is corrupt, unless
+    //! p_condition is true.
+    //! @param p_condition The condition that a valid file must satisfy.
+    void Require(const bool p_condition) const
+    {
+        if (!p_condition)
+        {
+            corrupt();
+        }
+    }
+};
+
+GILES::Internal::Execution_Record_Reader::Execution_Record_Reader(
+    const std::string& p_path)
+    : m_path(p_path), m_data(nullptr), m_size(0), m_offsets()
+{
+    const int file = open(p_path.c_str(), O_RDONLY);
+    if (-1 == file)
+    {
+        Error::Report_Error("Could not open the recorded Executions file '{}'",
+                            p_path);
+    }
+
+    struct stat file_status;
+    if (-1 == fstat(file, &file_status) ||
+        file_status.st_size < static_cast<off_t>(Execution_Record::header_size))
+    {
+        close(file);
+        Error::Report_Error("'{}' is not a recorded Executions file", p_path);
+    }
+    m_size = static_cast<std::size_t>(file_status.st_size);
+
+    void* const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (MAP_FAILED == data)
+    {
+        Error::Report_Error("Could not map the recorded Executions file '{}'",
+                            p_path);
+    }
+    m_data = static_cast<const unsigned char*>(data);
+
+    Cursor header{*this, 0};
+    const auto* const magic = header.Skip(Execution_Record::magic.size());
+    if (!std::equal(std::begin(Execution_Record::magic),
+                    std::end(Execution_Record::magic),
+                    magic))
+    {
+        Error::Report_Error("'{}' is not a recorded Executions file", p_path);
+    }
+    if (Execution_Record::version != header.Read<std::uint32_t>())
+    {
+        Error::Report_Error("'{}' was recorded using a different version of "
+                            "GILES and must be recorded again",
+                            p_path);
+    }
+    header.Read<std::uint32_t>();
+    const auto number_of_records = header.Read<std::uint64_t>();
+    const auto index_offset      = header.Read<std::uint64_t>();
+
+    Cursor index{*this, index_offset};
+    m_offsets.reserve(number_of_records);
+    for (std::uint64_t i{0}; i < number_of_records; ++i)
+    {
+        m_offsets.push_back(index.Read<std::uint64_t>());
+        index.Require(m_offsets.back() < index_offset);
+    }
+}
+
+GILES::Internal::Execution_Record_Reader::~Execution_Record_Reader()
+{
+    munmap(const_cast<unsigned char*>(m_data), m_size);
+}
+
+std::string_view GILES::Internal::Execution_Record_Reader::Get_Extra_Data(
+    const std::size_t p_index) const
+{
+    Cursor record{*this, m_offsets.at(p_index)};
+    record.Read<std::uint64_t>();
+    return record.Read_String();
+}
+
+GILES::Internal::Execution
+GILES::Internal::Execution_Record_Reader::Read_Execution(
+    const std::size_t p_index,
+    std::pmr::memory_resource* const p_resource) const
+{
+    Cursor record{*this, m_offsets.at(p_index)};
+
+    const auto number_of_cycles = record.Read<std::uint64_t>();
+    record.Read_String();
+
+    Execution execution{number_of_cycles, p_resource};
+
+    // Every distinct instruction, along with its decoded form.
+    const auto number_of_instructions = record.Read<std::uint64_t>();
+    for (std::uint64_t i{0}; i < number_of_instructions; ++i)
+    {
+        const auto instruction = record.Read_String();
+        execution.m_instruction_ids.emplace(std::string(instruction),
+                                            static_cast<std::uint32_t>(i));
+        execution.m_instructions.emplace_back(instruction);
+    }
+    record.Read_Column(execution.m_decoded_instructions);
+    const auto number_of_opcodes = record.Read<std::uint64_t>();
+    for (std::uint64_t i{0}; i < number_of_opcodes; ++i)
+    {
+        const auto opcode = record.Read_String();
+        execution.m_opcode_ids.emplace(std::string(opcode),
+                                       static_cast<std::uint32_t>(i));
+        execution.m_opcodes.emplace_back(opcode);
+    }
+
+    // The registers.
+    const auto number_of_registers = record.Read<std::uint64_t>();
+    for (std::uint64_t i{0}; i < number_of_registers; ++i)
+    {
+        execution.m_register_names.emplace_back(record.Read_String());
+    }
+    const auto number_of_recorded_cycles = record.Read<std::uint64_t>();
+    const auto* const recorded = record.Skip(number_of_recorded_cycles);
+    execution.m_registers_recorded.assign(number_of_recorded_cycles, false);
+    for (std::size_t cycle{0}; cycle < number_of_recorded_cycles; ++cycle)
+    {
+        execution.m_registers_recorded[cycle] = 0 != recorded[cycle];
+    }
+    auto& history                 = execution.m_register_history;
+    history.m_number_of_registers = record.Read<std::uint64_t>();
+    history.m_keyframe_interval   = record.Read<std::uint64_t>();
+    record.Read_Column(history.m_keyframes);
+    record.Read_Column(history.m_deltas);
+    record.Read_Column(history.m_delta_offsets);
+    record.Read_Column(history.m_last);
+
+    // Ensure nothing refers to anything that does not exist, as this would
+    // otherwise only be noticed when reading out of bounds later on.
+    record.Require(
+        number_of_instructions == execution.m_decoded_instructions.size() &&
+        number_of_registers == history.m_number_of_registers &&
+        0 != history.m_keyframe_interval &&
+        !history.m_delta_offsets.empty() &&
+        history.m_last.size() == number_of_registers &&
+        history.m_keyframes.size() ==
+            (history.Get_Cycle_Count() + history.m_keyframe_interval - 1) /
+                history.m_keyframe_interval * number_of_registers);
+    for (std::size_t cycle{0}; cycle < number_of_recorded_cycles; ++cycle)
+    {
+        record.Require(!execution.m_registers_recorded[cycle] ||
+                       cycle < history.Get_Cycle_Count());
+    }
+    for (const auto offset : history.m_delta_offsets)
+    {
+        record.Require(offset <= history.m_deltas.size());
+    }
+    for (const auto& delta : history.m_deltas)
+    {
+        record.Require(delta.Register < number_of_registers);
+    }
+    for (const auto& instruction : execution.m_decoded_instructions)
+    {
+        record.Require(instruction.Opcode < number_of_opcodes &&
+                       instruction.Number_of_Operands <=
+                           Decoded_Instruction::max_operands);
+        for (const auto& operand : instruction.Operands)
+        {
+            record.Require(Decoded_Operand::no_register == operand.Register ||
+                           operand.Register < number_of_registers);
+        }
+    }
+
+    // The pipeline stages.
+    const auto number_of_stages = record.Read<std::uint64_t>();
+    for (std::uint64_t i{0}; i < number_of_stages; ++i)
+    {
+        auto& stage = execution.m_pipeline.emplace_back(
+            std::string(record.Read_String()), number_of_cycles, p_resource);
+
+        record.Require(number_of_cycles == record.Read<std::uint64_t>());
+        const auto* const states = record.Skip(number_of_cycles);
+        for (std::size_t cycle{0}; cycle < number_of_cycles; ++cycle)
+        {
+            constexpr auto last_state =
+                1 + static_cast<std::uint8_t>(Execution::State::Flushing);
+            record.Require(states[cycle] <= last_state);
+            if (0 != states[cycle])
+            {
+                stage.States[cycle] =
+                    static_cast<Execution::State>(states[cycle] - 1);
+            }
+        }
+
+        record.Read_Column(stage.Instruction_IDs);
+        record.Require(number_of_cycles == stage.Instruction_IDs.size());
+        for (const auto id : stage.Instruction_IDs)
+        {
+            record.Require(Execution::no_instruction == id ||
+                           id < number_of_instructions);
+        }
+    }
+    return execution;
+}
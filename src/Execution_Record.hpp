@@ -0,0 +1,180 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Execution_Record.hpp
+    @brief Records Executions to a binary file and replays them from it,
+    allowing models to be ran without running the simulator again.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef EXECUTION_RECORD_HPP
+#define EXECUTION_RECORD_HPP
+
+#include <array>            // for array
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint32_t, uint64_t
+#include <fstream>          // for ofstream
+#include <memory_resource>  // for memory_resource, get_default_resource
+#include <string>           // for string
+#include <string_view>      // for string_view
+#include <vector>           // for vector
+
+#include "Execution.hpp"  // for Execution
+
+namespace GILES
+{
+namespace Internal
+{
+//! @brief The layout of a file of recorded Executions. All values are stored
+//! in the native byte order of the machine that recorded them.
+//! A file starts with a header:
+//! - Magic: "GILESEXE" (8 bytes)
+//! - Version (uint32), Reserved (uint32)
+//! - Number of records (uint64)
+//! - Offset of the record index (uint64)
+//!
+//! This is followed by each record, one after another, and then the record
+//! index, which contains the offset of every record as a uint64. Each record
+//! contains the number of clock cycles, the extra data reported by the
+//! simulator, every distinct instruction along with its decoded form, the
+//! register layout, the delta encoded register history and finally each
+//! pipeline stage as columns of states and instruction IDs.
+namespace Execution_Record
+{
+//! The first bytes of every file of recorded Executions.
+constexpr std::array<char, 8> magic{'G', 'I', 'L', 'E', 'S', 'E', 'X', 'E'};
+
+//! The version of the file format. This must be incremented whenever the
+//! layout changes.
+constexpr std::uint32_t version{1};
+
+//! The size of the header in bytes.
+constexpr std::size_t header_size{32};
+}  // namespace Execution_Record
+
+//! @class Execution_Record_Writer
+//! @brief Records Executions, one after another, to a file so that they can be
+//! replayed later by Execution_Record_Reader.
+//! @note This is not thread safe.
+class Execution_Record_Writer
+{
+private:
+    //! The file being written to.
+    std::ofstream m_file;
+
+    //! The path of the file being written to.
+    const std::string m_path;
+
+    //! The offset of each record within the file.
+    std::vector<std::uint64_t> m_offsets;
+
+    //! Whether the record index has been written yet.
+    bool m_closed;
+
+    void write_bytes(const void* p_data, std::size_t p_size);
+    void write_u8(std::uint8_t p_value);
+    void write_u32(std::uint32_t p_value);
+    void write_u64(std::uint64_t p_value);
+    void write_string(std::string_view p_string);
+    template <typename T> void write_column(const T& p_column);
+    void write_header(std::uint64_t p_index_offset);
+
+public:
+    //! @brief Creates the file given by p_path, replacing it if it already
+    //! exists, ready for Executions to be recorded into it.
+    //! @param p_path The path to the file.
+    explicit Execution_Record_Writer(const std::string& p_path);
+
+    //! @brief Finishes writing the file, if Close() has not already been
+    //! called.
+    ~Execution_Record_Writer();
+
+    Execution_Record_Writer(const Execution_Record_Writer&) = delete;
+    Execution_Record_Writer& operator=(const Execution_Record_Writer&) = delete;
+
+    //! @brief Appends an Execution to the end of the file.
+    //! @param p_execution The Execution to record.
+    //! @param p_extra_data Any extra data reported by the simulator alongside
+    //! the Execution.
+    void Write(const Execution& p_execution, std::string_view p_extra_data);
+
+    //! @brief Writes the record index, completing the file. Nothing can be
+    //! written after this.
+    void Close();
+};
+
+//! @class Execution_Record_Reader
+//! @brief Replays Executions recorded by Execution_Record_Writer. The file is
+//! memory mapped, so records are only read from disk once they are needed and
+//! any number of threads may read records at the same time.
+//! @see https://en.wikipedia.org/wiki/Memory-mapped_file
+class Execution_Record_Reader
+{
+private:
+    //! The path of the file being read.
+    const std::string m_path;
+
+    //! The contents of the file.
+    const unsigned char* m_data;
+
+    //! The size of the file in bytes.
+    std::size_t m_size;
+
+    //! The offset of each record within the file.
+    std::vector<std::uint64_t> m_offsets;
+
+    class Cursor;
+
+public:
+    //! @brief Memory maps the file given by p_path, ready for records to be
+    //! read from it. If the file cannot be read or is not a file of recorded
+    //! Executions then an error message will be reported and execution will
+    //! halt.
+    //! @param p_path The path to the file.
+    explicit Execution_Record_Reader(const std::string& p_path);
+
+    //! @brief Unmaps the file.
+    ~Execution_Record_Reader();
+
+    Execution_Record_Reader(const Execution_Record_Reader&) = delete;
+    Execution_Record_Reader& operator=(const Execution_Record_Reader&) = delete;
+
+    //! @brief Retrieves the number of Executions stored within the file.
+    //! @returns The number of records.
+    std::size_t Get_Record_Count() const noexcept { return m_offsets.size(); }
+
+    //! @brief Retrieves the extra data reported by the simulator alongside
+    //! the Execution given by p_index.
+    //! @param p_index The index of the record.
+    //! @returns The extra data, pointing into the memory mapped file.
+    std::string_view Get_Extra_Data(std::size_t p_index) const;
+
+    //! @brief Reconstructs the Execution given by p_index.
+    //! @param p_index The index of the record.
+    //! @param p_resource The memory resource to allocate the Execution from.
+    //! @returns The Execution.
+    Execution Read_Execution(std::size_t p_index,
+                             std::pmr::memory_resource* p_resource =
+                                 std::pmr::get_default_resource()) const;
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
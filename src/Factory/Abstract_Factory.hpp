@@ -27,7 +27,8 @@
 #ifndef ABSTRACT_FACTORY_HPP
 #define ABSTRACT_FACTORY_HPP
 
-#include <memory>         // for unique_ptr
+#include <functional>     // for function
+#include <memory>         // for shared_ptr, unique_ptr
 #include <stdexcept>      // for invalid_argument
 #include <string>         // for string
 #include <unordered_map>  // for unordered_map
@@ -61,17 +62,18 @@ class Model;
 template <typename base_t, typename... args_t> class Abstract_Factory
 {
 public:
-    //! A function pointer used to point to the function that calls the
-    //! constructor for objects in the factory.
-    using Create_Function = std::unique_ptr<base_t> (*)(args_t...);
+    //! A function that calls the constructor for objects in the factory. This
+    //! may hold state, such as the program of a Model that is loaded whilst
+    //! GILES is running.
+    using Create_Function = std::function<std::unique_ptr<base_t>(args_t...)>;
 
     //! @brief Retrieves an object's constructor from the factory by name.
     //! If an object with the given name is not found then an error message will
     //! be reported and execution will halt.
     //! @param p_type The name of the object to be retrieved.
-    //! @returns A function pointer, pointing at the constructor of the class
+    //! @returns A function that calls the constructor of the class
     //! corresponding to the name given by p_type.
-    static Create_Function Find(const std::string& p_type)
+    static const Create_Function& Find(const std::string& p_type)
     {
         // If p_type is registered.
         if (auto& all = Get_All(); all.end() != all.find(p_type))
@@ -108,8 +110,8 @@ public:
     //! @see https://www.bfilipek.com/2018/02/factory-selfregister.html
     //! @param p_type A string representing the type of the class being
     //! registered. This is used to identify classes.
-    //! @param p_create_function A pointer to a function that will return a
-    //! constructed instance of the class.
+    //! @param p_create_function A function that will return a constructed
+    //! instance of the class.
     //! @returns A bool indicating whether or not the class given by p_type was
     //! already registered.
     static bool Register(const std::string& p_type,
@@ -166,8 +168,9 @@ public:
 //! initialising a separate template is eliminated. Additionally, this
 //! provides for a more meaningful name. To see what is actually going on behind
 //! the scenes, refer to the Abstract_Factory class.
-using Model_Factory =
-    Abstract_Factory<Model, const Execution&, const Coefficients&>;
+using Model_Factory = Abstract_Factory<Model,
+                                       std::shared_ptr<const Execution>,
+                                       const Coefficients&>;
 
 //! @brief This exists only to simply the usage of the Abstract_Factory
 //! class. By providing an intermediate, the possibility of accidentally
@@ -28,7 +28,7 @@
 #ifndef ABSTRACT_FACTORY_REGISTER_HPP
 #define ABSTRACT_FACTORY_REGISTER_HPP
 
-#include <memory>  // for unique_ptr, make_unique
+#include <memory>  // for shared_ptr, unique_ptr, make_unique
 #include <string>  // for string
 
 #include "Abstract_Factory.hpp"
@@ -130,10 +130,11 @@ bool Abstract_Factory_Register<base_t, derived_t, args_t...>::m_is_registered{
 //! eliminated. To see what is actually going on behind the scenes, refer to the
 //! Abstract_Factory_Register class.
 template <typename derived_t>
-using Model_Factory_Register = Abstract_Factory_Register<Model,
-                                                         derived_t,
-                                                         const Execution&,
-                                                         const Coefficients&>;
+using Model_Factory_Register =
+    Abstract_Factory_Register<Model,
+                              derived_t,
+                              std::shared_ptr<const Execution>,
+                              const Coefficients&>;
 
 //! @brief This exists only to simply the usage of the
 //! Abstract_Factory_Register class. By providing an intermediate, the
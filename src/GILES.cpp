@@ -24,23 +24,31 @@
     @copyright GNU Affero General Public License Version 3+
 */
 
-#include <memory>         // for make_unique, unique_ptr
-#include <optional>       // for optional
-#include <string>         // for string
-#include <unordered_map>  // for unordered_map
-#include <unordered_set>  // for unordered_set
-#include <utility>        // for pair, move
+#include <algorithm>        // for min
+#include <cstddef>          // for size_t
+#include <deque>            // for deque
+#include <memory>           // for allocate_shared, shared_ptr, unique_ptr
+#include <memory_resource>  // for polymorphic_allocator
+#include <optional>         // for optional
+#include <string>           // for string
+#include <unordered_map>    // for unordered_map
+#include <unordered_set>    // for unordered_set
+#include <utility>          // for pair, move
+#include <vector>           // for vector
 
 #include <Traces_Serialiser.hpp>
 #include <fmt/format.h>  // for print
 
 #include "Abstract_Factory.hpp"  // for Emulator_Factory, Model_Factory
+#include "Arena.hpp"             // for Arena
 #include "Coefficients.hpp"      // for Coefficients
 #include "Emulator.hpp"          // for Emulator
 #include "Error.hpp"             // for Report_Error
 #include "Execution.hpp"         // for Execution
+#include "Execution_Record.hpp"  // for Execution_Record_Reader
 #include "IO.hpp"                // for IO
 #include "Model.hpp"             // for Model
+#include "Recording_Window.hpp"  // for Recording_Window
 
 namespace GILES
 {
@@ -50,7 +58,46 @@ namespace GILES
 class GILES
 {
 private:
-    const Internal::Coefficients m_coefficients;
+    //! @brief The traces generated using one set of Coefficients. Every
+    //! profile is given the same Executions, so trace i of each profile was
+    //! generated from the same run of the target program.
+    struct Profile
+    {
+        //! @brief Loads the Coefficients of the profile.
+        //! @param p_coefficients_path The path to the Coefficients file.
+        explicit Profile(const std::string& p_coefficients_path)
+            : Coefficients_Path{p_coefficients_path},
+              Coefficients{
+                  Internal::IO().Load_Coefficients(p_coefficients_path)}
+        {
+        }
+
+        //! The path that the Coefficients were loaded from.
+        const std::string Coefficients_Path;
+
+        const Internal::Coefficients Coefficients;
+
+        // Future: This data is stored here as well as in Traces_Serialiser as
+        // it should be able to be accessed programmatically in the future.
+        // TODO: Add getter.
+        std::vector<std::vector<float>> Traces{};
+
+        Traces_Serialiser::Serialiser<float> Serialiser{};
+
+        //! The contribution of each term of the model to the traces, one set
+        //! of traces for each term, if the traces are being decomposed.
+        std::deque<Traces_Serialiser::Serialiser<float>> Term_Serialisers{};
+    };
+
+    //! One profile for each Coefficients file. A std::deque is used as the
+    //! profiles are neither copied nor moved once loaded.
+    std::deque<Profile> m_profiles;
+
+    //! The number of runs of the target program that each worker thread
+    //! simulates before generating their traces together, so that runs with
+    //! the same schedule of instructions can be modelled as a batch.
+    static constexpr std::size_t batch_size{16};
+
     const std::string m_program_path;
     const std::string m_model_name;
     const std::string m_simulator_name;
@@ -60,20 +107,33 @@ private:
     // A timeout to stop execution after a set number of cycles.
     std::optional<std::uint32_t> m_timeout;
 
+    // The region of the target program to be recorded and modelled.
+    Internal::Recording_Window m_recording_window{};
+
+    // The path to record every Execution to, if they are to be recorded.
+    std::optional<std::string> m_record_path{};
+
+    // The path to replay recorded Executions from instead of running the
+    // simulator, if they are to be replayed.
+    std::optional<std::string> m_replay_path{};
+
+    // Whether the contribution of each term of the model is saved as well as
+    // the traces.
+    bool m_term_traces{false};
+
+    // The names of the terms of the model, once they are known.
+    std::vector<std::string> m_term_names{};
+
     // These options are related to fault injection.
     bool m_fault;
     std::uint32_t m_fault_cycle;
     std::string m_fault_register;
     std::uint8_t m_fault_bit;
 
-    // Future: This data is stored here as well as in Traces_Serialiser as it
-    // should be able to be accessed programmatically in the future.
-    // TODO: Add getter.
-    std::vector<std::vector<float>> m_traces;
+    // The extra data given by the simulator for each trace. This is the same
+    // for every profile.
     std::vector<std::string> m_extra_data;
 
-    Traces_Serialiser::Serialiser<float> m_serialiser;
-
     // TODO: Future: This has been left in as it will be used in future versions
     // when running multiple models at once is supported.
     //! @todo Optimise this using std methods. Can be reduced down to
@@ -110,8 +170,9 @@ private:
     //! @todo: Future: This should only be checked if TRS files are being used.
     bool warn_if_not_constant_time() const
     {
-        const auto current_size      = m_traces.back().size();
-        static const auto first_size = m_traces.front().size();
+        const auto& traces           = m_profiles.front().Traces;
+        const auto current_size      = traces.back().size();
+        static const auto first_size = traces.front().size();
 
         // If there is no size difference then return false.
         if (first_size == current_size)
@@ -126,7 +187,7 @@ private:
             "Trace number 0 took {} clock cycles.\n"
             "Trace number {} took {} clock cycles.\n",
             first_size,
-            m_traces.size() - 1,  // Trace index
+            traces.size() - 1,  // Trace index
             current_size);
         return true;
     }
@@ -145,52 +206,331 @@ private:
         }
     }
 
+    //! @brief Retrieves the path that the traces of a profile are saved to.
+    //! When there are several profiles, the index of the profile is added to
+    //! the path given by the user, e.g. "traces_1.trs" for the second.
+    //! @param p_profile The index of the profile.
+    //! @returns The path.
+    std::string get_traces_path(const std::size_t p_profile) const
+    {
+        const auto& path = m_traces_path.value();
+        if (1 == m_profiles.size())
+        {
+            return path;
+        }
+        return add_suffix(path, std::to_string(p_profile));
+    }
+
+    //! @brief Adds a suffix to the name of a file, before the extension if
+    //! there is one, e.g. "traces_Operand1.trs".
+    //! @param p_path The path to the file.
+    //! @param p_suffix The suffix, which is separated from the name by an
+    //! underscore.
+    //! @returns The path with the suffix added.
+    static std::string add_suffix(const std::string& p_path,
+                                  const std::string& p_suffix)
+    {
+        auto extension = p_path.rfind('.');
+        if (std::string::npos == extension ||
+            (std::string::npos != p_path.find('/', extension)))
+        {
+            extension = p_path.size();
+        }
+        return p_path.substr(0, extension) + "_" + p_suffix +
+               p_path.substr(extension);
+    }
+
+    //! @brief Retrieves the traces of every profile.
+    //! @returns The traces of each profile, in the order that the
+    //! Coefficients were given.
+    std::vector<std::vector<std::vector<float>>> get_traces() const
+    {
+        std::vector<std::vector<std::vector<float>>> traces;
+        traces.reserve(m_profiles.size());
+        for (const auto& profile : m_profiles)
+        {
+            traces.emplace_back(profile.Traces);
+        }
+        return traces;
+    }
+
+    //! @brief Saves the traces of every profile, if a path was provided.
+    void save_traces()
+    {
+        if (!m_traces_path)
+        {
+            return;
+        }
+        for (std::size_t i{0}; i < m_profiles.size(); ++i)
+        {
+            const auto path = get_traces_path(i);
+            if (1 < m_profiles.size())
+            {
+                fmt::print("Saving traces using {} to {}\n",
+                           m_profiles[i].Coefficients_Path,
+                           path);
+            }
+            m_profiles[i].Serialiser.Save(path);
+
+            // The traces of each term are saved next to the traces.
+            for (std::size_t term{0}; term < m_term_names.size(); ++term)
+            {
+                m_profiles[i].Term_Serialisers[term].Save(
+                    add_suffix(path, m_term_names[term]));
+            }
+        }
+    }
+
+    //! @brief Generates a trace from each of p_executions, using the model
+    //! with the Coefficients of each profile in turn, and adds it, along with
+    //! its extra data, to the traces of that profile. The Executions are
+    //! shared by every profile so the target program is only simulated once.
+    //! Executions that ran the same schedule of instructions are modelled
+    //! together as a batch, using Model::Generate_Batch_Traces(). Any others
+    //! are modelled one at a time. If the traces are being decomposed then
+    //! the contribution of each term is generated in the same pass, using
+    //! Model::Generate_Batch_Term_Traces().
+    //! @param p_executions The Executions to generate the traces from.
+    //! @param p_extra_data Any extra data to be included in the trace of each
+    //! Execution.
+    //! @param p_steps_completed The number of traces generated so far.
+    //! @param p_warning_printed Whether the constant time warning has been
+    //! printed.
+    //! @param p_number_of_traces The total number of traces to be generated.
+    void generate_traces(
+        const std::vector<std::shared_ptr<const Internal::Execution>>&
+            p_executions,
+        const std::vector<std::string>& p_extra_data,
+        std::uint32_t& p_steps_completed,
+        bool& p_warning_printed,
+        const std::size_t p_number_of_traces)
+    {
+        // Initialise all models.
+        // TODO: Future: Add support for using multiple models at once
+        // using this code.
+        /*for (const auto& model_interface :
+             GILES::Internal::Model_Factory::Get_All())
+        {
+
+        // Construct the model, ready for use.
+        const auto model = GILES::Internal::Model_Factory::Construct(
+            model_interface.first, execution, m_coefficients);*/
+
+        // The traces of each Execution, for each profile.
+        std::vector<std::vector<std::vector<float>>> traces(
+            m_profiles.size(),
+            std::vector<std::vector<float>>(p_executions.size()));
+
+        // The traces of each term of each Execution, for each profile, if
+        // the traces are being decomposed.
+        std::vector<Internal::Model::Term_Traces> term_traces(
+            m_term_traces ? m_profiles.size() : 0,
+            Internal::Model::Term_Traces(p_executions.size()));
+        // The names of the terms, copied from a model while it is alive as
+        // the models are destroyed before the traces are added.
+        std::vector<std::string> term_names;
+        for (std::size_t profile{0}; profile < m_profiles.size(); ++profile)
+        {
+            std::vector<bool> generated(p_executions.size(), false);
+            for (std::size_t i{0}; i < p_executions.size(); ++i)
+            {
+                if (generated[i])
+                {
+                    continue;
+                }
+
+                // Construct the model, ready for use.
+                const auto model = Internal::Model_Factory::Construct(
+                    m_model_name,
+                    p_executions[i],
+                    m_profiles[profile].Coefficients);
+
+                // Gather the later Executions that can share its batch.
+                std::vector<std::size_t> batch;
+                std::vector<std::shared_ptr<const Internal::Execution>> others;
+                for (std::size_t j{i + 1}; j < p_executions.size(); ++j)
+                {
+                    if (!generated[j] &&
+                        model->Has_Same_Schedule(*p_executions[j]))
+                    {
+                        generated[j] = true;
+                        batch.push_back(j);
+                        others.push_back(p_executions[j]);
+                    }
+                }
+
+                Internal::Model::Term_Traces batch_term_traces;
+                auto batch_traces =
+                    m_term_traces ? model->Generate_Batch_Term_Traces(
+                                        others, batch_term_traces)
+                                  : model->Generate_Batch_Traces(others);
+                traces[profile][i] = std::move(batch_traces[0]);
+                for (std::size_t j{0}; j < batch.size(); ++j)
+                {
+                    traces[profile][batch[j]] =
+                        std::move(batch_traces[j + 1]);
+                }
+
+                if (m_term_traces)
+                {
+                    if (term_names.empty())
+                    {
+                        term_names = model->Get_Term_Names();
+                    }
+                    term_traces[profile][i] = std::move(batch_term_traces[0]);
+                    for (std::size_t j{0}; j < batch.size(); ++j)
+                    {
+                        term_traces[profile][batch[j]] =
+                            std::move(batch_term_traces[j + 1]);
+                    }
+                }
+            }
+        }
+
+        // Increment the counter of number of traces generated.
+#pragma omp atomic
+        p_steps_completed += static_cast<std::uint32_t>(p_executions.size());
+
+// This is marked critical to ensure everything gets added and
+// locks are automatically handled.
+#pragma omp critical
+        {
+            // Every model has the same terms, so a set of traces is created
+            // for each of them the first time that they are generated.
+            if (!term_names.empty() && m_term_names.empty())
+            {
+                m_term_names = std::move(term_names);
+                for (auto& profile : m_profiles)
+                {
+                    for (std::size_t term{0}; term < m_term_names.size();
+                         ++term)
+                    {
+                        profile.Term_Serialisers.emplace_back();
+                    }
+                }
+            }
+
+            for (std::size_t i{0}; i < p_executions.size(); ++i)
+            {
+                // Add the generated traces to the traces of each profile,
+                // along with any extra information given by the simulator.
+                for (std::size_t profile{0}; profile < m_profiles.size();
+                     ++profile)
+                {
+                    m_profiles[profile].Serialiser.Add_Trace(
+                        traces[profile][i], p_extra_data[i]);
+                    m_profiles[profile].Traces.emplace_back(
+                        std::move(traces[profile][i]));
+
+                    for (std::size_t term{0}; term < m_term_names.size();
+                         ++term)
+                    {
+                        m_profiles[profile].Term_Serialisers[term].Add_Trace(
+                            term_traces[profile][i][term], p_extra_data[i]);
+                    }
+                }
+                m_extra_data.emplace_back(p_extra_data[i]);
+
+                // If this is not the first trace gathered then ensure that
+                // all traces are the same length (Meaning the target
+                // algorithm runs in constant time). This is a requirement for
+                // using the TRS trace format. Every profile is generated from
+                // the same Execution so only the first needs checking.
+                // If this warning hasn't been printed before.
+                if (!p_warning_printed)
+                {
+                    // Will print a warning if the target program is not
+                    // constant time.
+                    p_warning_printed = warn_if_not_constant_time();
+                }
+            }
+        }
+
+        fmt::print("\rGenerated: {} of {} traces. ({}%)",
+                   p_steps_completed,
+                   p_number_of_traces,
+                   100.0 * p_steps_completed / p_number_of_traces);
+        //}
+    }
+
+    //! @brief Prints the combined statistics of the arena of every worker
+    //! thread.
+    //! @param p_arena_statistics The statistics.
+    static void print_arena_statistics(
+        const Internal::Arena::Statistics& p_arena_statistics)
+    {
+        fmt::print("Arena: {} allocations ({} bytes) over {} batches. The "
+                   "largest buffer was {} bytes and was grown {} times.\n",
+                   p_arena_statistics.Allocations,
+                   p_arena_statistics.Bytes_Allocated,
+                   p_arena_statistics.Resets,
+                   p_arena_statistics.Capacity,
+                   p_arena_statistics.Overflows);
+    }
+
 public:
     // TODO: Separate out some of the functionality in here into an API
     //! @brief The main entry point to the GILES library. This controls the
     //! running of GILES and invokes other components.
     //! @param p_program_path The path to the target executable to be ran in
     //! the emulator.
-    //! @param p_coefficients_path The path to the Coefficients file.
+    //! @param p_coefficients_paths The paths to the Coefficients files. A
+    //! set of traces is generated using each of them, from the same
+    //! Executions.
     //! @param p_traces_path The path to save the Traces to. This is an
     //! optional parameter and omitting it will cause the traces to not be
     //! saved to a file.
     GILES(const std::string& p_program_path,
-          const std::string& p_coefficients_path,
+          const std::vector<std::string>& p_coefficients_paths,
           const std::optional<std::string>& p_traces_path,
           const std::uint32_t p_number_of_runs,
           const std::string& p_model_name =
               "Hamming Weight")  // TODO: Set the default using cmake
                                  // configuring a static var in an external
                                  // file.
-    : m_coefficients{Internal::IO().Load_Coefficients(p_coefficients_path)},
-      m_program_path{p_program_path}, m_model_name{std::move(p_model_name)},
-      m_traces_path{p_traces_path},
-      m_number_of_runs{p_number_of_runs}, m_fault{false}, m_serialiser{}
+    : m_profiles{}, m_program_path{p_program_path},
+      m_model_name{std::move(p_model_name)}, m_traces_path{p_traces_path},
+      m_number_of_runs{p_number_of_runs}, m_fault{false}
     {
         // Check the supplied model name is valid
         Internal::Model_Factory::Find(p_model_name);
+
+        if (p_coefficients_paths.empty())
+        {
+            Internal::Error::Report_Error(
+                "At least one Coefficients file must be given");
+        }
+        for (const auto& coefficients_path : p_coefficients_paths)
+        {
+            m_profiles.emplace_back(coefficients_path);
+        }
     }
 
     //! @todo Document
     void Run()
     {
         warn_if_not_saving();
+
+        // Recorded Executions replace running the simulator.
+        if (m_replay_path)
+        {
+            Run_Replay(m_replay_path.value());
+            save_traces();
+            return;
+        }
+
         // Initialise all emulators.
         for (const auto& emulator_interface :
              Internal::Emulator_Factory::Get_All())
         {
             fmt::print("Using simulator: {}\n", emulator_interface.first);
 
-            // Run the emulator and save the results to m_traces.
+            // Run the emulator and save the results to the traces of each
+            // profile.
             Run_Simulator(emulator_interface.first);
 
             // If a path was provided then save.
-            if (m_traces_path)
-            {
-                // Save to file.
-                m_serialiser.Save(m_traces_path.value());
-            }
+            save_traces();
         }
     }
 
@@ -209,8 +549,40 @@ public:
         m_timeout = p_number_of_cycles;
     }
 
+    //! @brief Restricts recording and modelling to a region of the target
+    //! program, such as a cycle window, a trigger delimited region or the
+    //! code of a single function. The simulator skips everything outside of
+    //! it.
+    //! @param p_recording_window The region to be recorded.
+    void Set_Recording_Window(
+        const Internal::Recording_Window& p_recording_window)
+    {
+        m_recording_window = p_recording_window;
+    }
+
+    //! @brief Records every Execution produced by the simulator to the file
+    //! given by p_path so that they can be replayed later using Set_Replay().
+    //! @param p_path The path to the file.
+    void Set_Record(const std::string& p_path) { m_record_path = p_path; }
+
+    //! @brief Replays the Executions recorded in the file given by p_path,
+    //! instead of running the simulator. One trace is generated for each
+    //! recorded Execution.
+    //! @param p_path The path to the file.
+    void Set_Replay(const std::string& p_path) { m_replay_path = p_path; }
+
+    //! @brief Saves the contribution of each term of the model to every
+    //! sample as well as the traces, as a separate set of traces for each
+    //! term. These are generated in the same pass as the traces, so the term
+    //! that causes a sample to leak can be found from a single run. Each set
+    //! is saved next to the traces, with the name of the term added to the
+    //! path, e.g. "traces_Operand1.trs". The model must support this, as
+    //! given by Model::Get_Term_Names().
+    void Set_Term_Traces() { m_term_traces = true; }
+
     //! @brief Runs the simulator given by p_simulator_name and TODO:
-    decltype(m_traces) Run_Simulator(const std::string& p_simulator_name)
+    std::vector<std::vector<std::vector<float>>>
+    Run_Simulator(const std::string& p_simulator_name)
     {
         fmt::print("Using model: {}\n", m_model_name);
 
@@ -221,86 +593,177 @@ public:
         // thread safe. This is.
         uint32_t steps_completed{0};
 
-        fmt::print("Starting... (0.0%)\n");
+        // Only the data used by the model needs to be recorded by the
+        // simulator.
+        const auto& data_requirements =
+            Internal::Model::Get_Data_Requirements(m_model_name);
 
-#pragma omp parallel for
-        for (std::size_t i = 0; i < m_number_of_runs; ++i)
+        // Executions are recorded in full so that any model can replay them.
+        std::optional<Internal::Execution_Record_Writer> recorder;
+        if (m_record_path)
         {
-            // Construct the simulator, ready for use.
-            const auto simulator = Internal::Emulator_Factory::Construct(
-                p_simulator_name, m_program_path);
+            recorder.emplace(m_record_path.value());
+        }
 
-            if (m_timeout)
-            {
-                simulator->Add_Timeout(m_timeout.value());
-            }
+        fmt::print("Starting... (0.0%)\n");
 
-            if (m_fault)
+        // The combined statistics of the arena of every worker thread.
+        Internal::Arena::Statistics arena_statistics;
+
+#pragma omp parallel
+        {
+            // Each worker thread allocates the data for one batch of traces at
+            // a time from its own arena, which is reset in bulk between
+            // batches.
+            Internal::Arena arena;
+
+#pragma omp for schedule(dynamic)
+            for (std::size_t first = 0; first < m_number_of_runs;
+                 first += batch_size)
             {
-                simulator->Inject_Fault(
-                    m_fault_cycle, m_fault_register, m_fault_bit);
+                // Everything allocated from the arena during the previous
+                // batch has been destroyed by now.
+                arena.Reset();
+
+                const std::size_t count{std::min<std::size_t>(
+                    batch_size, m_number_of_runs - first)};
+
+                std::vector<std::shared_ptr<const Internal::Execution>>
+                    executions;
+                std::vector<std::string> extra_data;
+                executions.reserve(count);
+                extra_data.reserve(count);
+
+                for (std::size_t i{0}; i < count; ++i)
+                {
+                    // Construct the simulator, ready for use.
+                    const auto simulator =
+                        Internal::Emulator_Factory::Construct(
+                            p_simulator_name, m_program_path);
+
+                    if (!recorder)
+                    {
+                        simulator->Set_Data_Requirements(data_requirements);
+                    }
+                    simulator->Set_Memory_Resource(&arena);
+                    simulator->Set_Recording_Window(m_recording_window);
+
+                    if (m_timeout)
+                    {
+                        simulator->Add_Timeout(m_timeout.value());
+                    }
+
+                    if (m_fault)
+                    {
+                        simulator->Inject_Fault(
+                            m_fault_cycle, m_fault_register, m_fault_bit);
+                    }
+
+                    // The Execution is moved, rather than copied, into a
+                    // shared immutable object so that it can be handed to any
+                    // number of models without being copied.
+                    const std::shared_ptr<const Internal::Execution> execution{
+                        std::allocate_shared<Internal::Execution>(
+                            std::pmr::polymorphic_allocator<
+                                Internal::Execution>{&arena},
+                            simulator->Run_Code())};
+
+                    // Any extra data to be included in the trace.
+                    extra_data.emplace_back(simulator->Get_Extra_Data());
+
+                    if (recorder)
+                    {
+#pragma omp critical
+                        recorder->Write(*execution, extra_data.back());
+                    }
+
+                    executions.push_back(execution);
+                }
+
+                generate_traces(executions,
+                                extra_data,
+                                steps_completed,
+                                warning_printed,
+                                m_number_of_runs);
             }
 
-            const auto execution = simulator->Run_Code();
+#pragma omp critical
+            arena_statistics += arena.Get_Statistics();
+        }
+        fmt::print("\nDone!\n");
+        print_arena_statistics(arena_statistics);
+        return get_traces();
+    }
+
+    //! @brief Generates a trace from every Execution recorded in the file
+    //! given by p_replay_path, without running the simulator.
+    //! @param p_replay_path The path to the recorded Executions.
+    //! @returns The traces of each profile, in the order that the
+    //! Coefficients were given.
+    std::vector<std::vector<std::vector<float>>>
+    Run_Replay(const std::string& p_replay_path)
+    {
+        const Internal::Execution_Record_Reader reader{p_replay_path};
+        const auto number_of_traces = reader.Get_Record_Count();
 
-            // Any extra data to be included in the trace.
-            const auto extra_data = simulator->Get_Extra_Data();
+        fmt::print("Replaying: {} ({} Executions)\n",
+                   p_replay_path,
+                   number_of_traces);
+        fmt::print("Using model: {}\n", m_model_name);
 
-            // Initialise all models.
-            // TODO: Future: Add support for using multiple models at once using
-            // this code.
-            /*for (const auto& model_interface :
-                 GILES::Internal::Model_Factory::Get_All())
-            {
+        // Ensures that the constant time warning is not printed over and over.
+        bool warning_printed{false};
 
-            // Construct the model, ready for use.
-            const auto model = GILES::Internal::Model_Factory::Construct(
-                model_interface.first, execution, m_coefficients);*/
+        // Used to indicate progress to the user.
+        uint32_t steps_completed{0};
 
-            // Construct the model, ready for use.
-            const auto model = Internal::Model_Factory::Construct(
-                m_model_name, execution, m_coefficients);
+        fmt::print("Starting... (0.0%)\n");
 
-            // If this is not the first trace gathered then ensure that all
-            // traces are the same length (Meaning the target algorithm runs
-            // in constant time). This is a requirement for using the TRS
-            // trace format.
-            const auto trace = model->Generate_Traces();
+        // The combined statistics of the arena of every worker thread.
+        Internal::Arena::Statistics arena_statistics;
 
-            // Increment the counter of number of traces generated.
-#pragma omp atomic
-            ++steps_completed;
+#pragma omp parallel
+        {
+            Internal::Arena arena;
 
-// This is marked critical to ensure everything gets added and
-// locks are automatically handled.
-#pragma omp critical
+#pragma omp for schedule(dynamic)
+            for (std::size_t first = 0; first < number_of_traces;
+                 first += batch_size)
             {
-                // Add the generated trace to the list of traces.
-                m_traces.emplace_back(trace);
+                arena.Reset();
 
-                // Add any extra information given by the simulator to the
-                // traces.
-                m_extra_data.emplace_back(extra_data);
+                const std::size_t count{std::min<std::size_t>(
+                    batch_size, number_of_traces - first)};
 
-                m_serialiser.Add_Trace(trace, extra_data);
+                std::vector<std::shared_ptr<const Internal::Execution>>
+                    executions;
+                std::vector<std::string> extra_data;
+                executions.reserve(count);
+                extra_data.reserve(count);
 
-                // If this warning hasn't been printed before.
-                if (!warning_printed)
+                for (std::size_t i{first}; i < first + count; ++i)
                 {
-                    // Will print a warning if the target program is not
-                    // constant time.
-                    warning_printed = warn_if_not_constant_time();
+                    executions.push_back(std::allocate_shared<
+                                         Internal::Execution>(
+                        std::pmr::polymorphic_allocator<Internal::Execution>{
+                            &arena},
+                        reader.Read_Execution(i, &arena)));
+                    extra_data.emplace_back(reader.Get_Extra_Data(i));
                 }
+
+                generate_traces(executions,
+                                extra_data,
+                                steps_completed,
+                                warning_printed,
+                                number_of_traces);
             }
 
-            fmt::print("\rGenerated: {} of {} traces. ({}%)",
-                       steps_completed,
-                       m_number_of_runs,
-                       100.0 * steps_completed / m_number_of_runs);
-            //}
+#pragma omp critical
+            arena_statistics += arena.Get_Statistics();
         }
         fmt::print("\nDone!\n");
-        return m_traces;
+        print_arena_statistics(arena_statistics);
+        return get_traces();
     }
 };
 }  // namespace GILES
@@ -26,21 +26,58 @@
 #include "IO.hpp"
 
 #include <cstdlib>    // for exit, EXIT_FAILURE
+#include <cstring>    // for memcpy, memcmp, strncmp
 #include <fstream>    // for ifstream
+#include <iterator>   // for istreambuf_iterator
+#include <optional>   // for nullopt
 #include <stdexcept>  // for invalid_argument
+#include <string>     // for string
+#include <vector>     // for vector
+
+#include <elf.h>  // for Elf32_Ehdr, Elf32_Shdr, Elf32_Sym
 
 #include <nlohmann/json.hpp>  // for json, basic_json<>::exception
 
 #include "Coefficients.hpp"            // for Coefficients
+#include "Coefficients_Cache.hpp"      // for Coefficients_Cache
 #include "Error.hpp"                   // for Report_Error
 #include "Validator_Coefficients.hpp"  // for Validator_Coefficients
 
+namespace
+{
+//! @brief Copies a T out of p_contents at p_offset, reporting an error if it
+//! would read beyond the end.
+//! @param p_contents The contents of the ELF file.
+//! @param p_offset The offset of the T within p_contents.
+//! @param p_program_path The path of the ELF file, used in the error message.
+//! @returns The T.
+template <typename T>
+T read_elf(const std::vector<char>& p_contents,
+           const std::size_t p_offset,
+           const std::string& p_program_path)
+{
+    if (p_offset > p_contents.size() ||
+        sizeof(T) > p_contents.size() - p_offset)
+    {
+        GILES::Internal::Error::Report_Error("'{}' is not a valid ELF file",
+                                             p_program_path);
+    }
+    T value;
+    std::memcpy(&value, p_contents.data() + p_offset, sizeof(T));
+    return value;
+}
+}  // namespace
+
 namespace GILES
 {
 namespace Internal
 {
 //! @brief Loads the Coefficients from a file as specified by
 //! p_coefficients_path.
+//! Once a Coefficients file has been validated, it is stored in a
+//! Coefficients_Cache, if they are enabled. This is used instead, skipping
+//! parsing and validation, for as long as the contents of the Coefficients
+//! file are unchanged.
 //! @param p_coefficients_path The path where the Coefficients should be
 //! loaded from.
 //! @returns The Coefficients using the internal representation.
@@ -48,17 +85,30 @@ const GILES::Internal::Coefficients GILES::Internal::IO::Load_Coefficients(
     const std::string& p_coefficients_path) const
 {
     // read the Coefficients file into a JSON object
-    std::ifstream file{p_coefficients_path};
+    std::ifstream file{p_coefficients_path, std::ios::binary};
 
     nlohmann::json json;
 
     // If the file doesn't exist then don't validate it.
     if (file.is_open())
     {
+        const std::string contents{std::istreambuf_iterator<char>(file),
+                                   std::istreambuf_iterator<char>()};
+        const auto hash = Coefficients_Cache::Hash(contents);
+        const auto cache_path =
+            Coefficients_Cache::Get_Path(p_coefficients_path);
+
+        if (auto cached = Coefficients_Cache::Is_Enabled() && cache_path
+                              ? Coefficients_Cache::Load(*cache_path, hash)
+                              : std::nullopt)
+        {
+            return GILES::Internal::Coefficients{*cached};
+        }
+
         // Ensure the file contains valid JSON
         try
         {
-            json = nlohmann::json::parse(file);
+            json = nlohmann::json::parse(contents);
         }
         catch (nlohmann::detail::parse_error&)
         {
@@ -72,8 +122,96 @@ const GILES::Internal::Coefficients GILES::Internal::IO::Load_Coefficients(
 
         // This will throw an exception if validation fails.
         GILES::Internal::Validator_Coefficients::Validate_Json(json);
+
+        // The cache only speeds up later runs so failing to write it, e.g.
+        // in a read only directory, is not an error.
+        if (Coefficients_Cache::Is_Enabled() && cache_path)
+        {
+            Coefficients_Cache::Store(*cache_path, hash, json);
+        }
     }
     return GILES::Internal::Coefficients{json};
 }
+
+//! @brief Finds the addresses of the function or object given by
+//! p_symbol_name within the 32 bit ELF file given by p_program_path, using its
+//! symbol table. The file must be in the native byte order.
+//! @param p_program_path The path to the ELF file.
+//! @param p_symbol_name The name of the symbol.
+//! @returns The addresses [first, second) occupied by the symbol. The Thumb
+//! bit is cleared from the first address of functions.
+//! @see https://en.wikipedia.org/wiki/Executable_and_Linkable_Format
+std::pair<std::uint32_t, std::uint32_t>
+GILES::Internal::IO::Load_Symbol_Address_Range(
+    const std::string& p_program_path, const std::string& p_symbol_name) const
+{
+    std::ifstream file{p_program_path, std::ios::binary};
+    if (!file.is_open())
+    {
+        Error::Report_Error("Could not open '{}' to find the symbol '{}'",
+                            p_program_path,
+                            p_symbol_name);
+    }
+    const std::vector<char> contents{std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>()};
+
+    const auto header = read_elf<Elf32_Ehdr>(contents, 0, p_program_path);
+    if (0 != std::memcmp(header.e_ident, ELFMAG, SELFMAG) ||
+        ELFCLASS32 != header.e_ident[EI_CLASS])
+    {
+        Error::Report_Error("'{}' is not a 32 bit ELF file so the symbol '{}' "
+                            "cannot be found",
+                            p_program_path,
+                            p_symbol_name);
+    }
+
+    for (std::size_t i{0}; i < header.e_shnum; ++i)
+    {
+        const auto section = read_elf<Elf32_Shdr>(
+            contents,
+            header.e_shoff + i * sizeof(Elf32_Shdr),
+            p_program_path);
+        if (SHT_SYMTAB != section.sh_type)
+        {
+            continue;
+        }
+
+        // The names of the symbols are stored in a separate section.
+        const auto names = read_elf<Elf32_Shdr>(
+            contents,
+            header.e_shoff + section.sh_link * sizeof(Elf32_Shdr),
+            p_program_path);
+
+        for (std::size_t j{0}; j < section.sh_size / sizeof(Elf32_Sym); ++j)
+        {
+            const auto symbol = read_elf<Elf32_Sym>(
+                contents,
+                section.sh_offset + j * sizeof(Elf32_Sym),
+                p_program_path);
+
+            const std::size_t name{names.sh_offset + symbol.st_name};
+            if (name >= contents.size() ||
+                0 != std::strncmp(contents.data() + name,
+                                  p_symbol_name.c_str(),
+                                  contents.size() - name))
+            {
+                continue;
+            }
+
+            if (0 == symbol.st_size)
+            {
+                Error::Report_Error("The symbol '{}' in '{}' has no size. Use "
+                                    "the --trigger option instead",
+                                    p_symbol_name,
+                                    p_program_path);
+            }
+            const std::uint32_t first{symbol.st_value & ~1u};
+            return {first, first + symbol.st_size};
+        }
+    }
+    Error::Report_Error("The symbol '{}' could not be found in '{}'",
+                        p_symbol_name,
+                        p_program_path);
+}
 }  // namespace Internal
 }  // namespace GILES
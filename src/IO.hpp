@@ -26,7 +26,9 @@
 #ifndef IO_HPP
 #define IO_HPP
 
-#include <string>  // for string
+#include <cstdint>  // for uint32_t
+#include <string>   // for string
+#include <utility>  // for pair
 
 #include "Coefficients.hpp"  // for Coefficients
 
@@ -41,6 +43,10 @@ struct IO
 {
     const GILES::Internal::Coefficients
     Load_Coefficients(const std::string& p_coefficients_path) const;
+
+    std::pair<std::uint32_t, std::uint32_t>
+    Load_Symbol_Address_Range(const std::string& p_program_path,
+                              const std::string& p_symbol_name) const;
 };
 }  // namespace Internal
 }  // namespace GILES
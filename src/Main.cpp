@@ -25,6 +25,8 @@
 */
 
 #include <algorithm>  // for move
+#include <cctype>     // for isdigit
+#include <cstdint>    // for UINT32_MAX
 #include <cstdlib>    // for exit, EXIT_SUCCESS
 #include <memory>     // for __shared_ptr_access
 #include <optional>   // for optional
@@ -36,8 +38,12 @@
 #include <fmt/format.h>               // for format
 #include <fmt/ostream.h>              // for operator<<
 
-#include "Error.hpp"  // for Report_Exit
-#include "GILES.cpp"  // for GILES
+#include "Coefficients_Cache.hpp"           // for Coefficients_Cache
+#include "Error.hpp"                        // for Report_Exit
+#include "Expression/Model_Expression.hpp"  // for Model_Expression
+#include "GILES.cpp"                        // for GILES
+#include "IO.hpp"                           // for IO
+#include "Recording_Window.hpp"             // for Recording_Window
 
 //! Anonymous namespace is used as this functionality is only required when
 //! building not as a library.
@@ -45,7 +51,7 @@ namespace
 {
 // TODO: Put this all in a class? - Probably should
 std::string m_program_path;
-std::string m_coefficients_path;
+std::vector<std::string> m_coefficients_paths;
 std::string m_model_name;
 std::string m_simulator_name;
 std::optional<std::string> m_traces_path;
@@ -59,6 +65,23 @@ std::uint8_t m_fault_bit;
 
 std::optional<std::uint32_t> m_timeout;
 
+// These options restrict the region of the target program that is recorded.
+GILES::Internal::Recording_Window m_recording_window;
+
+// These options are related to recording and replaying Executions.
+std::optional<std::string> m_record_path;
+std::optional<std::string> m_replay_path;
+
+// Whether the contribution of each term of the model is saved as well.
+bool m_term_traces{false};
+
+// Where the binary copies of the Coefficients files are stored, if at all.
+std::optional<std::string> m_coefficients_cache_directory;
+bool m_coefficients_cache{true};
+
+// Models written in the expression language that are loaded before running.
+std::vector<std::string> m_expression_paths;
+
 //! @brief Prints an error message and exits. This is to be called when the
 //! program cannot run given the supplied command line arguments.
 //! @note This function is marked as noreturn as it is guaranteed to always
@@ -72,6 +95,31 @@ template <typename... args_t>
         "\nPlease use option --help or -h to see proper usage");
 }
 
+//! @brief Converts a command line option into an unsigned integer. Unlike
+//! std::stoul, negative numbers and trailing characters are rejected rather
+//! than wrapped around or ignored.
+//! @param p_option The option as given on the command line.
+//! @param p_base The base of the number. Base 0 also accepts hexadecimal, such
+//! as 0x1f4.
+//! @returns The value of the option.
+//! @throws std::invalid_argument If p_option is not an unsigned integer.
+//! @throws std::out_of_range If p_option is too large.
+std::size_t parse_unsigned(const std::string& p_option, const int p_base = 10)
+{
+    std::size_t length{0};
+    if (p_option.empty() || !std::isdigit(static_cast<unsigned char>(
+                                p_option.front())))
+    {
+        throw std::invalid_argument{p_option};
+    }
+    const std::size_t value{std::stoul(p_option, &length, p_base)};
+    if (p_option.size() != length)
+    {
+        throw std::invalid_argument{p_option};
+    }
+    return value;
+}
+
 //! @brief Interprets the command line flags.
 //! @param p_options The options as contained within a string.
 // TODO: Returns tag?
@@ -83,6 +131,8 @@ void parse_command_line_flags(int argc, char* argv[])
         argv[0])};
 
     std::vector<std::string> fault_options{};
+    std::vector<std::string> cycles_options{};
+    std::vector<std::string> trigger_options{};
 
     // clang-format off
 
@@ -93,9 +143,20 @@ void parse_command_line_flags(int argc, char* argv[])
             boost::program_options::value<std::uint32_t>()->default_value(1),
             "Number of traces to generate")
         ("coefficients,c",
-            boost::program_options::value<std::string>()->default_value(
-            "./coeffs.json"),
-            "Coefficients file")
+            boost::program_options::value<std::vector<std::string>>()
+            ->multitoken()
+            ->default_value(std::vector<std::string>{"./coeffs.json"},
+                            "./coeffs.json"),
+            "Coefficients file. Several can be given, e.g. \"--coefficients "
+            "a.json b.json\", to generate a set of traces using each of them "
+            "from the same runs of the simulator")
+        ("coefficients-cache",
+            boost::program_options::value<std::string>(),
+            "Store the binary copy of each coefficients file in this "
+            "directory, rather than in the user's cache directory")
+        ("no-coefficients-cache",
+            "Parse and validate the coefficients files on every run, without "
+            "storing a binary copy of them")
         ("input,i",
             boost::program_options::value<std::string>(),
             "Executable to be ran in the simulator")
@@ -121,7 +182,45 @@ void parse_command_line_flags(int argc, char* argv[])
             "significant bit in the register R0")
         ("timeout,t",
             boost::program_options::value<std::uint32_t>(),
-            "The number of clock cycles to force stop execution after");
+            "The number of clock cycles to force stop execution after")
+        ("cycles",
+            boost::program_options::value<std::vector<std::string>>(
+            &cycles_options)
+            ->multitoken(),
+            "Only record and model a window of clock cycles. e.g. \"--cycles "
+            "100 2000\" skips the first 100 clock cycles and records the 2000 "
+            "after them. These are counted from the start of --trigger or "
+            "--symbol if given")
+        ("trigger",
+            boost::program_options::value<std::vector<std::string>>(
+            &trigger_options)
+            ->multitoken(),
+            "Only record and model from the first clock cycle that the "
+            "program counter reaches the first address until it reaches the "
+            "second. e.g. \"--trigger 0x1f4 0x2a0\"")
+        ("symbol",
+            boost::program_options::value<std::string>(),
+            "Only record and model the clock cycles from when the program "
+            "counter first enters the function given by this ELF symbol until "
+            "it last leaves it")
+        ("record",
+            boost::program_options::value<std::string>(),
+            "Record every Execution produced by the simulator to this file so "
+            "that models can be ran on them later using --replay")
+        ("replay",
+            boost::program_options::value<std::string>(),
+            "Generate a trace from every Execution recorded in this file "
+            "using --record, instead of running the simulator")
+        ("terms",
+            "Also save the contribution of each term of the model to every "
+            "sample, as a separate set of traces for each term")
+        ("expression",
+            boost::program_options::value<std::vector<std::string>>(
+            &m_expression_paths)
+            ->multitoken(),
+            "Load models written in the expression language from these files. "
+            "Each is named after its file without the extension, e.g. "
+            "\"--expression HD.expr --model HD\"");
     // clang-format on
 
     boost::program_options::positional_options_description
@@ -157,11 +256,31 @@ void parse_command_line_flags(int argc, char* argv[])
         m_traces_path = options["output"].as<std::string>();
     }
 
+    if (options.count("replay"))
+    {
+        m_replay_path = options["replay"].as<std::string>();
+    }
+
+    if (options.count("record"))
+    {
+        m_record_path = options["record"].as<std::string>();
+    }
+
+    m_term_traces = 0 != options.count("terms");
+
+    if (options.count("coefficients-cache"))
+    {
+        m_coefficients_cache_directory =
+            options["coefficients-cache"].as<std::string>();
+    }
+    m_coefficients_cache = 0 == options.count("no-coefficients-cache");
+
     if (options.count("input"))  // if input flag is passed
     {
         m_program_path = options["input"].as<std::string>();
     }
-    else
+    // The simulator is not ran when replaying so no input is needed.
+    else if (!m_replay_path)
     {
         bad_options("Input option is required.(-i / --input \"Path to "
                     "Executable\")");
@@ -202,8 +321,82 @@ void parse_command_line_flags(int argc, char* argv[])
         m_timeout = options["timeout"].as<std::uint32_t>();
     }
 
+    // Recording window options
+    // Recorded Executions have already been restricted to their recording
+    // window, and there is no target program to read a symbol from.
+    if (m_replay_path &&
+        (options.count("cycles") || options.count("trigger") ||
+         options.count("symbol")))
+    {
+        bad_options("--cycles, --trigger and --symbol cannot be used with "
+                    "--replay as the simulator is not ran");
+    }
+
+    if (options.count("cycles"))
+    {
+        try
+        {
+            if (const std::size_t size{cycles_options.size()};
+                1 != size && 2 != size)
+            {
+                bad_options("Incorrect number of cycle window options "
+                            "provided.\nExpected: 1 or 2\nGot: {}",
+                            size);
+            }
+            m_recording_window.First_Cycle = parse_unsigned(cycles_options[0]);
+            if (2 == cycles_options.size())
+            {
+                m_recording_window.Number_of_Cycles =
+                    parse_unsigned(cycles_options[1]);
+            }
+        }
+        catch (const std::exception&)
+        {
+            bad_options("Cycle window options could not be interpreted");
+        }
+    }
+
+    if (options.count("trigger"))
+    {
+        try
+        {
+            constexpr std::uint8_t number_of_trigger_options{2};
+            if (const std::size_t size{trigger_options.size()};
+                size != number_of_trigger_options)
+            {
+                bad_options("Incorrect number of trigger options "
+                            "provided.\nExpected: {}\nGot: {}",
+                            number_of_trigger_options,
+                            size);
+            }
+            // Base 0 accepts addresses in hexadecimal, such as 0x1f4.
+            const std::size_t start{parse_unsigned(trigger_options[0], 0)};
+            const std::size_t stop{parse_unsigned(trigger_options[1], 0)};
+            if (UINT32_MAX < start || UINT32_MAX < stop)
+            {
+                throw std::out_of_range{"The trigger is not a 32 bit address"};
+            }
+            m_recording_window.Trigger_Start =
+                static_cast<std::uint32_t>(start);
+            m_recording_window.Trigger_Stop = static_cast<std::uint32_t>(stop);
+        }
+        catch (const std::exception&)
+        {
+            bad_options("Trigger options could not be interpreted");
+        }
+    }
+
+    if (options.count("symbol"))
+    {
+        // The symbol table is read from the target program itself.
+        m_recording_window.Address_Range =
+            GILES::Internal::IO().Load_Symbol_Address_Range(
+                m_program_path, options["symbol"].as<std::string>());
+    }
+
     // default "./coeffs.json" is used if flag is not passed
-    m_coefficients_path = options["coefficients"].as<std::string>();
+    m_coefficients_paths =
+        options["coefficients"].as<std::vector<std::string>>();
 
     // default "Thumb Sim" is used if flag is not passed
     m_simulator_name = options["simulator"].as<std::string>();
@@ -222,8 +415,19 @@ int main(int argc, char* argv[])
 {
     parse_command_line_flags(argc, argv);
 
+    // The Coefficients are loaded as soon as GILES is constructed.
+    GILES::Internal::Coefficients_Cache::Set_Directory(
+        m_coefficients_cache_directory);
+    GILES::Internal::Coefficients_Cache::Set_Enabled(m_coefficients_cache);
+
+    // The models must be registered before GILES looks up the model.
+    for (const auto& path : m_expression_paths)
+    {
+        GILES::Internal::Model_Expression::Load(path);
+    }
+
     GILES::GILES giles = GILES::GILES(m_program_path,
-                                      m_coefficients_path,
+                                      m_coefficients_paths,
                                       m_traces_path,
                                       m_number_of_runs,
                                       m_model_name);
@@ -240,6 +444,24 @@ int main(int argc, char* argv[])
         giles.Set_Timeout(m_timeout.value());
     }
 
+    // By default, the recording window records everything.
+    giles.Set_Recording_Window(m_recording_window);
+
+    if (m_record_path)
+    {
+        giles.Set_Record(m_record_path.value());
+    }
+
+    if (m_replay_path)
+    {
+        giles.Set_Replay(m_replay_path.value());
+    }
+
+    if (m_term_traces)
+    {
+        giles.Set_Term_Traces();
+    }
+
     giles.Run();
     return 0;
 }
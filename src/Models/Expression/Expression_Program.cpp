@@ -0,0 +1,932 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Expression_Program.cpp
+    @brief Contains the compiler of the expression language.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include "Expression_Program.hpp"
+
+#include <algorithm>      // for any_of, find
+#include <cctype>         // for isalpha, isalnum, isdigit, isspace
+#include <cstdint>        // for uint16_t, uint32_t
+#include <limits>         // for numeric_limits
+#include <stdexcept>      // for invalid_argument, out_of_range
+#include <string>         // for string, stod, stoull
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for move
+#include <vector>         // for vector
+
+#include <fmt/format.h>  // for format
+
+namespace
+{
+using Operation = GILES::Internal::Expression_Program::Operation;
+
+//! @brief The types of the registers used by an Operation.
+struct Signature
+{
+    //! Whether the result is held in an integer register.
+    bool Integer_Result;
+
+    //! The number of registers that are read.
+    std::size_t Sources;
+
+    //! Whether the registers that are read are integer registers.
+    bool Integer_Sources;
+};
+
+//! @brief Retrieves the types of the registers used by an Operation.
+//! @param p_operation The Operation.
+//! @returns The types of the registers.
+constexpr Signature get_signature(const Operation p_operation)
+{
+    switch (p_operation)
+    {
+    case Operation::Load_Integer:
+        return {true, 0, false};
+    case Operation::Load_Real:
+    case Operation::Load_Constant:
+    case Operation::Coefficient:
+        return {false, 0, false};
+    case Operation::To_Real:
+    case Operation::Hamming_Weight:
+    case Operation::Weigh_Bits:
+    case Operation::Weigh_Bit_Pairs:
+        return {false, 1, true};
+    case Operation::Not:
+        return {true, 1, true};
+    case Operation::And:
+    case Operation::Xor:
+    case Operation::Or:
+        return {true, 2, true};
+    case Operation::Negate:
+        return {false, 1, false};
+    case Operation::Add:
+    case Operation::Subtract:
+    case Operation::Multiply:
+    case Operation::Divide:
+        return {false, 2, false};
+    }
+    return {false, 0, false};
+}
+
+//! The names that cannot be assigned to, as they are part of the language.
+const std::unordered_set<std::string> reserved_names{"op1",
+                                                     "op2",
+                                                     "prev",
+                                                     "next",
+                                                     "constant",
+                                                     "hw",
+                                                     "hd",
+                                                     "bits",
+                                                     "pairs",
+                                                     "coefficient"};
+
+//! The name that the leakage of a clock cycle is assigned to.
+const std::string result_name{"leakage"};
+}  // namespace
+
+//! @class Compiler
+//! @brief Compiles the source of a model in a single pass, using a recursive
+//! descent parser that emits the instructions of each expression as soon as
+//! it has been read. Every intermediate value is given a register of its own.
+//! @see https://en.wikipedia.org/wiki/Recursive_descent_parser
+class GILES::Internal::Expression_Program::Compiler
+{
+private:
+    //! @brief A token read from the source.
+    struct Token
+    {
+        enum class Kind
+        {
+            Identifier,
+            Integer,
+            Real,
+            String,
+            Symbol,
+            End
+        };
+
+        Kind Type{Kind::End};
+
+        //! The text of the token, without the quotes of strings.
+        std::string Text{};
+
+        //! The value of integer and real literals.
+        std::uint32_t Integer{0};
+        double Real{0};
+
+        //! The position of the first character of the token.
+        std::size_t Line{1};
+        std::size_t Column{1};
+    };
+
+    //! @brief The register that holds the result of an expression.
+    struct Value
+    {
+        bool Is_Integer;
+        std::uint16_t Register;
+    };
+
+    const std::string& m_source;
+    Expression_Program& m_program;
+
+    //! The position of the next character to be read.
+    std::size_t m_position{0};
+    std::size_t m_line{1};
+    std::size_t m_column{1};
+
+    //! The token that is currently being parsed.
+    Token m_token{};
+
+    //! The value of every variable that has been assigned, by name.
+    std::unordered_map<std::string, Value> m_variables{};
+
+    //! @brief Stops compilation.
+    //! @param p_token The token where the error was found.
+    //! @param p_message A description of the error.
+    //! @throws std::invalid_argument Always, with the position of p_token.
+    [[noreturn]] static void fail(const Token& p_token,
+                                  const std::string& p_message)
+    {
+        throw std::invalid_argument(fmt::format(
+            "Line {}, column {}: {}", p_token.Line, p_token.Column, p_message));
+    }
+
+    //! @brief Reads one character of the source.
+    //! @returns The character.
+    char read_character()
+    {
+        const char character{m_source[m_position++]};
+        if ('\n' == character)
+        {
+            ++m_line;
+            m_column = 1;
+        }
+        else
+        {
+            ++m_column;
+        }
+        return character;
+    }
+
+    //! @brief Checks whether there are characters left to be read.
+    //! @returns True if there are, false if not.
+    bool has_character() const noexcept
+    {
+        return m_position < m_source.size();
+    }
+
+    //! @brief Retrieves the next character without reading it.
+    //! @returns The character or a null character at the end of the source.
+    char peek() const noexcept
+    {
+        return has_character() ? m_source[m_position] : '\0';
+    }
+
+    void read_number(Token& p_token);
+
+    void next_token();
+
+    //! @brief Checks whether the current token is the symbol p_symbol.
+    //! @param p_symbol The symbol.
+    //! @returns True if it is, false if not.
+    bool is_symbol(const char p_symbol) const
+    {
+        return Token::Kind::Symbol == m_token.Type &&
+               p_symbol == m_token.Text[0];
+    }
+
+    //! @brief Moves on to the next token if the current token is p_symbol.
+    //! @param p_symbol The symbol.
+    //! @returns True if it was, false if not.
+    bool accept(const char p_symbol)
+    {
+        if (is_symbol(p_symbol))
+        {
+            next_token();
+            return true;
+        }
+        return false;
+    }
+
+    //! @brief Moves on to the next token, which must be p_symbol.
+    //! @param p_symbol The symbol.
+    void expect(const char p_symbol)
+    {
+        if (!accept(p_symbol))
+        {
+            fail(m_token,
+                 fmt::format("Expected '{}' but found '{}'",
+                             p_symbol,
+                             describe(m_token)));
+        }
+    }
+
+    //! @brief Describes a token for an error message.
+    //! @param p_token The token.
+    //! @returns The description.
+    static std::string describe(const Token& p_token)
+    {
+        return Token::Kind::End == p_token.Type ? "the end of the model"
+                                                : p_token.Text;
+    }
+
+    std::uint16_t new_register(bool p_is_integer);
+
+    Value emit(Operation p_operation,
+               std::uint16_t p_source_1 = 0,
+               std::uint16_t p_source_2 = 0,
+               std::uint32_t p_argument = 0);
+
+    //! @brief Converts a value into a real number, if it is an integer.
+    //! @param p_value The value.
+    //! @returns The real number.
+    Value to_real(const Value p_value)
+    {
+        return p_value.Is_Integer ? emit(Operation::To_Real, p_value.Register)
+                                  : p_value;
+    }
+
+    //! @brief Checks that a value is an integer.
+    //! @param p_value The value.
+    //! @param p_token The token where the value was found.
+    //! @param p_use What the value is being used for, for the error message.
+    //! @returns The register that holds the integer.
+    static std::uint16_t integer(const Value p_value,
+                                 const Token& p_token,
+                                 const char* const p_use)
+    {
+        if (!p_value.Is_Integer)
+        {
+            fail(p_token,
+                 fmt::format("{} needs an integer but was given a real number",
+                             p_use));
+        }
+        return p_value.Register;
+    }
+
+    std::uint32_t find_term(const Token& p_token);
+
+    Value expression();
+    Value bitwise_xor();
+    Value bitwise_and();
+    Value additive();
+    Value multiplicative();
+    Value unary();
+    Value primary();
+    Value call(const Token& p_function);
+    Value instruction_operand(const Token& p_instruction);
+
+    void statement();
+
+public:
+    //! @brief Prepares to compile p_source into p_program.
+    //! @param p_source The source of the model.
+    //! @param p_program The program that receives the instructions.
+    Compiler(const std::string& p_source, Expression_Program& p_program)
+        : m_source{p_source}, m_program{p_program}
+    {
+    }
+
+    void Compile();
+};
+
+//! @brief Reads an integer or real literal into p_token. Integers are given
+//! in decimal or in hexadecimal with a leading 0x, and anything with a
+//! decimal point or an exponent is a real number.
+//! @param p_token Receives the literal.
+void GILES::Internal::Expression_Program::Compiler::read_number(
+    Token& p_token)
+{
+    const std::size_t start{m_position};
+    const bool is_hexadecimal{'0' == peek() &&
+                              m_position + 1 < m_source.size() &&
+                              ('x' == m_source[m_position + 1] ||
+                               'X' == m_source[m_position + 1])};
+    bool is_real{false};
+    if (is_hexadecimal)
+    {
+        read_character();
+        read_character();
+        while (std::isxdigit(static_cast<unsigned char>(peek())))
+        {
+            read_character();
+        }
+    }
+    else
+    {
+        while (std::isdigit(static_cast<unsigned char>(peek())) ||
+               '.' == peek())
+        {
+            is_real = is_real || '.' == peek();
+            read_character();
+        }
+        if ('e' == peek() || 'E' == peek())
+        {
+            is_real = true;
+            read_character();
+            if ('+' == peek() || '-' == peek())
+            {
+                read_character();
+            }
+            while (std::isdigit(static_cast<unsigned char>(peek())))
+            {
+                read_character();
+            }
+        }
+    }
+    p_token.Text = m_source.substr(start, m_position - start);
+
+    try
+    {
+        std::size_t length{0};
+        if (is_real)
+        {
+            p_token.Type = Token::Kind::Real;
+            p_token.Real = std::stod(p_token.Text, &length);
+        }
+        else
+        {
+            // A leading zero doesn't make a number octal.
+            p_token.Type       = Token::Kind::Integer;
+            const auto integer = std::stoull(
+                p_token.Text, &length, is_hexadecimal ? 16 : 10);
+            if (std::numeric_limits<std::uint32_t>::max() < integer)
+            {
+                throw std::out_of_range{p_token.Text};
+            }
+            p_token.Integer = static_cast<std::uint32_t>(integer);
+            p_token.Real    = static_cast<double>(integer);
+        }
+        if (length != p_token.Text.size())
+        {
+            throw std::invalid_argument{p_token.Text};
+        }
+    }
+    catch (const std::out_of_range&)
+    {
+        fail(p_token, fmt::format("'{}' is too large", p_token.Text));
+    }
+    catch (const std::invalid_argument&)
+    {
+        fail(p_token, fmt::format("'{}' is not a number", p_token.Text));
+    }
+}
+
+//! @brief Reads the next token of the source into m_token, skipping any
+//! white space and comments.
+void GILES::Internal::Expression_Program::Compiler::next_token()
+{
+    // Skip white space and comments.
+    while (has_character())
+    {
+        if (std::isspace(static_cast<unsigned char>(peek())))
+        {
+            read_character();
+        }
+        else if ('#' == peek())
+        {
+            while (has_character() && '\n' != peek())
+            {
+                read_character();
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    Token token;
+    token.Line   = m_line;
+    token.Column = m_column;
+    if (!has_character())
+    {
+        m_token = token;
+        return;
+    }
+
+    const char first{peek()};
+    if (std::isalpha(static_cast<unsigned char>(first)) || '_' == first)
+    {
+        token.Type = Token::Kind::Identifier;
+        while (std::isalnum(static_cast<unsigned char>(peek())) ||
+               '_' == peek())
+        {
+            token.Text.push_back(read_character());
+        }
+    }
+    else if (std::isdigit(static_cast<unsigned char>(first)) ||
+             ('.' == first && m_position + 1 < m_source.size() &&
+              std::isdigit(
+                  static_cast<unsigned char>(m_source[m_position + 1]))))
+    {
+        read_number(token);
+    }
+    else if ('"' == first)
+    {
+        token.Type = Token::Kind::String;
+        read_character();
+        while (has_character() && '"' != peek() && '\n' != peek())
+        {
+            token.Text.push_back(read_character());
+        }
+        if ('"' != peek())
+        {
+            fail(token, "The string is not closed");
+        }
+        read_character();
+    }
+    else if (std::string{"+-*/~&^|(),;=."}.find(first) != std::string::npos)
+    {
+        token.Type = Token::Kind::Symbol;
+        token.Text.push_back(read_character());
+    }
+    else
+    {
+        token.Text.push_back(first);
+        fail(token, fmt::format("Unexpected character '{}'", first));
+    }
+    m_token = std::move(token);
+}
+
+//! @brief Allocates a new register.
+//! @param p_is_integer Whether it is an integer register.
+//! @returns The number of the register.
+std::uint16_t GILES::Internal::Expression_Program::Compiler::new_register(
+    const bool p_is_integer)
+{
+    auto& count = p_is_integer ? m_program.m_number_of_integer_registers
+                               : m_program.m_number_of_real_registers;
+    if (std::numeric_limits<std::uint16_t>::max() <= count)
+    {
+        fail(m_token, "The model is too large");
+    }
+    return static_cast<std::uint16_t>(count++);
+}
+
+//! @brief Adds an instruction to the program, giving its result a new
+//! register.
+//! @param p_operation The operation.
+//! @param p_source_1 The first register that is read, if any.
+//! @param p_source_2 The second register that is read, if any.
+//! @param p_argument The argument of the instruction, if any.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::emit(
+    const Operation p_operation,
+    const std::uint16_t p_source_1,
+    const std::uint16_t p_source_2,
+    const std::uint32_t p_argument)
+{
+    const bool is_integer{get_signature(p_operation).Integer_Result};
+    const auto destination = new_register(is_integer);
+    m_program.m_instructions.push_back(
+        {p_operation, destination, p_source_1, p_source_2, p_argument});
+    return {is_integer, destination};
+}
+
+//! @brief Reads the name of an interaction term and finds its index within
+//! the terms of the program, adding it if this is the first time it is used.
+//! @param p_token The string token holding the name.
+//! @returns The index of the term.
+std::uint32_t GILES::Internal::Expression_Program::Compiler::find_term(
+    const Token& p_token)
+{
+    if (Token::Kind::String != p_token.Type)
+    {
+        fail(p_token,
+             fmt::format("Expected the name of an interaction term in quotes "
+                         "but found '{}'",
+                         describe(p_token)));
+    }
+    auto& terms = m_program.m_terms;
+    const auto term = std::find(terms.begin(), terms.end(), p_token.Text);
+    if (terms.end() != term)
+    {
+        return static_cast<std::uint32_t>(term - terms.begin());
+    }
+    terms.push_back(p_token.Text);
+    return static_cast<std::uint32_t>(terms.size() - 1);
+}
+
+//! @brief Parses an expression. The operators bind from the loosest, |, to
+//! the tightest, unary - and ~, in the same order as in C.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::expression()
+{
+    auto left = bitwise_xor();
+    while (is_symbol('|'))
+    {
+        const auto token = m_token;
+        next_token();
+        const auto right = bitwise_xor();
+        left             = emit(Operation::Or,
+                    integer(left, token, "|"),
+                    integer(right, token, "|"));
+    }
+    return left;
+}
+
+//! @brief Parses the operands of ^.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::bitwise_xor()
+{
+    auto left = bitwise_and();
+    while (is_symbol('^'))
+    {
+        const auto token = m_token;
+        next_token();
+        const auto right = bitwise_and();
+        left             = emit(Operation::Xor,
+                    integer(left, token, "^"),
+                    integer(right, token, "^"));
+    }
+    return left;
+}
+
+//! @brief Parses the operands of &.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::bitwise_and()
+{
+    auto left = additive();
+    while (is_symbol('&'))
+    {
+        const auto token = m_token;
+        next_token();
+        const auto right = additive();
+        left             = emit(Operation::And,
+                    integer(left, token, "&"),
+                    integer(right, token, "&"));
+    }
+    return left;
+}
+
+//! @brief Parses the operands of + and -.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::additive()
+{
+    auto left = multiplicative();
+    while (is_symbol('+') || is_symbol('-'))
+    {
+        const auto operation =
+            is_symbol('+') ? Operation::Add : Operation::Subtract;
+        next_token();
+        const auto right = to_real(multiplicative());
+        left = emit(operation, to_real(left).Register, right.Register);
+    }
+    return left;
+}
+
+//! @brief Parses the operands of * and /.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::multiplicative()
+{
+    auto left = unary();
+    while (is_symbol('*') || is_symbol('/'))
+    {
+        const auto operation =
+            is_symbol('*') ? Operation::Multiply : Operation::Divide;
+        next_token();
+        const auto right = to_real(unary());
+        left = emit(operation, to_real(left).Register, right.Register);
+    }
+    return left;
+}
+
+//! @brief Parses unary - and ~.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::unary()
+{
+    const auto token = m_token;
+    if (accept('-'))
+    {
+        return emit(Operation::Negate, to_real(unary()).Register);
+    }
+    if (accept('~'))
+    {
+        return emit(Operation::Not, integer(unary(), token, "~"));
+    }
+    return primary();
+}
+
+//! @brief Parses a literal, a name, a call or an expression in brackets.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::primary()
+{
+    const auto token = m_token;
+    switch (token.Type)
+    {
+    case Token::Kind::Integer:
+        next_token();
+        return emit(Operation::Load_Integer, 0, 0, token.Integer);
+    case Token::Kind::Real:
+        next_token();
+        m_program.m_reals.push_back(token.Real);
+        return emit(Operation::Load_Real,
+                    0,
+                    0,
+                    static_cast<std::uint32_t>(m_program.m_reals.size() - 1));
+    case Token::Kind::Identifier:
+        next_token();
+        if (is_symbol('('))
+        {
+            return call(token);
+        }
+        if ("op1" == token.Text || "op2" == token.Text ||
+            "prev" == token.Text || "next" == token.Text)
+        {
+            return instruction_operand(token);
+        }
+        if ("constant" == token.Text)
+        {
+            return emit(Operation::Load_Constant);
+        }
+        if (const auto variable = m_variables.find(token.Text);
+            m_variables.end() != variable)
+        {
+            return variable->second;
+        }
+        fail(token, fmt::format("'{}' has not been assigned", token.Text));
+    default:
+        if (accept('('))
+        {
+            const auto value = expression();
+            expect(')');
+            return value;
+        }
+        fail(token,
+             fmt::format("Expected a value but found '{}'", describe(token)));
+    }
+}
+
+//! @brief Parses op1, op2 or an operand of the previous or next instruction,
+//! such as prev.op1. These are held in the operand registers.
+//! @param p_instruction The first token, which has already been read.
+//! @returns The register that holds the operand.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::instruction_operand(
+    const Token& p_instruction)
+{
+    std::uint16_t first{0};
+    Token operand{p_instruction};
+    if ("prev" == p_instruction.Text || "next" == p_instruction.Text)
+    {
+        first = "prev" == p_instruction.Text ? 2 : 4;
+        expect('.');
+        operand = m_token;
+        next_token();
+    }
+    if ("op1" == operand.Text)
+    {
+        return {true, first};
+    }
+    if ("op2" == operand.Text)
+    {
+        return {true, static_cast<std::uint16_t>(first + 1)};
+    }
+    fail(operand,
+         fmt::format("Expected op1 or op2 but found '{}'", describe(operand)));
+}
+
+//! @brief Parses the arguments of a call to a function and emits it.
+//! @param p_function The name of the function, which has already been read.
+//! @returns The register that holds the result.
+GILES::Internal::Expression_Program::Compiler::Value
+GILES::Internal::Expression_Program::Compiler::call(const Token& p_function)
+{
+    expect('(');
+    const auto& name = p_function.Text;
+    Value result{false, 0};
+    if ("hw" == name)
+    {
+        const auto argument = m_token;
+        result              = emit(Operation::Hamming_Weight,
+                      integer(expression(), argument, "hw"));
+    }
+    else if ("hd" == name)
+    {
+        const auto first_argument = m_token;
+        const auto first = integer(expression(), first_argument, "hd");
+        expect(',');
+        const auto second_argument = m_token;
+        const auto second = integer(expression(), second_argument, "hd");
+        result = emit(Operation::Hamming_Weight,
+                      emit(Operation::Xor, first, second).Register);
+    }
+    else if ("bits" == name || "pairs" == name)
+    {
+        const auto term = find_term(m_token);
+        next_token();
+        expect(',');
+        const auto argument = m_token;
+        result              = emit("bits" == name ? Operation::Weigh_Bits
+                                     : Operation::Weigh_Bit_Pairs,
+                      integer(expression(), argument, name.c_str()),
+                      0,
+                      term);
+    }
+    else if ("coefficient" == name)
+    {
+        const auto term = find_term(m_token);
+        next_token();
+        expect(',');
+        const auto target = m_token;
+        next_token();
+        if (Token::Kind::Identifier != target.Type ||
+            ("prev" != target.Text && "next" != target.Text))
+        {
+            fail(target,
+                 fmt::format("Expected prev or next but found '{}'",
+                             describe(target)));
+        }
+        m_program.m_coefficients.push_back(
+            {term, "prev" == target.Text ? Target::Previous : Target::Next});
+        result = emit(
+            Operation::Coefficient,
+            0,
+            0,
+            static_cast<std::uint32_t>(m_program.m_coefficients.size() - 1));
+    }
+    else
+    {
+        fail(p_function,
+             fmt::format("'{}' is not a function", p_function.Text));
+    }
+    expect(')');
+    return result;
+}
+
+//! @brief Parses an assignment, such as "flips = op1 ^ prev.op1;".
+void GILES::Internal::Expression_Program::Compiler::statement()
+{
+    const auto name = m_token;
+    if (Token::Kind::Identifier != name.Type)
+    {
+        fail(name,
+             fmt::format("Expected the name of a variable but found '{}'",
+                         describe(name)));
+    }
+    if (reserved_names.count(name.Text))
+    {
+        fail(name, fmt::format("'{}' cannot be assigned to", name.Text));
+    }
+    if (m_variables.count(name.Text))
+    {
+        fail(name, fmt::format("'{}' has already been assigned", name.Text));
+    }
+    next_token();
+    expect('=');
+    auto value = expression();
+    if (result_name == name.Text)
+    {
+        value             = to_real(value);
+        m_program.m_result = value.Register;
+    }
+    expect(';');
+    m_variables.emplace(name.Text, value);
+}
+
+//! @brief Compiles the whole source and then removes every instruction whose
+//! result does not contribute to the leakage, along with the literals, terms
+//! and coefficients that only they used.
+//! @throws std::invalid_argument If the source is not a valid model.
+void GILES::Internal::Expression_Program::Compiler::Compile()
+{
+    next_token();
+    while (Token::Kind::End != m_token.Type)
+    {
+        statement();
+    }
+    if (!m_variables.count(result_name))
+    {
+        fail(m_token,
+             fmt::format("The model does not assign anything to '{}'",
+                         result_name));
+    }
+
+    // Every register is only written once, so an instruction is needed if
+    // its result is read by a later instruction that is needed.
+    auto& instructions = m_program.m_instructions;
+    std::vector<bool> needed_integers(m_program.m_number_of_integer_registers);
+    std::vector<bool> needed_reals(m_program.m_number_of_real_registers);
+    needed_reals[m_program.m_result] = true;
+    std::vector<Instruction> needed;
+    for (auto instruction = instructions.rbegin();
+         instructions.rend() != instruction;
+         ++instruction)
+    {
+        const auto signature = get_signature(instruction->Op);
+        auto& destinations =
+            signature.Integer_Result ? needed_integers : needed_reals;
+        if (!destinations[instruction->Destination])
+        {
+            continue;
+        }
+        auto& sources =
+            signature.Integer_Sources ? needed_integers : needed_reals;
+        if (1 <= signature.Sources)
+        {
+            sources[instruction->Source_1] = true;
+        }
+        if (2 <= signature.Sources)
+        {
+            sources[instruction->Source_2] = true;
+        }
+        needed.push_back(*instruction);
+    }
+    instructions.assign(needed.rbegin(), needed.rend());
+
+    // Only keep the literals, terms and coefficients that are still used, so
+    // that a model doesn't require terms that its leakage doesn't use.
+    std::vector<double> reals;
+    std::vector<std::string> terms;
+    std::vector<Coefficient_Reference> coefficients;
+    const auto keep_term = [this, &terms](const std::uint32_t p_term) {
+        const auto& name = m_program.m_terms[p_term];
+        const auto term  = std::find(terms.begin(), terms.end(), name);
+        if (terms.end() != term)
+        {
+            return static_cast<std::uint32_t>(term - terms.begin());
+        }
+        terms.push_back(name);
+        return static_cast<std::uint32_t>(terms.size() - 1);
+    };
+    for (auto& instruction : instructions)
+    {
+        switch (instruction.Op)
+        {
+        case Operation::Load_Real:
+            reals.push_back(m_program.m_reals[instruction.Argument]);
+            instruction.Argument =
+                static_cast<std::uint32_t>(reals.size() - 1);
+            break;
+        case Operation::Weigh_Bits:
+        case Operation::Weigh_Bit_Pairs:
+            instruction.Argument = keep_term(instruction.Argument);
+            break;
+        case Operation::Coefficient:
+        {
+            auto coefficient = m_program.m_coefficients[instruction.Argument];
+            coefficient.Term = keep_term(coefficient.Term);
+            coefficients.push_back(coefficient);
+            instruction.Argument =
+                static_cast<std::uint32_t>(coefficients.size() - 1);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    m_program.m_reals        = std::move(reals);
+    m_program.m_terms        = std::move(terms);
+    m_program.m_coefficients = std::move(coefficients);
+
+    m_program.m_uses_constant =
+        std::any_of(instructions.begin(),
+                    instructions.end(),
+                    [](const Instruction& p_instruction) {
+                        return Operation::Load_Constant == p_instruction.Op;
+                    });
+}
+
+//! @brief Compiles a model written in the expression language.
+//! @param p_source The source of the model.
+//! @returns The compiled program.
+//! @throws std::invalid_argument If p_source is not a valid model. The
+//! message gives the line and column of the error.
+GILES::Internal::Expression_Program
+GILES::Internal::Expression_Program::Compile(const std::string& p_source)
+{
+    Expression_Program program;
+    Compiler{p_source, program}.Compile();
+    return program;
+}
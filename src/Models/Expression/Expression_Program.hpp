@@ -0,0 +1,228 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Expression_Program.hpp
+    @brief Contains the Expression_Program class, a leakage model written in
+    the expression language and compiled into instructions for the
+    interpreter of Model_Expression.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef EXPRESSION_PROGRAM_HPP
+#define EXPRESSION_PROGRAM_HPP
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint16_t, uint32_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+namespace GILES
+{
+namespace Internal
+{
+//! @class Expression_Program
+//! @brief A leakage model written in the expression language, compiled into a
+//! flat list of instructions for a register machine. Each register holds a
+//! column of values, one for every clock cycle of a block, and each
+//! instruction is carried out for the whole block at once. The cost of
+//! interpreting an instruction is therefore paid once per block rather than
+//! once per clock cycle, and the loop over the block is left for the compiler
+//! to vectorise.
+//!
+//! A model is a list of assignments, each ending with a semicolon. The model
+//! must assign the leakage of a clock cycle to "leakage", e.g.
+//! @code
+//! # The bits that flip between the first operands of two instructions.
+//! flips = op1 ^ prev.op1;
+//! leakage = constant * (bits("Operand1", op1) + 0.5 * hw(flips));
+//! @endcode
+//! Every value is either an integer of 32 bits or a real number.
+//! - op1, op2 are the operands of the instruction in the "Execute" pipeline
+//! stage, and prev.op1, prev.op2, next.op1 and next.op2 are those of the
+//! previous and next clock cycles. These are integers.
+//! - Integer literals, in decimal or hexadecimal, and real literals.
+//! - ~, &, ^ and | work on integers. +, -, * and / work on real numbers and
+//! integers are converted into real numbers when they are used by them.
+//! - hw(x) and hd(x, y) are the Hamming weight of x and the Hamming distance
+//! between x and y.
+//! - bits("Term", x) adds up the coefficients of the interaction term "Term"
+//! of each bit that is set in x. pairs("Term", x) does the same for every
+//! pair of bits, as the Power model does for the "_Bit_Interactions" terms.
+//! - coefficient("Term", prev) and coefficient("Term", next) are the
+//! coefficients of "Term" that are chosen by the category of the previous or
+//! next instruction, as "Previous_Instruction" is.
+//! - constant is the constant of the category of the instruction.
+//! Coefficients are those of the category of the instruction in the
+//! "Execute" pipeline stage. Clock cycles that are stalled or flushed, and
+//! the clock cycles before the first and after the last, have no
+//! instruction. Their operands are zero and their coefficients are those of
+//! an instruction that was not profiled, which are all zero.
+//! Anything following a # on a line is a comment.
+class Expression_Program
+{
+public:
+    //! The operations carried out by the instructions.
+    enum class Operation : std::uint8_t
+    {
+        Load_Integer,    //!< Integer register = Argument.
+        Load_Real,       //!< Real register = Get_Reals()[Argument].
+        Load_Constant,   //!< Real register = the constant.
+        To_Real,         //!< Real register = integer register.
+        Not,             //!< Integer register = ~integer register.
+        And,             //!< Integer register = integer & integer.
+        Xor,             //!< Integer register = integer ^ integer.
+        Or,              //!< Integer register = integer | integer.
+        Negate,          //!< Real register = -real register.
+        Add,             //!< Real register = real + real.
+        Subtract,        //!< Real register = real - real.
+        Multiply,        //!< Real register = real * real.
+        Divide,          //!< Real register = real / real.
+        Hamming_Weight,  //!< Real register = hw(integer register).
+        Weigh_Bits,      //!< Real register = bits(Argument, integer).
+        Weigh_Bit_Pairs, //!< Real register = pairs(Argument, integer).
+        Coefficient      //!< Real register = Get_Coefficients()[Argument].
+    };
+
+    //! @brief A single instruction. Registers are numbered separately for
+    //! integers and for real numbers, and which is used by each operand is
+    //! given by the Operation.
+    struct Instruction
+    {
+        Operation Op;
+
+        //! The register that receives the result.
+        std::uint16_t Destination;
+
+        //! The registers that are read, if any.
+        std::uint16_t Source_1;
+        std::uint16_t Source_2;
+
+        //! An integer literal, or the index of a real literal, term or
+        //! coefficient, depending on the Operation.
+        std::uint32_t Argument;
+    };
+
+    //! The instructions that the targets of coefficients are chosen from.
+    enum class Target : std::uint8_t
+    {
+        Previous,
+        Next
+    };
+
+    //! @brief A coefficient of an interaction term that is chosen by the
+    //! category of another instruction.
+    struct Coefficient_Reference
+    {
+        //! The index of the term within Get_Terms().
+        std::uint32_t Term;
+
+        Target Of;
+    };
+
+    //! The integer registers that hold the operands of the instructions of
+    //! every clock cycle of a block before the first instruction is carried
+    //! out. These are op1, op2, prev.op1, prev.op2, next.op1 and next.op2.
+    static constexpr std::size_t number_of_operand_registers{6};
+
+private:
+    std::vector<Instruction> m_instructions{};
+
+    //! The real literals, indexed by the Argument of Load_Real.
+    std::vector<double> m_reals{};
+
+    //! The names of the interaction terms used, indexed by the Argument of
+    //! Weigh_Bits and Weigh_Bit_Pairs.
+    std::vector<std::string> m_terms{};
+
+    //! The coefficients used, indexed by the Argument of Coefficient.
+    std::vector<Coefficient_Reference> m_coefficients{};
+
+    std::size_t m_number_of_integer_registers{number_of_operand_registers};
+    std::size_t m_number_of_real_registers{0};
+
+    //! The real register that holds the leakage once every instruction has
+    //! been carried out.
+    std::uint16_t m_result{0};
+
+    //! Whether the constant of the category of the instruction is used.
+    bool m_uses_constant{false};
+
+    class Compiler;
+
+    Expression_Program() = default;
+
+public:
+    static Expression_Program Compile(const std::string& p_source);
+
+    //! @brief Retrieves the instructions, in the order that they are carried
+    //! out.
+    //! @returns The instructions.
+    const std::vector<Instruction>& Get_Instructions() const noexcept
+    {
+        return m_instructions;
+    }
+
+    //! @brief Retrieves the real literals used by Load_Real.
+    //! @returns The literals.
+    const std::vector<double>& Get_Reals() const noexcept { return m_reals; }
+
+    //! @brief Retrieves the names of the interaction terms used.
+    //! @returns The names of the terms.
+    const std::vector<std::string>& Get_Terms() const noexcept
+    {
+        return m_terms;
+    }
+
+    //! @brief Retrieves the coefficients that are chosen by the category of
+    //! another instruction.
+    //! @returns The coefficients.
+    const std::vector<Coefficient_Reference>& Get_Coefficients() const noexcept
+    {
+        return m_coefficients;
+    }
+
+    //! @brief Retrieves the number of integer registers, including those of
+    //! the operands.
+    //! @returns The number of registers.
+    std::size_t Get_Integer_Register_Count() const noexcept
+    {
+        return m_number_of_integer_registers;
+    }
+
+    //! @brief Retrieves the number of real registers.
+    //! @returns The number of registers.
+    std::size_t Get_Real_Register_Count() const noexcept
+    {
+        return m_number_of_real_registers;
+    }
+
+    //! @brief Retrieves the real register that holds the leakage.
+    //! @returns The register.
+    std::uint16_t Get_Result() const noexcept { return m_result; }
+
+    //! @brief Checks whether the constant of the category of the instruction
+    //! is used.
+    //! @returns True if it is used, false if not.
+    bool Uses_Constant() const noexcept { return m_uses_constant; }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
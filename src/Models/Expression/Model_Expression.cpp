@@ -0,0 +1,625 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Model_Expression.cpp
+    @brief Contains the interpreter of the expression language.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include "Model_Expression.hpp"
+
+#include <algorithm>      // for min
+#include <array>          // for array
+#include <cmath>          // for isnan
+#include <cstdint>        // for uint32_t
+#include <fstream>        // for ifstream
+#include <iterator>       // for istreambuf_iterator
+#include <optional>       // for nullopt
+#include <stdexcept>      // for invalid_argument
+#include <string>         // for string
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for move
+#include <vector>         // for vector
+
+#include "Coefficients.hpp"  // for Coefficients
+#include "Error.hpp"         // for Report_Error
+
+//! The data used by every program. Only the "Execute" pipeline stage is read.
+//! Any register may be named by the operands of an instruction so every
+//! register is required.
+const GILES::Internal::Data_Requirements
+    GILES::Internal::Model_Expression::m_data_requirements{
+        std::unordered_set<std::string>{"Execute"}, std::nullopt, false};
+
+//! @brief Constructs a Model that generates the Traces of p_execution using
+//! p_program. Every interaction term that the program uses must be in the
+//! Coefficients.
+//! @param p_execution The recorded Execution of the target program.
+//! @param p_coefficients The Coefficients.
+//! @param p_program The compiled program.
+GILES::Internal::Model_Expression::Model_Expression(
+    std::shared_ptr<const Execution> p_execution,
+    const Coefficients& p_coefficients,
+    std::shared_ptr<const Expression_Program> p_program)
+    : Model{std::move(p_execution), p_coefficients},
+      m_program{std::move(p_program)},
+      m_execute{m_execution.Get_Stage_Handle("Execute")},
+      m_compiled{m_coefficients.Get_Compiled()},
+      m_kernels{Model_Kernels::Get()}, m_terms{resolve_terms()},
+      m_categories{resolve_categories()}, m_constants{resolve_constants()},
+      m_target_slots{resolve_target_slots()}
+{
+}
+
+//! @brief Looks up the ID of every term used by the program and checks that
+//! it is used in the way that it is stored. The terms weighed by bits() and
+//! pairs() must be lists and those used by coefficient() must not be.
+//! @returns The ID of each term, in the order of
+//! Expression_Program::Get_Terms().
+std::pmr::vector<GILES::Internal::Compiled_Coefficients::Term_ID>
+GILES::Internal::Model_Expression::resolve_terms() const
+{
+    const auto& names = m_program->Get_Terms();
+    std::pmr::vector<Compiled_Coefficients::Term_ID> terms{
+        m_execution.Get_Memory_Resource()};
+    terms.reserve(names.size());
+    for (const auto& name : names)
+    {
+        const auto term = m_compiled.Find_Term(name);
+        if (Compiled_Coefficients::no_term == term)
+        {
+            Error::Report_Error("The interaction term '{}' is used by the "
+                                "expression but is not in the Coefficients",
+                                name);
+        }
+        terms.push_back(term);
+    }
+
+    for (const auto& instruction : m_program->Get_Instructions())
+    {
+        if (Expression_Program::Operation::Weigh_Bits == instruction.Op ||
+            Expression_Program::Operation::Weigh_Bit_Pairs == instruction.Op)
+        {
+            if (!m_compiled.Is_List(terms[instruction.Argument]))
+            {
+                Error::Report_Error(
+                    "The interaction term '{}' is not a list of coefficients "
+                    "so its bits cannot be weighed",
+                    names[instruction.Argument]);
+            }
+        }
+        else if (Expression_Program::Operation::Coefficient == instruction.Op)
+        {
+            const auto term =
+                m_program->Get_Coefficients()[instruction.Argument].Term;
+            if (m_compiled.Is_List(terms[term]))
+            {
+                Error::Report_Error("The interaction term '{}' is a list of "
+                                    "coefficients so it cannot be chosen by "
+                                    "the category of another instruction",
+                                    names[term]);
+            }
+        }
+    }
+    return terms;
+}
+
+//! @brief Resolves the category of every opcode in the Execution. The bits
+//! of every list term used by the program are checked for each of them.
+//! @returns The category of each opcode, indexed by its opcode ID and
+//! followed by the unprofiled category, which is used for clock cycles with
+//! no instruction.
+std::pmr::vector<GILES::Internal::Compiled_Coefficients::Category_ID>
+GILES::Internal::Model_Expression::resolve_categories() const
+{
+    const std::size_t number_of_opcodes{m_execution.Get_Opcode_Count()};
+    std::pmr::vector<Compiled_Coefficients::Category_ID> categories{
+        m_execution.Get_Memory_Resource()};
+    categories.reserve(number_of_opcodes + 1);
+
+    for (std::uint32_t id{0}; id < number_of_opcodes; ++id)
+    {
+        auto category = m_compiled.Find_Category(m_execution.Get_Opcode(id));
+        if (Compiled_Coefficients::no_category == category)
+        {
+            category = m_compiled.Get_Unprofiled();
+        }
+        categories.push_back(category);
+
+        for (std::uint32_t term{0}; term < m_terms.size(); ++term)
+        {
+            if (m_compiled.Is_List(m_terms[term]) &&
+                std::isnan(m_compiled.Get_Values(category, m_terms[term])[0]))
+            {
+                Error::Report_Error(
+                    "The interaction term '{}' is used by the expression but "
+                    "is not in the Coefficients of '{}'",
+                    m_program->Get_Terms()[term],
+                    m_execution.Get_Opcode(id));
+            }
+        }
+    }
+    categories.push_back(m_compiled.Get_Unprofiled());
+    return categories;
+}
+
+//! @brief Resolves the constant of every opcode in the Execution, if the
+//! program uses it.
+//! @returns The constant of each opcode, in the same order as m_categories,
+//! or nothing if the program does not use it.
+std::pmr::vector<double>
+GILES::Internal::Model_Expression::resolve_constants() const
+{
+    std::pmr::vector<double> constants{m_execution.Get_Memory_Resource()};
+    if (!m_program->Uses_Constant())
+    {
+        return constants;
+    }
+
+    constants.reserve(m_categories.size());
+    for (std::size_t id{0}; id < m_categories.size(); ++id)
+    {
+        const double constant{m_compiled.Get_Constant(m_categories[id])};
+        if (std::isnan(constant))
+        {
+            Error::Report_Error("The Coefficients have no constant for '{}'",
+                                m_execution.Get_Opcode(
+                                    static_cast<std::uint32_t>(id)));
+        }
+        constants.push_back(constant);
+    }
+    return constants;
+}
+
+//! @brief Resolves the slot of every opcode in the Execution when it is the
+//! target of each coefficient of the program. The slot of a target is that
+//! of the name of its category. Instructions that were not profiled, and
+//! clock cycles with no instruction, have no slot.
+//! @returns The slots, as described by m_target_slots.
+std::pmr::vector<std::size_t>
+GILES::Internal::Model_Expression::resolve_target_slots() const
+{
+    const auto& coefficients = m_program->Get_Coefficients();
+    std::pmr::vector<std::size_t> slots{m_execution.Get_Memory_Resource()};
+    slots.reserve(coefficients.size() * m_categories.size());
+    for (const auto& coefficient : coefficients)
+    {
+        for (const auto category : m_categories)
+        {
+            slots.push_back(
+                m_compiled.Get_Unprofiled() == category
+                    ? Compiled_Coefficients::no_slot
+                    : m_compiled.Find_Slot(
+                          m_terms[coefficient.Term],
+                          m_compiled.Get_Category_Name(category)));
+        }
+    }
+    return slots;
+}
+
+//! @brief Reports that a coefficient chosen by the category of another
+//! instruction is missing from the Coefficients and stops execution.
+//! @param p_opcode The opcode ID of the instruction that the coefficient is
+//! needed for.
+//! @param p_term The index of the term within the terms of the program.
+void GILES::Internal::Model_Expression::report_missing_coefficient(
+    const std::uint32_t p_opcode, const std::uint32_t p_term) const
+{
+    Error::Report_Error(
+        "The interaction term '{}' is used by the expression but is not in "
+        "the Coefficients of '{}'",
+        m_program->Get_Terms()[p_term],
+        p_opcode < m_execution.Get_Opcode_Count()
+            ? m_execution.Get_Opcode(p_opcode)
+            : "an instruction that was not profiled");
+}
+
+//! @brief Generates the Traces by interpreting the program, one sample for
+//! every clock cycle.
+//! The operands of the current, previous and next instruction of every clock
+//! cycle of a block are read into the first integer registers and each
+//! instruction of the program is then carried out for the whole block before
+//! moving on to the next. Nothing is allocated for each clock cycle.
+//! @returns The generated Traces for the target program.
+const std::vector<float> GILES::Internal::Model_Expression::Generate_Traces()
+{
+    using Operation = Expression_Program::Operation;
+
+    const auto& program = *m_program;
+    const std::size_t size{m_execution.Get_Cycle_Count()};
+    std::vector<float> traces(size);
+
+    // The registers, each of which holds a column of block_size values.
+    std::vector<std::uint32_t> integers(
+        program.Get_Integer_Register_Count() * block_size);
+    std::vector<double> reals(program.Get_Real_Register_Count() * block_size);
+    const auto integer = [&integers](const std::uint16_t p_register) {
+        return integers.data() + p_register * block_size;
+    };
+    const auto real = [&reals](const std::uint16_t p_register) {
+        return reals.data() + p_register * block_size;
+    };
+
+    // The opcode ID and operands of the clock cycle before a block, every
+    // clock cycle of the block and the clock cycle after it. Clock cycles
+    // with no instruction are given the last opcode ID.
+    const auto no_instruction =
+        static_cast<std::uint32_t>(m_categories.size() - 1);
+    std::array<std::uint32_t, block_size + 2> opcodes;
+    std::array<std::uint32_t, block_size + 2> operands_1;
+    std::array<std::uint32_t, block_size + 2> operands_2;
+    opcodes.fill(no_instruction);
+    operands_1.fill(0);
+    operands_2.fill(0);
+
+    // The cycles are visited in order so a cursor is the cheapest way to
+    // retrieve the registers.
+    auto registers   = m_execution.Get_Register_Cursor();
+    const auto read = [&](const std::size_t p_cycle,
+                          const std::size_t p_index) {
+        if (size <= p_cycle ||
+            !m_execution.Is_Normal_State_Unsafe(p_cycle, m_execute))
+        {
+            opcodes[p_index]    = no_instruction;
+            operands_1[p_index] = 0;
+            operands_2[p_index] = 0;
+            return;
+        }
+        const auto& instruction =
+            m_execution.Get_Decoded_Instruction(p_cycle, m_execute);
+        opcodes[p_index]    = instruction.Opcode;
+        operands_1[p_index] = static_cast<std::uint32_t>(
+            m_execution.Get_Operand_Value(registers, p_cycle, instruction, 1));
+        operands_2[p_index] = static_cast<std::uint32_t>(
+            m_execution.Get_Operand_Value(registers, p_cycle, instruction, 2));
+    };
+    read(0, 1);
+
+    for (std::size_t first{0}; first < size; first += block_size)
+    {
+        const std::size_t count{std::min(block_size, size - first)};
+
+        // Entry j + 1 is clock cycle first + j. The first two entries were
+        // read by the previous block.
+        for (std::size_t j{1}; j <= count; ++j)
+        {
+            read(first + j, j + 1);
+        }
+
+        for (std::size_t j{0}; j < count; ++j)
+        {
+            integer(0)[j] = operands_1[j + 1];
+            integer(1)[j] = operands_2[j + 1];
+            integer(2)[j] = operands_1[j];
+            integer(3)[j] = operands_2[j];
+            integer(4)[j] = operands_1[j + 2];
+            integer(5)[j] = operands_2[j + 2];
+        }
+
+        for (const auto& instruction : program.Get_Instructions())
+        {
+            const auto argument = instruction.Argument;
+            switch (instruction.Op)
+            {
+            case Operation::Load_Integer:
+            {
+                std::uint32_t* const destination{
+                    integer(instruction.Destination)};
+                std::fill(destination, destination + count, argument);
+                break;
+            }
+            case Operation::Load_Real:
+            {
+                double* const destination{real(instruction.Destination)};
+                std::fill(destination,
+                          destination + count,
+                          program.Get_Reals()[argument]);
+                break;
+            }
+            case Operation::Load_Constant:
+            {
+                double* const destination{real(instruction.Destination)};
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = m_constants[opcodes[j + 1]];
+                }
+                break;
+            }
+            case Operation::To_Real:
+            {
+                double* const destination{real(instruction.Destination)};
+                const std::uint32_t* const source{
+                    integer(instruction.Source_1)};
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = source[j];
+                }
+                break;
+            }
+            case Operation::Not:
+            {
+                std::uint32_t* const destination{
+                    integer(instruction.Destination)};
+                const std::uint32_t* const source{
+                    integer(instruction.Source_1)};
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = ~source[j];
+                }
+                break;
+            }
+            case Operation::And:
+            case Operation::Xor:
+            case Operation::Or:
+            {
+                std::uint32_t* const destination{
+                    integer(instruction.Destination)};
+                const std::uint32_t* const left{integer(instruction.Source_1)};
+                const std::uint32_t* const right{
+                    integer(instruction.Source_2)};
+                if (Operation::And == instruction.Op)
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] & right[j];
+                    }
+                }
+                else if (Operation::Xor == instruction.Op)
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] ^ right[j];
+                    }
+                }
+                else
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] | right[j];
+                    }
+                }
+                break;
+            }
+            case Operation::Negate:
+            {
+                double* const destination{real(instruction.Destination)};
+                const double* const source{real(instruction.Source_1)};
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = -source[j];
+                }
+                break;
+            }
+            case Operation::Add:
+            case Operation::Subtract:
+            case Operation::Multiply:
+            case Operation::Divide:
+            {
+                double* const destination{real(instruction.Destination)};
+                const double* const left{real(instruction.Source_1)};
+                const double* const right{real(instruction.Source_2)};
+                if (Operation::Add == instruction.Op)
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] + right[j];
+                    }
+                }
+                else if (Operation::Subtract == instruction.Op)
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] - right[j];
+                    }
+                }
+                else if (Operation::Multiply == instruction.Op)
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] * right[j];
+                    }
+                }
+                else
+                {
+                    for (std::size_t j{0}; j < count; ++j)
+                    {
+                        destination[j] = left[j] / right[j];
+                    }
+                }
+                break;
+            }
+            case Operation::Hamming_Weight:
+            {
+                // The weights are calculated by the kernels into a
+                // spare column and then converted.
+                std::array<std::uint32_t, block_size> weights;
+                m_kernels.Hamming_Weights(
+                    integer(instruction.Source_1), weights.data(), count);
+                double* const destination{real(instruction.Destination)};
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = weights[j];
+                }
+                break;
+            }
+            case Operation::Weigh_Bits:
+            {
+                double* const destination{real(instruction.Destination)};
+                const std::uint32_t* const source{
+                    integer(instruction.Source_1)};
+                const auto term = m_terms[argument];
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = m_compiled.Weigh_Bits(
+                        m_categories[opcodes[j + 1]], term, source[j]);
+                }
+                break;
+            }
+            case Operation::Weigh_Bit_Pairs:
+            {
+                double* const destination{real(instruction.Destination)};
+                const std::uint32_t* const source{
+                    integer(instruction.Source_1)};
+                const auto term = m_terms[argument];
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    destination[j] = m_compiled.Weigh_Bit_Pairs(
+                        m_categories[opcodes[j + 1]], term, source[j]);
+                }
+                break;
+            }
+            case Operation::Coefficient:
+            {
+                double* const destination{real(instruction.Destination)};
+                const auto& coefficient =
+                    program.Get_Coefficients()[argument];
+                const auto term = m_terms[coefficient.Term];
+                const std::size_t* const slots{m_target_slots.data() +
+                                               argument * m_categories.size()};
+                // The previous or next instruction of entry j + 1.
+                const std::size_t target{
+                    Expression_Program::Target::Previous == coefficient.Of
+                        ? std::size_t{0}
+                        : std::size_t{2}};
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    const auto slot = slots[opcodes[j + target]];
+                    if (Compiled_Coefficients::no_slot == slot)
+                    {
+                        destination[j] = 0;
+                        continue;
+                    }
+                    destination[j] = m_compiled.Get_Value(
+                        m_categories[opcodes[j + 1]], term, slot);
+                    if (std::isnan(destination[j]))
+                    {
+                        report_missing_coefficient(opcodes[j + 1],
+                                                   coefficient.Term);
+                    }
+                }
+                break;
+            }
+            }
+        }
+
+        const double* const result{real(program.Get_Result())};
+        for (std::size_t j{0}; j < count; ++j)
+        {
+            traces[first + j] = static_cast<float>(result[j]);
+        }
+
+        // The last two entries are the first two of the next block.
+        opcodes[0]    = opcodes[count];
+        operands_1[0] = operands_1[count];
+        operands_2[0] = operands_2[count];
+        opcodes[1]    = opcodes[count + 1];
+        operands_1[1] = operands_1[count + 1];
+        operands_2[1] = operands_2[count + 1];
+    }
+    return traces;
+}
+
+//! @brief Generates the Traces of a batch of Executions one at a time, using
+//! the same program.
+//! @copydetails Model::Generate_Batch_Traces()
+std::vector<std::vector<float>>
+GILES::Internal::Model_Expression::Generate_Batch_Traces(
+    const std::vector<std::shared_ptr<const Execution>>& p_executions)
+{
+    std::vector<std::vector<float>> traces;
+    traces.reserve(p_executions.size() + 1);
+    traces.emplace_back(Generate_Traces());
+    for (const auto& execution : p_executions)
+    {
+        traces.emplace_back(
+            Model_Expression{execution, m_coefficients, m_program}
+                .Generate_Traces());
+    }
+    return traces;
+}
+
+//! @brief Compiles a model written in the expression language and registers
+//! it in the factory, along with its Data_Requirements, under the name given
+//! by p_model_name. If the model cannot be compiled, or the name is already
+//! in use, then an error message will be reported and execution will halt.
+//! @param p_model_name The name of the Model.
+//! @param p_source The source of the model.
+//! @see Expression_Program
+void GILES::Internal::Model_Expression::Register(
+    const std::string& p_model_name, const std::string& p_source)
+{
+    std::shared_ptr<const Expression_Program> program;
+    try
+    {
+        program = std::make_shared<const Expression_Program>(
+            Expression_Program::Compile(p_source));
+    }
+    catch (const std::invalid_argument& error)
+    {
+        Error::Report_Error("The model '{}' could not be compiled.\n{}",
+                            p_model_name,
+                            error.what());
+    }
+
+    // Each Model is constructed with the program that it was registered
+    // with.
+    const auto construct =
+        [program = std::move(program)](
+            std::shared_ptr<const Execution> p_execution,
+            const Coefficients& p_coefficients) -> std::unique_ptr<Model> {
+        return std::make_unique<Model_Expression>(
+            std::move(p_execution), p_coefficients, program);
+    };
+    if (!Model_Factory::Register(p_model_name, construct))
+    {
+        Error::Report_Error("There is already a model named '{}'",
+                            p_model_name);
+    }
+    register_data_requirements(p_model_name, Get_Data_Requirements);
+}
+
+//! @brief Loads a model written in the expression language from the file
+//! given by p_path and registers it using Register(). The Model is named
+//! after the file, without its directory or extension, e.g. "HD" for
+//! "models/HD.expr".
+//! @param p_path The path to the file.
+//! @returns The name of the Model.
+std::string GILES::Internal::Model_Expression::Load(const std::string& p_path)
+{
+    std::ifstream file{p_path, std::ios::binary};
+    if (!file.is_open())
+    {
+        Error::Report_Error("Could not open the model '{}'", p_path);
+    }
+    const std::string source{std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>()};
+
+    const auto directory = p_path.find_last_of('/');
+    auto name            = p_path.substr(
+        std::string::npos == directory ? 0 : directory + 1);
+    if (const auto extension = name.rfind('.');
+        std::string::npos != extension && 0 != extension)
+    {
+        name.erase(extension);
+    }
+
+    Register(name, source);
+    return name;
+}
@@ -0,0 +1,141 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Model_Expression.hpp
+    @brief Contains a model that runs a leakage model written in the
+    expression language, which is loaded while GILES is running rather than
+    compiled into it.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef MODEL_EXPRESSION_HPP
+#define MODEL_EXPRESSION_HPP
+
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint32_t
+#include <memory>           // for shared_ptr, unique_ptr
+#include <memory_resource>  // for vector
+#include <string>           // for string
+#include <utility>          // for move
+#include <vector>           // for vector
+
+#include "Abstract_Factory.hpp"       // for Model_Factory
+#include "Compiled_Coefficients.hpp"  // for Compiled_Coefficients
+#include "Execution.hpp"              // for Execution
+#include "Expression_Program.hpp"     // for Expression_Program
+#include "Model.hpp"                  // for Model
+#include "Model_Kernels.hpp"          // for Model_Kernels
+
+namespace GILES
+{
+namespace Internal
+{
+// Forward Declarations
+class Coefficients;
+
+//! @class Model_Expression
+//! @brief A model whose leakage is given by an Expression_Program, so that new
+//! models can be written and ran without rebuilding GILES. Each program is
+//! registered in the factory under its own name, using Register() or Load(),
+//! and can then be used like any other Model.
+//! The program is interpreted a block of clock cycles at a time. The
+//! operands of the block are read into columns first and each instruction is
+//! then carried out for every clock cycle of the block, so the interpreter
+//! spends most of its time in tight loops.
+//! This derives from Model directly, rather than from Model_Interface, as
+//! there is a Model for every program rather than one for the class.
+class Model_Expression : public Model
+{
+private:
+    //! The number of clock cycles that each instruction is carried out for
+    //! at a time.
+    static constexpr std::size_t block_size{64};
+
+    static const Data_Requirements m_data_requirements;
+
+    //! The program that gives the leakage.
+    const std::shared_ptr<const Expression_Program> m_program;
+
+    //! The "Execute" pipeline stage, looked up once on construction.
+    const Execution::Stage_Handle m_execute;
+
+    //! The Coefficients compiled into a table.
+    const Compiled_Coefficients& m_compiled;
+
+    //! The kernels used for the level of instruction set supported by
+    //! the CPU.
+    const Model_Kernels::Implementation& m_kernels;
+
+    //! The ID of each term used by the program within m_compiled.
+    const std::pmr::vector<Compiled_Coefficients::Term_ID> m_terms;
+
+    //! The category of every opcode in the Execution, indexed by its opcode
+    //! ID and followed by that of clock cycles with no instruction.
+    const std::pmr::vector<Compiled_Coefficients::Category_ID> m_categories;
+
+    //! The constant of every opcode, in the same order as m_categories, if
+    //! the program uses it.
+    const std::pmr::vector<double> m_constants;
+
+    //! The slot of every opcode when it is the target of each of the
+    //! coefficients of the program. The slots of each coefficient follow
+    //! those of the one before it, in the same order as m_categories.
+    const std::pmr::vector<std::size_t> m_target_slots;
+
+    std::pmr::vector<Compiled_Coefficients::Term_ID> resolve_terms() const;
+
+    std::pmr::vector<Compiled_Coefficients::Category_ID>
+    resolve_categories() const;
+
+    std::pmr::vector<double> resolve_constants() const;
+
+    std::pmr::vector<std::size_t> resolve_target_slots() const;
+
+    [[noreturn]] void report_missing_coefficient(std::uint32_t p_opcode,
+                                                 std::uint32_t p_term) const;
+
+public:
+    Model_Expression(std::shared_ptr<const Execution> p_execution,
+                     const Coefficients& p_coefficients,
+                     std::shared_ptr<const Expression_Program> p_program);
+
+    const std::vector<float> Generate_Traces() override;
+
+    std::vector<std::vector<float>> Generate_Batch_Traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions)
+        override;
+
+    static void Register(const std::string& p_model_name,
+                         const std::string& p_source);
+
+    static std::string Load(const std::string& p_path);
+
+    //! @brief Retrieves the data recorded by the Emulator that is used by
+    //! every program. The Emulator does not need to record anything else.
+    //! @returns The data required by the model.
+    static const Data_Requirements& Get_Data_Requirements()
+    {
+        return m_data_requirements;
+    }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
@@ -25,19 +25,26 @@
     @copyright GNU Affero General Public License Version 3+
 */
 
-#include <cstddef>  // for uint8_t, size_t
-#include <vector>   // for vector
+#include <cstddef>   // for uint8_t, size_t
+#include <optional>  // for nullopt
+#include <vector>    // for vector
 
 #include "Model_Hamming_Weight.hpp"
 
-#include "Assembly_Instruction.hpp"  // for Assembly_Instruction
-#include "Execution.hpp"             // for Execution
+#include "Execution.hpp"  // for Execution
 
 //! The list of interaction terms used by this model in order to generate
 //! traces.
 const std::unordered_set<std::string>
     GILES::Internal::Model_Hamming_Weight::m_required_interaction_terms{};
 
+//! The data used by this model. Only the "Execute" pipeline stage is read. Any
+//! register may be named by the first operand of an instruction so every
+//! register is required.
+const GILES::Internal::Data_Requirements
+    GILES::Internal::Model_Hamming_Weight::m_data_requirements{
+        std::unordered_set<std::string>{"Execute"}, std::nullopt, false};
+
 //! @brief This function contains the mathematical calculations that generate
 //! the Traces.
 //! @returns The generated Traces for the target program.
@@ -47,11 +54,18 @@ GILES::Internal::Model_Hamming_Weight::Generate_Traces()
     std::vector<float> traces;
 
     const std::size_t number_of_cycles{m_execution.Get_Cycle_Count()};
+
+    // Look up the pipeline stage once rather than by name every cycle.
+    const auto execute = m_execution.Get_Stage_Handle("Execute");
+
+    // The cycles are visited in order so a cursor is the cheapest way to
+    // retrieve the registers.
+    auto registers = m_execution.Get_Register_Cursor();
     for (std::size_t i{0}; i < number_of_cycles; ++i)
     {
         // Prevents trying to calculate the hamming weight of stalls and
         // flushes.
-        if (!m_execution.Is_Normal_State(i, "Execute"))
+        if (!m_execution.Is_Normal_State(i, execute))
         {
             // In the case of stalls and flushes just assume these use no power
             // for now.
@@ -63,7 +77,10 @@ GILES::Internal::Model_Hamming_Weight::Generate_Traces()
         // at clock cycle 'i' and appends it to the traces object.
         traces.push_back(
             Model_Math::Hamming_Weight(m_execution.Get_Operand_Value(
-                i, m_execution.Get_Instruction(i, "Execute"), 1)));
+                registers,
+                i,
+                m_execution.Get_Decoded_Instruction(i, execute),
+                1)));
     }
     return traces;
 }
@@ -33,8 +33,10 @@
 #define MODEL_HAMMING_WEIGHT_HPP
 
 #include <cstdint>        // for size_t
+#include <memory>         // for shared_ptr
 #include <string>         // for string
 #include <unordered_set>  // for unordered_set
+#include <utility>        // for move
 #include <vector>         // for vector
 
 #include "Model.hpp"  // for Model_Interface, Hamming_Weight
@@ -58,13 +60,15 @@ class Model_Hamming_Weight
 {
 private:
     static const std::unordered_set<std::string> m_required_interaction_terms;
+    static const Data_Requirements m_data_requirements;
 
 public:
     //! @brief The constructor makes use of the base Model constructor to assist
     //! with initialisation of private member variables.
-    Model_Hamming_Weight(const Execution& p_execution,
+    Model_Hamming_Weight(std::shared_ptr<const Execution> p_execution,
                          const Coefficients& p_coefficients)
-        : Model_Interface<Model_Hamming_Weight>(p_execution, p_coefficients)
+        : Model_Interface<Model_Hamming_Weight>(std::move(p_execution),
+                                                p_coefficients)
     {
     }
 
@@ -79,6 +83,14 @@ public:
         return m_required_interaction_terms;
     }
 
+    //! @brief Retrieves the data recorded by the Emulator that is used
+    //! within the model. The Emulator does not need to record anything else.
+    //! @returns The data required by the model.
+    static const Data_Requirements& Get_Data_Requirements()
+    {
+        return m_data_requirements;
+    }
+
     //! @brief Retrieves the name of this Model.
     //! @returns The name as a string.
     //! @note This is needed to ensure self registration in the factory works.
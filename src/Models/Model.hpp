@@ -28,13 +28,18 @@
 #define MODEL_HPP
 
 #include <algorithm>      // for all_of
+#include <cstdint>        // for uint64_t
+#include <memory>         // for shared_ptr
 #include <string>         // for string
+#include <unordered_map>  // for unordered_map
 #include <unordered_set>  // for unordered_set
+#include <utility>        // for move
 #include <vector>         // for vector
 
 #include "Abstract_Factory_Register.hpp"  // for Model_Factory_Register
 #include "Coefficients.hpp"
-#include "Error.hpp"  // for Report_Error
+#include "Data_Requirements.hpp"  // for Data_Requirements
+#include "Error.hpp"              // for Report_Error
 #include "Execution.hpp"
 #include "Model_Math.hpp"
 
@@ -51,24 +56,151 @@ namespace Internal
 //! non-templated base class to allow handling of derived objects.
 class Model
 {
+private:
+    //! Keeps the execution of the target program alive for as long as the
+    //! Model exists. The Execution is immutable and so it is shared between
+    //! every Model that makes use of it rather than being copied.
+    const std::shared_ptr<const Execution> m_shared_execution;
+
 protected:
     //! The execution of the target program as recorded by the Emulator.
-    const Execution m_execution;
+    const Execution& m_execution;
 
     //! The Coefficients created by measuring real hardware traces.
     const Coefficients& m_coefficients;
 
-    Model(const Execution& p_execution, const Coefficients& p_coefficients)
-        : m_execution(p_execution), m_coefficients(p_coefficients)
+    Model(std::shared_ptr<const Execution> p_execution,
+          const Coefficients& p_coefficients)
+        : m_shared_execution(std::move(p_execution)),
+          m_execution(*m_shared_execution), m_coefficients(p_coefficients)
+    {
+    }
+
+    //! A function pointer used to point to the function that retrieves the
+    //! Data_Requirements of a Model.
+    using Data_Requirements_Function = const Data_Requirements& (*)();
+
+    //! @brief Retrieves the functions that return the Data_Requirements of
+    //! every Model, indexed by the name of the Model.
+    //! @returns The unordered_map containing the functions.
+    //! @note The functions are stored rather than the Data_Requirements
+    //! themselves as the Data_Requirements are static members of the derived
+    //! classes which may not have been initialised yet during registration.
+    //! @see https://isocpp.org/wiki/faq/ctors#static-init-order-on-first-use
+    static std::unordered_map<std::string, Data_Requirements_Function>&
+    get_all_data_requirements()
     {
+        static std::unordered_map<std::string, Data_Requirements_Function> all;
+        return all;
+    }
+
+    //! @brief Registers the function that retrieves the Data_Requirements of
+    //! the Model given by p_model_name. This is called automatically by
+    //! Model_Interface.
+    //! @param p_model_name The name of the Model.
+    //! @param p_function The function that retrieves the Data_Requirements.
+    //! @returns True if the Model was not already registered, false if it was.
+    static bool
+    register_data_requirements(const std::string& p_model_name,
+                               const Data_Requirements_Function p_function)
+    {
+        return get_all_data_requirements()
+            .emplace(p_model_name, p_function)
+            .second;
     }
 
 public:
+    //! @brief Retrieves the data that the Model given by p_model_name makes
+    //! use of. This allows the Emulator to be told what to record before the
+    //! Model is constructed.
+    //! If a Model with the given name is not found then an error message will
+    //! be reported and execution will halt.
+    //! @param p_model_name The name of the Model.
+    //! @returns The Data_Requirements of the Model.
+    static const Data_Requirements&
+    Get_Data_Requirements(const std::string& p_model_name)
+    {
+        // If p_model_name is registered.
+        if (auto& all = get_all_data_requirements();
+            all.end() != all.find(p_model_name))
+        {
+            return all[p_model_name]();
+        }
+        Error::Report_Error("Could not find '{}'.\n", p_model_name);
+    }
+
     //! @brief In derived classes, this function should contain the
     //! mathematical calculations that generate the Traces.
     //! @returns The generated Traces for the target program.
     virtual const std::vector<float> Generate_Traces() = 0;
 
+    //! @brief Checks whether the Traces of p_execution can be generated in the
+    //! same batch as those of the Execution of this Model, using
+    //! Generate_Batch_Traces(). This is the case when the target program ran
+    //! the same schedule of instructions and only the data differs, as it
+    //! does for constant time code. Models that do not generate batches any
+    //! faster than one trace at a time never share a batch, which is the
+    //! default.
+    //! @param p_execution The other Execution.
+    //! @returns True if the Executions can share a batch, false if not.
+    virtual bool Has_Same_Schedule(const Execution& p_execution) const
+    {
+        (void)p_execution;
+        return false;
+    }
+
+    //! @brief Generates the Traces of the Execution of this Model, followed by
+    //! those of each of p_executions, in a single pass. The Traces are the
+    //! same as those generated by a Model of each Execution in turn.
+    //! @param p_executions The other Executions of the batch. Each of these
+    //! must have the same schedule as the Execution of this Model, as checked
+    //! by Has_Same_Schedule().
+    //! @returns The generated Traces of each Execution, starting with the
+    //! Execution of this Model.
+    virtual std::vector<std::vector<float>> Generate_Batch_Traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions) = 0;
+
+    //! The Traces of each term of a batch of Executions, indexed by the
+    //! Execution, then by the term and then by the clock cycle. The samples of
+    //! each term are contiguous, so that a single term can be read on its
+    //! own.
+    using Term_Traces = std::vector<std::vector<std::vector<float>>>;
+
+    //! @brief Retrieves the names of the terms that every sample of the Traces
+    //! is the sum of, in the order used by Generate_Batch_Term_Traces(). This
+    //! is empty for Models whose Traces cannot be decomposed, which is the
+    //! default.
+    //! @returns The names of the terms.
+    virtual const std::vector<std::string>& Get_Term_Names() const
+    {
+        static const std::vector<std::string> no_terms;
+        return no_terms;
+    }
+
+    //! @brief Generates the same Traces as Generate_Batch_Traces() and, in the
+    //! same pass, the contribution of each term to every sample. This shows
+    //! which of the terms causes a sample to leak without running the Model
+    //! once for each term. By default, this reports an error as the Traces
+    //! cannot be decomposed. Models that can decompose their Traces should
+    //! override this, along with Get_Term_Names().
+    //! @param p_executions The other Executions of the batch, as given to
+    //! Generate_Batch_Traces().
+    //! @param p_term_traces Receives the contribution of each term, named by
+    //! Get_Term_Names(), to every sample of each Execution, starting with the
+    //! Execution of this Model. The contributions of a sample add up to the
+    //! sample, apart from rounding.
+    //! @returns The generated Traces of each Execution, starting with the
+    //! Execution of this Model.
+    virtual std::vector<std::vector<float>> Generate_Batch_Term_Traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions,
+        Term_Traces& p_term_traces)
+    {
+        (void)p_executions;
+        (void)p_term_traces;
+        Error::Report_Error("This Model cannot decompose its Traces into "
+                            "terms.");
+    }
+
     //! @brief Virtual destructor to ensure proper memory cleanup.
     //! @see https://stackoverflow.com/a/461224
     virtual ~Model() = default;
@@ -86,6 +218,13 @@ public:
 template <typename derived_t>
 class Model_Interface : public Model, public Model_Factory_Register<derived_t>
 {
+private:
+    //! This static variable is evaluated before main() is called, registering
+    //! the Data_Requirements of the derived class so that they can be
+    //! retrieved by name using Model::Get_Data_Requirements.
+    //! @see Abstract_Factory_Register::m_is_registered
+    static bool m_data_requirements_registered;
+
 protected:
     //! @brief The constructor needs to be provided with the recorded
     //! Execution of the target program and the details from real world
@@ -93,18 +232,30 @@ protected:
     //! target program. This constructor is marked as protected as it should
     //! only be called by derived classes to assist with initialisation.
     //! @param p_execution The recorded Execution of the target program,
-    //! provided by the Emulator.
+    //! provided by the Emulator. This is shared with the Model, not copied.
     //! @param p_coefficients The loaded Coefficients from real hardware
     //! traces.
-    Model_Interface(const Execution& p_execution,
+    Model_Interface(std::shared_ptr<const Execution> p_execution,
                     const Coefficients& p_coefficients)
-        : Model(p_execution, p_coefficients)
+        : Model(std::move(p_execution), p_coefficients)
     {
-        if (!Check_Interaction_Terms())
+        // This is required to be "used" somewhere in order to prevent the
+        // compiler from optimising it away, thus preventing self registration.
+        (void)m_data_requirements_registered;
+
+        // A Model is constructed for every trace so the Coefficients are only
+        // checked the first time that each thread sees them.
+        thread_local std::unordered_set<std::uint64_t> checked_coefficients;
+        if (!checked_coefficients.count(p_coefficients.Get_ID()))
         {
-            Error::Report_Error("{} Model was not provided with correct "
-                                "interaction terms by the Coefficients file.",
-                                derived_t::Get_Name());
+            if (!Check_Interaction_Terms())
+            {
+                Error::Report_Error(
+                    "{} Model was not provided with correct interaction "
+                    "terms by the Coefficients file.",
+                    derived_t::Get_Name());
+            }
+            checked_coefficients.insert(p_coefficients.Get_ID());
         }
     }
 
@@ -118,11 +269,39 @@ protected:
         return derived_t::Get_Interaction_Terms();
     };
 
+    //! @brief Retrieves the data recorded by the Emulator that is used within
+    //! the model. Anything else does not need to be recorded.
+    //! @returns The Data_Requirements as defined in the derived class.
+    static const Data_Requirements& Get_Data_Requirements()
+    {
+        return derived_t::Get_Data_Requirements();
+    }
+
 public:
     //! @brief Virtual destructor to ensure proper memory cleanup.
     //! @see https://stackoverflow.com/a/461224
     virtual ~Model_Interface() = default;
 
+    //! @brief Generates the Traces of a batch of Executions one at a time,
+    //! constructing a Model of the derived type for each of p_executions.
+    //! Derived classes that can generate a batch in a single pass should
+    //! override this, along with Has_Same_Schedule().
+    //! @copydetails Model::Generate_Batch_Traces()
+    std::vector<std::vector<float>> Generate_Batch_Traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions)
+        override
+    {
+        std::vector<std::vector<float>> traces;
+        traces.reserve(p_executions.size() + 1);
+        traces.emplace_back(Generate_Traces());
+        for (const auto& execution : p_executions)
+        {
+            traces.emplace_back(
+                derived_t{execution, m_coefficients}.Generate_Traces());
+        }
+        return traces;
+    }
+
     //! @brief Ensures that all the interaction terms used within the model
     //! are provided by the Coefficients.
     //! @returns True if the all the interaction terms required by the model
@@ -147,6 +326,11 @@ public:
                            });
     }
 };
+
+template <typename derived_t>
+bool Model_Interface<derived_t>::m_data_requirements_registered{
+    Model::register_data_requirements(derived_t::Get_Name(),
+                                      derived_t::Get_Data_Requirements)};
 }  // namespace Internal
 }  // namespace GILES
 
@@ -0,0 +1,186 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Model_Kernels.cpp
+    @brief Contains the Model_Kernels class, the kernels used by the
+    models, chosen at runtime for the CPU that GILES is running on.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include "Model_Kernels.hpp"
+
+#include <atomic>  // for atomic
+
+#include "Error.hpp"       // for Report_Error
+#include "Model_Math.hpp"  // for Hamming_Weight
+
+// The kernels are compiled for their own instruction set using function
+// attributes, rather than compiler flags, so that they can live in the same
+// binary as code that runs on any x86 CPU.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GILES_MODEL_KERNELS_X86
+#include <immintrin.h>  // for _mm_popcnt_u32
+#endif
+
+namespace
+{
+using GILES::Internal::Model_Kernels;
+
+//! @brief Calculates the Hamming weight of each value one at a time, using
+//! the lookup table of Model_Math.
+void hamming_weights_scalar(const std::uint32_t* const p_values,
+                            std::uint32_t* const p_weights,
+                            const std::size_t p_count)
+{
+    for (std::size_t i{0}; i < p_count; ++i)
+    {
+        p_weights[i] = static_cast<std::uint32_t>(
+            GILES::Internal::Model_Math::Hamming_Weight(p_values[i]));
+    }
+}
+
+#ifdef GILES_MODEL_KERNELS_X86
+//! @brief Calculates the Hamming weight of each value one at a time, using
+//! the POPCNT instruction.
+__attribute__((target("sse4.2,popcnt"))) void
+hamming_weights_sse4_2(const std::uint32_t* const p_values,
+                       std::uint32_t* const p_weights,
+                       const std::size_t p_count)
+{
+    for (std::size_t i{0}; i < p_count; ++i)
+    {
+        p_weights[i] = static_cast<std::uint32_t>(_mm_popcnt_u32(p_values[i]));
+    }
+}
+#endif
+
+//! The kernels of each level, in the order of Model_Kernels::All_ISAs.
+//! Levels that cannot be compiled use the portable kernels.
+#ifdef GILES_MODEL_KERNELS_X86
+const std::array<Model_Kernels::Implementation, Model_Kernels::All_ISAs.size()>
+    implementations{{{Model_Kernels::ISA::Scalar, hamming_weights_scalar},
+                     {Model_Kernels::ISA::SSE4_2, hamming_weights_sse4_2}}};
+#else
+const std::array<Model_Kernels::Implementation, Model_Kernels::All_ISAs.size()>
+    implementations{{{Model_Kernels::ISA::Scalar, hamming_weights_scalar},
+                     {Model_Kernels::ISA::SSE4_2, hamming_weights_scalar}}};
+#endif
+
+//! @brief Retrieves the kernels in use, which are those of the best level
+//! supported by the CPU unless another has been selected.
+//! @returns The kernels in use.
+std::atomic<const Model_Kernels::Implementation*>& active()
+{
+    static std::atomic<const Model_Kernels::Implementation*> implementation{
+        &Model_Kernels::Get(Model_Kernels::Get_Supported())};
+    return implementation;
+}
+}  // namespace
+
+//! @brief Retrieves the kernels in use. These are those of the best level of
+//! instruction set supported by the CPU, unless another was selected using
+//! Select().
+//! @returns The kernels.
+const GILES::Internal::Model_Kernels::Implementation&
+GILES::Internal::Model_Kernels::Get()
+{
+    return *active().load(std::memory_order_relaxed);
+}
+
+//! @brief Retrieves the kernels of a level of instruction set.
+//! @param p_level The level. This must be supported by the CPU.
+//! @returns The kernels.
+const GILES::Internal::Model_Kernels::Implementation&
+GILES::Internal::Model_Kernels::Get(const ISA p_level)
+{
+    if (!Is_Supported(p_level))
+    {
+        Error::Report_Error("The {} instruction set is not supported by "
+                            "this CPU",
+                            Get_Name(p_level));
+    }
+    return implementations[static_cast<std::size_t>(p_level)];
+}
+
+//! @brief Finds the best level of instruction set supported by the CPU. This
+//! is only checked once.
+//! @returns The level.
+GILES::Internal::Model_Kernels::ISA
+GILES::Internal::Model_Kernels::Get_Supported()
+{
+    static const ISA supported{[] {
+        ISA best{ISA::Scalar};
+        for (const auto level : All_ISAs)
+        {
+            if (Is_Supported(level))
+            {
+                best = level;
+            }
+        }
+        return best;
+    }()};
+    return supported;
+}
+
+//! @brief Checks whether the CPU, and the operating system, support a level
+//! of instruction set.
+//! @param p_level The level.
+//! @returns True if it is supported, false if not.
+bool GILES::Internal::Model_Kernels::Is_Supported(const ISA p_level)
+{
+#ifdef GILES_MODEL_KERNELS_X86
+    __builtin_cpu_init();
+    switch (p_level)
+    {
+    case ISA::Scalar:
+        return true;
+    case ISA::SSE4_2:
+        return __builtin_cpu_supports("sse4.2") &&
+               __builtin_cpu_supports("popcnt");
+    }
+    return false;
+#else
+    return ISA::Scalar == p_level;
+#endif
+}
+
+//! @brief Selects the kernels used from now on, instead of those of the best
+//! level supported by the CPU. This is used to compare the levels and must
+//! not be called whilst traces are being generated.
+//! @param p_level The level. This must be supported by the CPU.
+void GILES::Internal::Model_Kernels::Select(const ISA p_level)
+{
+    active().store(&Get(p_level), std::memory_order_relaxed);
+}
+
+//! @brief Retrieves the name of a level of instruction set.
+//! @param p_level The level.
+//! @returns The name, e.g. "SSE4.2".
+std::string GILES::Internal::Model_Kernels::Get_Name(const ISA p_level)
+{
+    switch (p_level)
+    {
+    case ISA::Scalar:
+        return "Scalar";
+    case ISA::SSE4_2:
+        return "SSE4.2";
+    }
+    return "Unknown";
+}
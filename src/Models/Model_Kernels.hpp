@@ -0,0 +1,106 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Model_Kernels.hpp
+    @brief Contains the Model_Kernels class, the kernels used by the
+    models, chosen at runtime for the CPU that GILES is running on.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef MODEL_KERNELS_HPP
+#define MODEL_KERNELS_HPP
+
+#include <array>    // for array
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <string>   // for string
+
+namespace GILES
+{
+namespace Internal
+{
+//! @class Model_Kernels
+//! @brief The kernels used by the models for the work that is done during
+//! every clock cycle. Each kernel is implemented once for every level of
+//! instruction set and the best level supported by the CPU is chosen at
+//! runtime, so that a single binary uses the POPCNT instruction wherever it
+//! is available. Other architectures and compilers use the portable
+//! implementation.
+//! @see https://en.wikipedia.org/wiki/CPUID
+class Model_Kernels
+{
+public:
+    //! The levels of instruction set that kernels are implemented for,
+    //! from the least to the most capable.
+    enum class ISA
+    {
+        Scalar,  //!< Portable C++.
+        SSE4_2   //!< SSE4.2, including the POPCNT instruction.
+    };
+
+    //! Every level, from the least to the most capable.
+    static constexpr std::array<ISA, 2> All_ISAs{ISA::Scalar, ISA::SSE4_2};
+
+    //! @brief The kernels implemented for one level of instruction set.
+    struct Implementation
+    {
+        //! The level of instruction set used.
+        ISA Level;
+
+        //! @brief Calculates the Hamming weight of each of p_count values.
+        //! @param p_values The values.
+        //! @param p_weights Receives the Hamming weight of each value. This
+        //! may be the same as p_values.
+        //! @param p_count The number of values.
+        void (*Hamming_Weights)(const std::uint32_t* p_values,
+                                std::uint32_t* p_weights,
+                                std::size_t p_count);
+    };
+
+    static const Implementation& Get();
+
+    static const Implementation& Get(ISA p_level);
+
+    static ISA Get_Supported();
+
+    static bool Is_Supported(ISA p_level);
+
+    static void Select(ISA p_level);
+
+    static std::string Get_Name(ISA p_level);
+
+    //! @brief This has been deleted to ensure the constructor and the copy
+    //! constructor cannot be called as this is just a utility class
+    //! containing nothing but static functions.
+    //! @see https://en.cppreference.com/w/cpp/language/rule_of_three
+    //! @see https://en.cppreference.com/w/cpp/language/copy_constructor
+    Model_Kernels(const Model_Kernels&) = delete;
+
+    //! @brief This has been deleted to ensure the copy
+    //! assignment operator cannot be called as this is just a utility class
+    //! containing nothing but static functions.
+    //! @see https://en.cppreference.com/w/cpp/language/rule_of_three
+    //! @see https://en.cppreference.com/w/cpp/language/copy_assignment
+    Model_Kernels& operator=(const Model_Kernels&) = delete;
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
@@ -25,10 +25,17 @@
 
 #include "Model_Power.hpp"
 
-#include <cstdint>  // for size_t
-#include <deque>    // for deque
-#include <utility>  // for pair, make_pair
-#include <vector>   // for vector
+#include <algorithm>        // for min
+#include <array>            // for array
+#include <cstdint>          // for int64_t, size_t, uint32_t
+#include <memory>           // for make_unique, shared_ptr, unique_ptr
+#include <memory_resource>  // for memory_resource
+#include <optional>         // for nullopt
+#include <unordered_map>    // for unordered_map
+#include <utility>          // for pair, make_pair
+#include <vector>           // for vector
+
+#include "Abstract_Factory.hpp"  // for Model_Factory
 
 //! The list of interaction terms used by this model in order to generate
 //! traces.
@@ -54,179 +61,696 @@ const std::unordered_set<std::string>
         "Previous_Instruction",
         "Subsequent_Instruction"};
 
+//! The interaction terms whose coefficient is chosen by the category of
+//! another instruction. The Hamming weight and Hamming distance terms must be
+//! in the order expected by target_term().
+const std::array<std::string,
+                 GILES::Internal::Model_Power::number_of_target_terms>
+    GILES::Internal::Model_Power::m_target_terms{
+        "Previous_Instruction",
+        "Subsequent_Instruction",
+        "Hamming_Weight_Operand1_Previous_Instruction",
+        "Hamming_Weight_Operand2_Previous_Instruction",
+        "Hamming_Weight_Operand1_Subsequent_Instruction",
+        "Hamming_Weight_Operand2_Subsequent_Instruction",
+        "Hamming_Distance_Operand1_Previous_Instruction",
+        "Hamming_Distance_Operand2_Previous_Instruction",
+        "Hamming_Distance_Operand1_Subsequent_Instruction",
+        "Hamming_Distance_Operand2_Subsequent_Instruction"};
+
+//! The opcode given to clock cycles during which the "Execute" pipeline stage
+//! is stalled or flushed.
+const std::string GILES::Internal::Model_Power::m_abnormal_state{
+    "Abnormal State"};
+
+//! The terms that every sample is the sum of, in the order that they are
+//! added up.
+const std::vector<std::string> GILES::Internal::Model_Power::m_term_names{
+    "Previous_Instruction",
+    "Subsequent_Instruction",
+    "Operand1",
+    "Operand2",
+    "Operand1_Bit_Interactions",
+    "Operand2_Bit_Interactions",
+    "Bit_Flip1",
+    "Bit_Flip2",
+    "Bit_Flip1_Bit_Interactions",
+    "Bit_Flip2_Bit_Interactions",
+    "Hamming_Weight",
+    "Hamming_Distance"};
+
+//! The data used by this model. Only the "Execute" pipeline stage is read. Any
+//! register may be named by the operands of an instruction so every register
+//! is required.
+const GILES::Internal::Data_Requirements
+    GILES::Internal::Model_Power::m_data_requirements{
+        std::unordered_set<std::string>{"Execute"}, std::nullopt, false};
+
+namespace
+{
+//! @brief Constructs a Power model that calculates the Traces in the given
+//! precision. This is registered in the factory for each precision.
+//! @tparam precision The precision.
+//! @param p_execution The recorded Execution of the target program.
+//! @param p_coefficients The Coefficients.
+//! @returns The Model.
+template <GILES::Internal::Model_Power::Precision precision>
+std::unique_ptr<GILES::Internal::Model>
+construct(std::shared_ptr<const GILES::Internal::Execution> p_execution,
+          const GILES::Internal::Coefficients& p_coefficients)
+{
+    return std::make_unique<GILES::Internal::Model_Power>(
+        std::move(p_execution), p_coefficients, precision);
+}
+}  // namespace
+
+//! Registers a Model for every Precision other than the default, before main()
+//! is called.
+//! @see Abstract_Factory_Register::m_is_registered
+const bool GILES::Internal::Model_Power::m_precisions_registered{
+    register_precisions()};
+
+//! @brief Registers a Model, and its Data_Requirements, for every Precision
+//! other than the default. These are the same as the Power model apart from
+//! the precision that the Traces are calculated in, so the name given by
+//! Get_Name(Precision) constructs a Model_Power using that precision.
+//! @returns True if every Model was registered, false if any already were.
+bool GILES::Internal::Model_Power::register_precisions()
+{
+    const auto register_precision = [](const Precision p_precision,
+                                       const Model_Factory::Create_Function&
+                                           p_construct) {
+        return Model_Factory::Register(Get_Name(p_precision), p_construct) &&
+               register_data_requirements(Get_Name(p_precision),
+                                          Get_Data_Requirements);
+    };
+    const bool registered_float{register_precision(
+        Precision::Float, construct<Precision::Float>)};
+    const bool registered_fixed_point{register_precision(
+        Precision::Fixed_Point, construct<Precision::Fixed_Point>)};
+    return registered_float && registered_fixed_point;
+}
+
+//! @brief Retrieves the name of the Model that calculates the Traces in the
+//! given precision.
+//! @param p_precision The precision.
+//! @returns The name, e.g. "Power Float".
+const std::string
+GILES::Internal::Model_Power::Get_Name(const Precision p_precision)
+{
+    switch (p_precision)
+    {
+    case Precision::Double:
+        break;
+    case Precision::Float:
+        return "Power Float";
+    case Precision::Fixed_Point:
+        return "Power Fixed Point";
+    }
+    return Get_Name();
+}
+
+//! @brief Looks up the IDs of the interaction terms used by this model.
+//! @param p_compiled The compiled Coefficients. These have already been
+//! checked to contain every term.
+GILES::Internal::Model_Power::Term_IDs::Term_IDs(
+    const Compiled_Coefficients& p_compiled)
+    : Operand1{p_compiled.Find_Term("Operand1")},
+      Operand2{p_compiled.Find_Term("Operand2")},
+      Operand1_Bit_Interactions{
+          p_compiled.Find_Term("Operand1_Bit_Interactions")},
+      Operand2_Bit_Interactions{
+          p_compiled.Find_Term("Operand2_Bit_Interactions")},
+      Bit_Flip1{p_compiled.Find_Term("Bit_Flip1")},
+      Bit_Flip2{p_compiled.Find_Term("Bit_Flip2")},
+      Bit_Flip1_Bit_Interactions{
+          p_compiled.Find_Term("Bit_Flip1_Bit_Interactions")},
+      Bit_Flip2_Bit_Interactions{
+          p_compiled.Find_Term("Bit_Flip2_Bit_Interactions")},
+      Targets{}
+{
+    for (std::size_t i{0}; i < number_of_target_terms; ++i)
+    {
+        Targets[i] = p_compiled.Find_Term(m_target_terms[i]);
+    }
+}
+
+//! @brief Resolves the category of every opcode in the Execution, and the
+//! slot used when it is the target of each of m_target_terms, so that
+//! nothing is looked up by name during trace generation.
+//! @returns The coefficients of each opcode, indexed by its opcode ID and
+//! followed by those of m_abnormal_state.
+std::pmr::vector<GILES::Internal::Model_Power::Opcode_Coefficients>
+GILES::Internal::Model_Power::resolve_opcodes() const
+{
+    const std::size_t number_of_opcodes{m_execution.Get_Opcode_Count()};
+
+    std::pmr::vector<Opcode_Coefficients> opcodes{
+        m_execution.Get_Memory_Resource()};
+    opcodes.reserve(number_of_opcodes + 1);
+
+    for (std::size_t id{0}; id <= number_of_opcodes; ++id)
+    {
+        const std::string& opcode{
+            id < number_of_opcodes
+                ? m_execution.Get_Opcode(static_cast<std::uint32_t>(id))
+                : m_abnormal_state};
+
+        // Unprofiled targets use "Shifts", as Get_Instruction_Category does.
+        // The category of the target of the Hamming weight terms is resolved
+        // twice, which is what the names were looked up by previously.
+        const auto target        = Get_Instruction_Category(opcode);
+        const auto weight_target = Get_Instruction_Category(target);
+        auto category = m_compiled.Find_Category(opcode);
+        if (Compiled_Coefficients::no_category == category)
+        {
+            category = m_compiled.Get_Unprofiled();
+        }
+
+        Opcode_Coefficients resolved{category, {}};
+        for (std::size_t i{0}; i < number_of_target_terms; ++i)
+        {
+            resolved.Target_Slots[i] = m_compiled.Find_Slot(
+                m_terms.Targets[i],
+                is_hamming_weight_term(i) ? weight_target : target);
+        }
+        opcodes.push_back(resolved);
+    }
+    return opcodes;
+}
+
+//! @brief Looks up the coefficients of a clock cycle that do not depend on the
+//! data.
+//! @param p_current_instruction The instruction of the clock cycle.
+//! @param p_previous_instruction The previous instruction.
+//! @param p_next_instruction The next instruction.
+//! @returns The coefficients.
+GILES::Internal::Model_Power::Cycle_Coefficients
+GILES::Internal::Model_Power::get_cycle_coefficients(
+    const Assembly_Instruction_Power& p_current_instruction,
+    const Assembly_Instruction_Power& p_previous_instruction,
+    const Assembly_Instruction_Power& p_next_instruction) const
+{
+    return {p_current_instruction.Opcode_ID,
+            p_next_instruction.Opcode_ID,
+            static_cast<float>(get_constant(p_current_instruction)),
+            get_coefficient(p_current_instruction, 0, p_previous_instruction),
+            get_coefficient(p_current_instruction, 1, p_next_instruction),
+            get_hamming_weight_coefficients(p_current_instruction,
+                                            p_previous_instruction,
+                                            p_next_instruction),
+            get_hamming_distance_coefficients(p_current_instruction,
+                                              p_previous_instruction,
+                                              p_next_instruction)};
+}
+
+//! @brief Finds the plan of the schedule of instructions of the Execution,
+//! if this thread has seen the schedule before with the same Coefficients.
+//! A plan is only built the second time that a schedule is seen in a row, so
+//! programs that take a different path every time never pay for one.
+//! @returns The plan or nullptr if there is none.
+std::shared_ptr<const GILES::Internal::Model_Power::Schedule_Plan>
+GILES::Internal::Model_Power::find_schedule_plan() const
+{
+    // Each thread keeps its own schedules so that no locking is needed.
+    thread_local std::unordered_map<std::uint64_t, Recent_Schedule> recent;
+
+    // Coefficients that are no longer in use are eventually forgotten.
+    if (max_recent_schedules <= recent.size() &&
+        !recent.count(m_coefficients.Get_ID()))
+    {
+        recent.clear();
+    }
+    auto& schedule = recent[m_coefficients.Get_ID()];
+
+    const auto hash = m_execution.Get_Opcode_Hash("Execute");
+    if (schedule.Plan && hash == schedule.Plan->Opcode_Hash &&
+        m_execution.Get_Cycle_Count() == schedule.Plan->Cycles.size() + 2 &&
+        m_execution.Get_Opcode_Count() == schedule.Plan->Opcodes.size())
+    {
+        // The opcode IDs are checked during every clock cycle, so the text
+        // of each opcode is all that needs checking here.
+        bool same_opcodes{true};
+        for (std::uint32_t id{0}; id < schedule.Plan->Opcodes.size(); ++id)
+        {
+            same_opcodes = same_opcodes && m_execution.Get_Opcode(id) ==
+                                               schedule.Plan->Opcodes[id];
+        }
+        if (same_opcodes)
+        {
+            return schedule.Plan;
+        }
+    }
+
+    if (hash != schedule.Opcode_Hash)
+    {
+        schedule = {hash, nullptr};
+        return nullptr;
+    }
+    schedule.Plan = build_schedule_plan(hash);
+    return schedule.Plan;
+}
+
+//! @brief Builds the plan of the schedule of instructions of the Execution.
+//! @param p_opcode_hash The hash of the opcodes of the Execution.
+//! @returns The plan, or nullptr if the Execution does not produce any
+//! samples.
+std::shared_ptr<const GILES::Internal::Model_Power::Schedule_Plan>
+GILES::Internal::Model_Power::build_schedule_plan(
+    const std::uint64_t p_opcode_hash) const
+{
+    const std::size_t size{m_execution.Get_Cycle_Count()};
+    if (size <= 2)
+    {
+        return nullptr;
+    }
+
+    auto plan         = std::make_shared<Schedule_Plan>();
+    plan->Opcode_Hash = p_opcode_hash;
+    for (std::uint32_t id{0}; id < m_execution.Get_Opcode_Count(); ++id)
+    {
+        plan->Opcodes.push_back(m_execution.Get_Opcode(id));
+    }
+
+    auto registers = m_execution.Get_Register_Cursor();
+    const auto previous_instruction =
+        get_instruction_terms(m_execution, m_execute, 0, registers);
+    plan->Previous_Opcode_ID = previous_instruction.Opcode_ID;
+
+    plan->Cycles.reserve(size - 2);
+    auto current_instruction =
+        get_instruction_terms(m_execution, m_execute, 1, registers);
+    for (std::size_t i{1}; i < size - 1; ++i)
+    {
+        const auto next_instruction =
+            get_instruction_terms(m_execution, m_execute, i + 1, registers);
+        plan->Cycles.push_back(get_cycle_coefficients(
+            current_instruction, previous_instruction, next_instruction));
+        current_instruction = next_instruction;
+    }
+    return plan;
+}
+
+//! @brief Reads the first two clock cycles of an Execution, ready for the
+//! first block.
+//! @param p_model The model generating the Traces.
+//! @param p_execution The Execution.
+//! @param p_traces Receives the Traces. This must have room for a sample for
+//! every clock cycle apart from the first and last.
+GILES::Internal::Model_Power::Lane::Lane(const Model_Power& p_model,
+                                         const Execution& p_execution,
+                                         float* const p_traces)
+    : Run{p_execution}, Execute{Run.Get_Stage_Handle("Execute")},
+      Registers{Run.Get_Register_Cursor()},
+      // The previous instruction is always that of the first clock cycle and
+      // the bit flips are always those between the first two instructions
+      // and then between the second instruction and itself, as they were
+      // when these were held by growing sliding windows that were only ever
+      // read from the front. The Traces are kept the same as those, so these
+      // are calculated once.
+      Previous_Instruction{
+          p_model.get_instruction_terms(Run, Execute, 0, Registers)},
+      // Populated with the instruction of the first clock cycle that produces
+      // a sample, ready to be used as the current instruction in
+      // calculations. This is done in advance as each block only reads the
+      // instructions after it.
+      Instructions{p_model.get_instruction_terms(Run, Execute, 1, Registers)},
+      First_Interactions{Previous_Instruction, Instructions[0]},
+      Later_Interactions{Instructions[0], Instructions[0]}, Weights{},
+      Traces{p_traces}
+{
+}
+
+//! @brief Generates the Traces of every lane in the precision of this Model.
+//! @param p_lanes The lanes.
+//! @param p_number_of_lanes The number of lanes.
+void GILES::Internal::Model_Power::generate_traces(
+    Lane* const p_lanes,
+    const std::size_t p_number_of_lanes) const
+{
+    switch (m_precision)
+    {
+    case Precision::Double:
+        generate_traces_in<double>(p_lanes, p_number_of_lanes);
+        break;
+    case Precision::Float:
+        generate_traces_in<float>(p_lanes, p_number_of_lanes);
+        break;
+    case Precision::Fixed_Point:
+        generate_traces_in<Compiled_Coefficients::Fixed_Point>(
+            p_lanes, p_number_of_lanes);
+        break;
+    }
+}
+
+//! @brief This function contains the mathematical calculations that generate
+//! the Traces of every lane.
+//! Nothing is allocated for each clock cycle. The instructions are decoded in
+//! advance by the Execution and are read a block of clock cycles at a time.
+//! The Hamming weights that the block needs are then calculated together by
+//! the kernels of Model_Kernels. Every lane ran the same opcodes so the
+//! coefficients that depend only on the opcodes are looked up once for each
+//! clock cycle and shared by every lane, whose tables then stay in the cache.
+//! They are taken from the plan of the schedule, if there is one, so only the
+//! data dependent terms are calculated.
+//! @tparam value_t The precision of the coefficients that the terms are
+//! calculated with, double, float or Compiled_Coefficients::Fixed_Point.
+//! @param p_lanes The lanes.
+//! @param p_number_of_lanes The number of lanes.
+template <typename value_t>
+void GILES::Internal::Model_Power::generate_traces_in(
+    Lane* const p_lanes,
+    const std::size_t p_number_of_lanes) const
+{
+    using sum_t = total_t<value_t>;
+
+    const std::size_t size{m_execution.Get_Cycle_Count()};
+
+    //! The columns of Lane::Weights, block_size values each. These are the
+    //! first operand of the current instruction and the first operand of the
+    //! current instruction XOR that of the previous and next instructions.
+    constexpr std::size_t operand_1_weights{0};
+    constexpr std::size_t previous_distances{block_size};
+    constexpr std::size_t next_distances{2 * block_size};
+
+    const Schedule_Plan* const plan =
+        m_schedule_plan && m_schedule_plan->Previous_Opcode_ID ==
+                               p_lanes[0].Previous_Instruction.Opcode_ID
+            ? m_schedule_plan.get()
+            : nullptr;
+
+    // Start at 1 and end at size -1 as this takes into account the previous
+    // and next instructions. This is written so that it can't underflow when
+    // there are fewer than two clock cycles.
+    for (std::size_t first{1}; first + 1 < size; first += block_size)
+    {
+        // TODO: Add a special case for when i = 0 and i = last (and i = 1?/
+        // last-1?).
+
+        const std::size_t count{std::min(block_size, size - 1 - first)};
+
+        for (std::size_t lane{0}; lane < p_number_of_lanes; ++lane)
+        {
+            auto& instructions = p_lanes[lane].Instructions;
+            auto& weights      = p_lanes[lane].Weights;
+
+            // Add the next set of operands.
+            for (std::size_t j{1}; j <= count; ++j)
+            {
+                instructions[j] =
+                    get_instruction_terms(p_lanes[lane].Run,
+                                          p_lanes[lane].Execute,
+                                          first + j,
+                                          p_lanes[lane].Registers);
+            }
+
+            for (std::size_t j{0}; j < count; ++j)
+            {
+                const auto operand_1           = instructions[j].Operand_1;
+                weights[operand_1_weights + j] = operand_1;
+                weights[previous_distances + j] =
+                    operand_1 ^ p_lanes[lane].Previous_Instruction.Operand_1;
+                weights[next_distances + j] =
+                    operand_1 ^ instructions[j + 1].Operand_1;
+            }
+            m_kernels.Hamming_Weights(
+                weights.data(), weights.data(), weights.size());
+        }
+
+        for (std::size_t j{0}; j < count; ++j)
+        {
+            const std::size_t i{first + j};
+
+            // These only depend on the opcodes, which are the same in every
+            // lane. They are looked up if the plan is for another schedule.
+            const auto& schedule = p_lanes[0];
+            Cycle_Coefficients looked_up;
+            const Cycle_Coefficients* cycle{plan ? &plan->Cycles[i - 1]
+                                                 : nullptr};
+            if (!cycle ||
+                cycle->Opcode_ID != schedule.Instructions[j].Opcode_ID ||
+                cycle->Next_Opcode_ID != schedule.Instructions[j + 1].Opcode_ID)
+            {
+                looked_up =
+                    get_cycle_coefficients(schedule.Instructions[j],
+                                           schedule.Previous_Instruction,
+                                           schedule.Instructions[j + 1]);
+                cycle = &looked_up;
+            }
+
+            // These are converted into the precision used once per clock
+            // cycle, rather than for every lane.
+            const float constant{cycle->Constant};
+            const auto previous_instruction_term{
+                to_total<sum_t>(cycle->Previous_Instruction)};
+            const auto subsequent_instruction_term{
+                to_total<sum_t>(cycle->Subsequent_Instruction)};
+            std::array<sum_t, 4> hamming_weight_coefficients;
+            std::array<sum_t, 4> hamming_distance_coefficients;
+            for (std::size_t k{0}; k < hamming_weight_coefficients.size(); ++k)
+            {
+                hamming_weight_coefficients[k] =
+                    to_total<sum_t>(cycle->Hamming_Weights[k]);
+                hamming_distance_coefficients[k] =
+                    to_total<sum_t>(cycle->Hamming_Distances[k]);
+            }
+
+            for (std::size_t lane{0}; lane < p_number_of_lanes; ++lane)
+            {
+                const auto& current_instruction =
+                    p_lanes[lane].Instructions[j];
+                const auto& weights = p_lanes[lane].Weights;
+                const auto& interactions =
+                    1 == i ? p_lanes[lane].First_Interactions
+                           : p_lanes[lane].Later_Interactions;
+
+                // TODO: Bit flip 1 and 2 bit interactions is always 0 in the
+                // coeffs file. Can these be removed? Is this a bug when
+                // turning into json? Operand 1 and 2 bit interactions are only
+                // non 0 for muls and stores
+
+                // TODO: How does this work when the bit flip is based on 2
+                // instructions but the opcode isn't?
+                const auto bit_flip_1 =
+                    calculate_term<value_t>(current_instruction,
+                                            m_terms.Bit_Flip1,
+                                            interactions.Operand_1_Bit_Flip);
+
+                // TODO: How does this work when the bit flip is based on 2
+                // instructions but the opcode isn't?
+                const auto bit_flip_2 =
+                    calculate_term<value_t>(current_instruction,
+                                            m_terms.Bit_Flip2,
+                                            interactions.Operand_2_Bit_Flip);
+
+                const auto bit_flip_interactions_1 =
+                    calculate_pair_term<value_t>(
+                        current_instruction,
+                        m_terms.Bit_Flip1_Bit_Interactions,
+                        static_cast<std::uint32_t>(
+                            interactions.Operand_1_Bit_Flip.to_ulong()));
+
+                const auto bit_flip_interactions_2 =
+                    calculate_pair_term<value_t>(
+                        current_instruction,
+                        m_terms.Bit_Flip2_Bit_Interactions,
+                        static_cast<std::uint32_t>(
+                            interactions.Operand_2_Bit_Flip.to_ulong()));
+
+                const auto operand_1 = calculate_term<value_t>(
+                    current_instruction,
+                    m_terms.Operand1,
+                    std::bitset<32>(current_instruction.Operand_1));
+
+                const auto operand_2 = calculate_term<value_t>(
+                    current_instruction,
+                    m_terms.Operand2,
+                    std::bitset<32>(current_instruction.Operand_2));
+
+                const auto operand_1_bit_interactions =
+                    calculate_pair_term<value_t>(
+                        current_instruction,
+                        m_terms.Operand1_Bit_Interactions,
+                        current_instruction.Operand_1);
+
+                const auto operand_2_bit_interactions =
+                    calculate_pair_term<value_t>(
+                        current_instruction,
+                        m_terms.Operand2_Bit_Interactions,
+                        current_instruction.Operand_2);
+
+                // Every Hamming weight term is multiplied by the weight of the
+                // first operand, as it was before, so that the Traces are kept
+                // the same.
+                const sum_t weight = weights[operand_1_weights + j];
+                const auto hamming_weight_terms =
+                    hamming_weight_coefficients[0] * weight +
+                    hamming_weight_coefficients[1] * weight +
+                    hamming_weight_coefficients[2] * weight +
+                    hamming_weight_coefficients[3] * weight;
+
+                const sum_t previous_distance = weights[previous_distances + j];
+                const sum_t next_distance     = weights[next_distances + j];
+                const auto hamming_distance_terms =
+                    hamming_distance_coefficients[0] * previous_distance +
+                    hamming_distance_coefficients[1] * previous_distance +
+                    hamming_distance_coefficients[2] * next_distance +
+                    hamming_distance_coefficients[3] * next_distance;
+
+                // clang-format off
+                const sum_t total = previous_instruction_term +
+                                    subsequent_instruction_term +
+                                    operand_1 +
+                                    operand_2 +
+                                    operand_1_bit_interactions +
+                                    operand_2_bit_interactions +
+                                    bit_flip_1 +
+                                    bit_flip_2 +
+                                    bit_flip_interactions_1 +
+                                    bit_flip_interactions_2 +
+                                    hamming_weight_terms +
+                                    hamming_distance_terms;
+                // clang-format on
+                p_lanes[lane].Traces[i - 1] = constant * from_total(total);
+
+                // Each term is multiplied by the constant on its own, so that
+                // the terms of a sample add up to it.
+                if (const auto& terms = p_lanes[lane].Terms; terms[0])
+                {
+                    const std::array<sum_t, number_of_terms> values{
+                        previous_instruction_term,
+                        subsequent_instruction_term,
+                        operand_1,
+                        operand_2,
+                        operand_1_bit_interactions,
+                        operand_2_bit_interactions,
+                        bit_flip_1,
+                        bit_flip_2,
+                        bit_flip_interactions_1,
+                        bit_flip_interactions_2,
+                        hamming_weight_terms,
+                        hamming_distance_terms};
+                    for (std::size_t k{0}; k < number_of_terms; ++k)
+                    {
+                        terms[k][i - 1] = constant * from_total(values[k]);
+                    }
+                }
+            }
+        }
+
+        // The next instruction of this block is the first current instruction
+        // of the next.
+        for (std::size_t lane{0}; lane < p_number_of_lanes; ++lane)
+        {
+            p_lanes[lane].Instructions[0] = p_lanes[lane].Instructions[count];
+        }
+    }
+}
+
 //! @brief This function contains the mathematical calculations that generate
-//! the Traces.
+//! the Traces, using a single lane. The Traces are written into a buffer
+//! sized up front.
 //! @returns The generated Traces for the target program.
 const std::vector<float> GILES::Internal::Model_Power::Generate_Traces()
 {
+    const std::size_t size{m_execution.Get_Cycle_Count()};
+
+    // The first and last clock cycles do not produce a sample.
+    std::vector<float> traces(2 < size ? size - 2 : 0);
 
-    //! A sliding window that stores information about the previous, current and
-    //! next instructions.
-    //! Populated with the first two instructions, ready to be used as the
-    //! previous and current instruction in calculations.
-    //! This is done in advance as the loop below only adds the next
-    //! instruction.
-    std::deque<GILES::Internal::Model_Power::Assembly_Instruction_Power>
-        instructions_window{
-            {get_instruction_terms(0), get_instruction_terms(1)}};
-
-    const auto previous_instruction = instructions_window.front();
-    const auto current_instruction  = instructions_window[1];
-    const auto next_instruction     = instructions_window.back();
-
-    //! The interactions between the instructions stored in instructions_window.
-    //! This constructs the deque and adds one item to it, the interactions
-    //! between the first and second instructions.
-    std::deque<Instruction_Terms_Interactions> instruction_interactions_window(
-        {{previous_instruction, current_instruction}});
-
-    std::vector<float> traces;
-
-    // Start at 1 as we are taking the previous cycle into account in the
-    // calculations.
-    // Finish at size - 1 As we are taking the next cycle into account in the
-    // calculations.
+    // The lanes read the first two clock cycles, which may not exist.
+    if (traces.empty())
     {
-        float constant{0};
+        return traces;
+    }
+
+    Lane lane{*this, m_execution, traces.data()};
+    generate_traces(&lane, 1);
+    return traces;
+}
+
+//! @brief Generates the Traces of the Execution of this Model, followed by
+//! those of each of p_executions, in a single pass. Each Execution is given
+//! its own lane and every lane is modelled for each clock cycle before moving
+//! on to the next, so the coefficients of a clock cycle are only looked up
+//! once. The Traces are identical to those of Generate_Traces().
+//! @param p_executions The other Executions of the batch. Each of these must
+//! have the same schedule as the Execution of this Model, as checked by
+//! Has_Same_Schedule().
+//! @param p_term_traces Receives the contribution of each term to every
+//! sample of each Execution, if this is not null.
+//! @returns The generated Traces of each Execution, starting with the
+//! Execution of this Model.
+std::vector<std::vector<float>>
+GILES::Internal::Model_Power::generate_batch_traces(
+    const std::vector<std::shared_ptr<const Execution>>& p_executions,
+    Term_Traces* const p_term_traces)
+{
+    const std::size_t size{m_execution.Get_Cycle_Count()};
 
-        const std::size_t size{m_execution.Get_Cycle_Count()};
+    // The first and last clock cycles do not produce a sample.
+    const std::size_t number_of_samples{2 < size ? size - 2 : 0};
+    std::vector<std::vector<float>> traces(
+        p_executions.size() + 1, std::vector<float>(number_of_samples));
 
-        // Start at 1 and end at size -1 as this takes into account the previous
-        // and next instructions.
-        for (std::size_t i{1}; i < size - 1; ++i)
+    // The lanes read the first two clock cycles, which may not exist.
+    if (0 == number_of_samples)
+    {
+        if (p_term_traces)
         {
-            // TODO: Add a special case for when i = 0 and i = last (and i = 1?/
-            // last-1?).
+            p_term_traces->assign(traces.size(),
+                                  std::vector<std::vector<float>>(
+                                      number_of_terms, std::vector<float>()));
+        }
+        return traces;
+    }
 
-            // Add the next set of operands.
-            instructions_window.emplace_back(get_instruction_terms(i + 1));
-
-            // Add the next set of cross instruction interactions.
-            instruction_interactions_window.emplace_back(current_instruction,
-                                                         next_instruction);
-
-            // if the constant of the previous instruction was 0 then it was
-            // either unprofiled or an abnormal state. In this case we do not
-            // want to use it in calculations so for the sake of these
-            // calculations we will pretend it didn't occur.
-            // TODO: This should only be the case for abnormal states.
-            // Unprofiled instructions should not be captured by this.
-            if (0 != constant)
+    std::vector<Lane> lanes;
+    lanes.reserve(traces.size());
+    lanes.emplace_back(*this, m_execution, traces[0].data());
+    for (std::size_t i{0}; i < p_executions.size(); ++i)
+    {
+        lanes.emplace_back(*this, *p_executions[i], traces[i + 1].data());
+    }
+
+    if (p_term_traces)
+    {
+        p_term_traces->assign(
+            traces.size(),
+            std::vector<std::vector<float>>(
+                number_of_terms, std::vector<float>(number_of_samples)));
+        for (std::size_t i{0}; i < lanes.size(); ++i)
+        {
+            for (std::size_t k{0}; k < number_of_terms; ++k)
             {
-                const auto previous_instruction = instructions_window.front();
+                lanes[i].Terms[k] = (*p_term_traces)[i][k].data();
             }
-            const auto current_instruction = instructions_window[1];
-            const auto next_instruction    = instructions_window.back();
-
-            // std::cout << instruction_interactions_window.size() <<
-            // std::endl;
-
-            // TODO: Delete this?
-            // TODO: Can/ Should this be made constexpr?
-            const std::string& current_opcode{current_instruction.Get_Opcode()};
-
-            const std::string& previous_opcode{
-                previous_instruction.Get_Opcode()};
-
-            const std::string& next_opcode{next_instruction.Get_Opcode()};
-
-            // TODO: Bit flip 1 and 2 bit interactions is always 0 in the coeffs
-            // file. Can these be removed? Is this a bug when turning into json?
-            // Operand 1 and 2 bit interactions are only non 0 for muls and
-            // stores
-
-            // TODO: How does this work when the bit flip is based on 2
-            // instructions but the opcode isn't?
-            const auto bit_flip_1 = calculate_term(
-                current_opcode,
-                "Bit_Flip1",  // TODO: This is a typo, why does it not crash???
-                instruction_interactions_window.front().Operand_1_Bit_Flip);
-
-            // TODO: How does this work when the bit flip is based on 2
-            // instructions but the opcode isn't?
-            const auto bit_flip_2 = calculate_term(
-                current_opcode,
-                "Bit_Flip2",
-                instruction_interactions_window.front().Operand_2_Bit_Flip);
-
-            const auto bit_flip_interactions_1 = calculate_term(
-                current_opcode,
-                "Bit_Flip1_Bit_Interactions",
-                std::bitset<32>(instruction_interactions_window.front()
-                                    .Bit_Flip1_Bit_Interactions));
-
-            const auto bit_flip_interactions_2 = calculate_term(
-                current_opcode,
-                "Bit_Flip2_Bit_Interactions",
-                std::bitset<32>(instruction_interactions_window.front()
-                                    .Bit_Flip2_Bit_Interactions));
-
-            const auto operand_1 =
-                calculate_term(current_opcode,
-                               "Operand1",
-                               std::bitset<32>(current_instruction.Operand_1));
-            // TODO: Which version should be used?
-            /*
-             *        const auto operand_1 =
-             *            sum_of_scalar_multiply(current_instruction.Operand_1,
-             *                                   Get_Coefficient(current_opcode,
-             * "Operand1"));
-             */
-
-            const auto operand_2 =
-                calculate_term(current_opcode,
-                               "Operand2",
-                               std::bitset<32>(current_instruction.Operand_2));
-
-            const auto operand_1_bit_interactions = calculate_term(
-                current_opcode,
-                "Operand1_Bit_Interactions",
-                std::bitset<32>(
-                    current_instruction.Operand_1_Bit_Interactions));
-
-            const auto operand_2_bit_interactions = calculate_term(
-                current_opcode,
-                "Operand2_Bit_Interactions",
-                std::bitset<32>(
-                    current_instruction.Operand_2_Bit_Interactions));
-
-            const auto previous_instruction_term = Get_Coefficient(
-                current_opcode, "Previous_Instruction", previous_opcode);
-
-            const auto subsequent_instruction_term = Get_Coefficient(
-                current_opcode, "Subsequent_Instruction", next_opcode);
-
-            const auto hamming_weight_terms = calculate_hamming_weight_terms(
-                current_instruction, previous_opcode, next_opcode);
-
-            const auto hamming_distance_terms =
-                calculate_hamming_distance_terms(current_instruction,
-                                                 previous_instruction,
-                                                 next_instruction);
-
-            constant = Get_Constant(current_opcode);
-
-            // clang-format off
-            traces.emplace_back(constant * (
-                                previous_instruction_term +
-                                subsequent_instruction_term +
-                                operand_1 +
-                                operand_2 +
-                                operand_1_bit_interactions +
-                                operand_2_bit_interactions +
-                                bit_flip_1 +
-                                bit_flip_2 +
-                                bit_flip_interactions_1 +
-                                bit_flip_interactions_2 +
-                                hamming_weight_terms +
-                                hamming_distance_terms));
-            // clang-format on
-
-            // fmt::print("{}: {}\n", i, traces.back());
-            // Get rid of the now unneeded instruction 2 cycles before.
-            instructions_window.pop_front();
-            instruction_interactions_window.pop_front();
         }
     }
+
+    generate_traces(lanes.data(), lanes.size());
     return traces;
 }
+
+//! @brief Generates the Traces of the Execution of this Model, followed by
+//! those of each of p_executions, in a single pass.
+//! @copydetails Model::Generate_Batch_Traces()
+std::vector<std::vector<float>>
+GILES::Internal::Model_Power::Generate_Batch_Traces(
+    const std::vector<std::shared_ptr<const Execution>>& p_executions)
+{
+    return generate_batch_traces(p_executions, nullptr);
+}
+
+//! @brief Generates the Traces of a batch, as Generate_Batch_Traces() does,
+//! along with the contribution of each of m_term_names. Every term is
+//! calculated for every sample anyway, so this is the same pass with one
+//! more store for each term.
+//! @copydetails Model::Generate_Batch_Term_Traces()
+std::vector<std::vector<float>>
+GILES::Internal::Model_Power::Generate_Batch_Term_Traces(
+    const std::vector<std::shared_ptr<const Execution>>& p_executions,
+    Term_Traces& p_term_traces)
+{
+    return generate_batch_traces(p_executions, &p_term_traces);
+}
@@ -27,18 +27,21 @@
 #ifndef MODEL_POWER_HPP
 #define MODEL_POWER_HPP
 
+#include <array>        // for array
 #include <bitset>       // for bitset
-#include <cstdint>      // for size_t
+#include <cmath>        // for isnan
+#include <cstdint>      // for size_t, uint32_t
+#include <memory>       // for shared_ptr
 #include <string>       // for string
-#include <string_view>  // for string_view
-#include <type_traits>  // for is_same
-#include <utility>      // for pair
+#include <type_traits>  // for conditional_t, is_integral_v, is_same_v
+#include <utility>      // for pair, move
 #include <vector>       // for vector
 
-#include "Assembly_Instruction.hpp"
 #include "Coefficients.hpp"
+#include "Compiled_Coefficients.hpp"  // for Compiled_Coefficients
 #include "Execution.hpp"
-#include "Model.hpp"  // for Model_Interface, Hamming_Weight
+#include "Model.hpp"                  // for Model_Interface
+#include "Model_Kernels.hpp"          // for Model_Kernels
 
 namespace GILES
 {
@@ -52,71 +55,78 @@ namespace Internal
 //! this class within the factory class.
 class Model_Power : public virtual Model_Interface<Model_Power>
 {
-private:
-    class Instruction_Terms_Helper
+public:
+    //! @brief The precision that the Traces are calculated in. Each is
+    //! registered as its own Model, named by Get_Name(Precision).
+    //! The coefficients that only depend on the opcodes are always looked up
+    //! in double precision and then converted, once per clock cycle.
+    enum class Precision
     {
-    protected:
-        static std::size_t calculate_interactions(const std::bitset<32>& p_term)
-        {
-            std::size_t result{0};
-
-            // TODO: This is just dot product, change to use std function inner
-            // product.
-            // Loop through all possible combinations of i and j where i
-            // and j are never the same.
-            for (std::size_t term_1{0}; term_1 < 32; ++term_1)
-            {
-                for (std::size_t term_2{term_1 + 1}; term_2 < 32; ++term_2)
-                {
-                    result += p_term[term_1] *
-                              p_term[term_2];  // TODO: What is this doing?
-                                               // - Logical AND but why?
-                }
-            }
-            return result;
-        }
-
-        //! @brief Ensures this is a pure virtual class, only able to be
-        //! inherited from.
-        // virtual ~Instruction_Terms_Helper() = 0;
+        //! Every term is calculated and added up in double precision, as the
+        //! Traces always have been. This is the reference for the others.
+        Double,
+
+        //! Every term is calculated and added up in single precision, which
+        //! fits twice as many values into each SIMD register and halves the
+        //! size of the tables. Each addition is rounded to 24 significant
+        //! bits, so a sample is out by roughly n * 2^-24 times the total of
+        //! the magnitudes of its n terms.
+        Float,
+
+        //! Every coefficient is rounded to a multiple of 2^-b, where b is
+        //! Compiled_Coefficients::Get_Fixed_Point_Bits(), and the terms are
+        //! then added up exactly as integers. A sample adds at most 2370
+        //! rounded coefficients, counting those multiplied by a Hamming
+        //! weight once per set bit, so before it is multiplied by the
+        //! constant and rounded to a float it is out by at most
+        //! 2370 * 2^-(b + 1).
+        Fixed_Point
     };
 
+private:
     //! @todo document
     // Used to store intermediate terms needed in leakage calculations, that are
     // related to a specific instruction. This exists for the simple reason of
     // saving the time recalculating the data.
-    // TODO: This should inherit from Assembly_Instruction
-    struct Assembly_Instruction_Power : Assembly_Instruction,
-                                        Instruction_Terms_Helper
+    struct Assembly_Instruction_Power
     {
-        Assembly_Instruction_Power(
-            const GILES::Internal::Assembly_Instruction& p_instruction,
-            const std::size_t p_operand_1,
-            const std::size_t p_operand_2)  // TODO: Encode Operand value into
-                                            // Assembly_Instruction
-            : GILES::Internal::Assembly_Instruction(p_instruction),
-              Operand_1(p_operand_1), Operand_2(p_operand_2),
-              Operand_1_Bit_Interactions(calculate_interactions(p_operand_1)),
-              Operand_2_Bit_Interactions(calculate_interactions(p_operand_2))
+        //! @brief Constructs an empty slot of the instruction window.
+        Assembly_Instruction_Power() = default;
+
+        Assembly_Instruction_Power(const std::string& p_opcode,
+                                   const std::uint32_t p_opcode_id,
+                                   const std::size_t p_operand_1,
+                                   const std::size_t p_operand_2)
+            : Opcode(&p_opcode), Opcode_ID(p_opcode_id), Operand_1(p_operand_1),
+              Operand_2(p_operand_2)
         {
         }
 
-        // Does this need to be stored? -
-        // Saves recalculating it
-        //
-        // TODO: MOVE OPERANDS UP TO
-        // ASSEMBLY_INSTRUCTION!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-        const std::uint32_t Operand_1;
-        const std::uint32_t Operand_2;
-        const std::size_t Operand_1_Bit_Interactions;
-        const std::size_t Operand_2_Bit_Interactions;
+        //! @brief Gets the instructions opcode in human readable form e.g.
+        //! "add".
+        //! @return The opcode as a string.
+        const std::string& Get_Opcode() const noexcept { return *Opcode; }
+
+        //! The opcode, owned by the Execution rather than copied for every
+        //! clock cycle.
+        const std::string* Opcode{nullptr};
+
+        //! The ID of the opcode within the Execution, used to find its
+        //! coefficients in m_opcodes.
+        std::uint32_t Opcode_ID{0};
+
+        // These are not const so that the slots of the instruction window
+        // can be reused. The Hamming weights of the operands are calculated
+        // for a block of clock cycles at a time by Model_Kernels.
+        std::uint32_t Operand_1{0};
+        std::uint32_t Operand_2{0};
     };
 
     //! @todo: document
     // This stores intermediate terms that are related to the interactions
     // between two different instructions. This exists for the simple reason of
     // saving the time recalculating the data.
-    struct Instruction_Terms_Interactions : public Instruction_Terms_Helper
+    struct Instruction_Terms_Interactions
     {
         Instruction_Terms_Interactions(
             const Assembly_Instruction_Power& p_instruction_1,
@@ -124,11 +134,7 @@ private:
             : Operand_1_Bit_Flip(calculate_bitflips(p_instruction_1.Operand_1,
                                                     p_instruction_2.Operand_2)),
               Operand_2_Bit_Flip(calculate_bitflips(p_instruction_1.Operand_1,
-                                                    p_instruction_2.Operand_2)),
-              Bit_Flip1_Bit_Interactions(
-                  calculate_interactions(Operand_1_Bit_Flip)),
-              Bit_Flip2_Bit_Interactions(
-                  calculate_interactions(Operand_2_Bit_Flip))
+                                                    p_instruction_2.Operand_2))
         {
         }
         // TODO: I think only the hw and hd need to be stored?
@@ -138,8 +144,6 @@ private:
         // wrapper get function that does the to_ulong() conversion?
         const std::bitset<32> Operand_1_Bit_Flip;
         const std::bitset<32> Operand_2_Bit_Flip;
-        const std::size_t Bit_Flip1_Bit_Interactions;
-        const std::size_t Bit_Flip2_Bit_Interactions;
 
     private:
         static const std::bitset<32>
@@ -156,25 +160,95 @@ private:
         }
     };
 
+    //! The number of clock cycles whose instructions are read, and whose
+    //! Hamming weights are calculated, at a time.
+    static constexpr std::size_t block_size{64};
+
+    //! The number of interaction terms whose coefficient is chosen by the
+    //! category of another instruction, such as "Previous_Instruction".
+    static constexpr std::size_t number_of_target_terms{10};
+
+    //! The index of the first Hamming weight term within m_target_terms.
+    static constexpr std::size_t hamming_weight_terms{2};
+
+    //! The index of the first Hamming distance term within m_target_terms.
+    static constexpr std::size_t hamming_distance_terms{6};
+
+    //! The number of terms that every sample is the sum of, before it is
+    //! multiplied by the constant.
+    static constexpr std::size_t number_of_terms{12};
+
     static const std::unordered_set<std::string> m_required_interaction_terms;
+    static const std::array<std::string, number_of_target_terms>
+        m_target_terms;
+    static const Data_Requirements m_data_requirements;
+    static const std::string m_abnormal_state;
+    static const std::vector<std::string> m_term_names;
+
+    //! @brief The IDs of the interaction terms used by this model within the
+    //! compiled Coefficients, looked up once on construction.
+    struct Term_IDs
+    {
+        explicit Term_IDs(const Compiled_Coefficients& p_compiled);
+
+        const Compiled_Coefficients::Term_ID Operand1;
+        const Compiled_Coefficients::Term_ID Operand2;
+        const Compiled_Coefficients::Term_ID Operand1_Bit_Interactions;
+        const Compiled_Coefficients::Term_ID Operand2_Bit_Interactions;
+        const Compiled_Coefficients::Term_ID Bit_Flip1;
+        const Compiled_Coefficients::Term_ID Bit_Flip2;
+        const Compiled_Coefficients::Term_ID Bit_Flip1_Bit_Interactions;
+        const Compiled_Coefficients::Term_ID Bit_Flip2_Bit_Interactions;
+
+        //! The terms named by m_target_terms, in the same order.
+        std::array<Compiled_Coefficients::Term_ID, number_of_target_terms>
+            Targets;
+    };
 
-    //! @brief A wrapper around the Get_Coefficient function that will return 0
-    //! if an instruction is not found.
-    template <typename... T_categories>
-    std::vector<double>
-    Get_Coefficients(const std::string& p_opcode,
-                     const T_categories&... p_categories) const
+    //! @brief The coefficients of an opcode that occurs in the Execution,
+    //! resolved once on construction rather than during every clock cycle.
+    struct Opcode_Coefficients
     {
-        try
-        {
-            return m_coefficients.Get_Coefficients(p_opcode, p_categories...);
-        }
-        catch (const std::out_of_range& exception_not_found)
-        {
-            // 32 0s is large enough to be accessed without segfaulting.
-            return std::vector<double>(32, 0);
-        }
-    }
+        //! The category of the opcode. This is the unprofiled category, which
+        //! contributes nothing, if it was not profiled.
+        Compiled_Coefficients::Category_ID Category;
+
+        //! The slot used when this opcode is the target of each of
+        //! m_target_terms, e.g. the previous instruction.
+        std::array<std::size_t, number_of_target_terms> Target_Slots;
+    };
+
+    //! The "Execute" pipeline stage, looked up once on construction.
+    const Execution::Stage_Handle m_execute;
+
+    //! The Coefficients compiled into a table.
+    const Compiled_Coefficients& m_compiled;
+
+    //! The kernels used for the level of instruction set supported by
+    //! the CPU.
+    const Model_Kernels::Implementation& m_kernels;
+
+    //! The precision that the Traces are calculated in.
+    const Precision m_precision;
+
+    //! Registers a Model for every Precision other than the default.
+    static const bool m_precisions_registered;
+
+    static bool register_precisions();
+
+    const Term_IDs m_terms;
+
+    //! The coefficients of every opcode in the Execution, indexed by its
+    //! opcode ID and followed by those of m_abnormal_state.
+    const std::pmr::vector<Opcode_Coefficients> m_opcodes;
+
+    struct Schedule_Plan;
+
+    //! The coefficients of every clock cycle, if the schedule of instructions
+    //! of the Execution has been seen before with these Coefficients.
+    const std::shared_ptr<const Schedule_Plan> m_schedule_plan;
+
+    std::pmr::vector<Opcode_Coefficients> resolve_opcodes() const;
 
     //! @brief A wrapper around the Get_Coefficients function that will return 0
     //! if an instruction is not found and retrieve the instruction category of
@@ -204,24 +278,6 @@ private:
         }
     }
 
-    //! @brief A wrapper around the Get_Constant function that will return 0
-    //! if an instruction is not found.
-    //! @param p_opcode The opcode of the instruction that the Constant is
-    //! required for.
-    //! @returns The value of the constant for the category that the
-    //! instruction belongs to or 0 if the instruction was not found.
-    double Get_Constant(const std::string& p_opcode) const
-    {
-        try
-        {
-            return m_coefficients.Get_Constant(p_opcode);
-        }
-        catch (const std::out_of_range& exception_not_found)
-        {
-            return 0;
-        }
-    }
-
     //! @brief A wrapper around the Get_Instruction_Category function that
     //! will return Shifts if an instruction is not found.
     //! @param p_opcode The opcode of the instruction for which the category
@@ -232,18 +288,15 @@ private:
     const std::string
     Get_Instruction_Category(const std::string& p_opcode) const
     {
-        try
-        {
-            return m_coefficients.Get_Instruction_Category(p_opcode);
-        }
+        const auto category = m_compiled.Find_Category(p_opcode);
+
         // Instruction was not profiled so return any value that prevents a
         // crash. This be be zeroed out later on in calculations.
-        catch (const std::out_of_range& exception_not_found)
-        {
-            return "Shifts";
-            // Linear regression means that nothing is done for ALU and this is
-            // an invalid value so Shifts is used as the default value
-        }
+        // Linear regression means that nothing is done for ALU and this is
+        // an invalid value so Shifts is used as the default value
+        return Compiled_Coefficients::no_category == category
+                   ? "Shifts"
+                   : m_compiled.Get_Category_Name(category);
     }
 
     //! @brief Retrieves the Assembly_Instruction that is in the execute
@@ -252,36 +305,49 @@ private:
     //! normal state then a fake instruction with all terms set to be 0 is
     //! returned. This is to prevent crashing whilst still not adding erroneous
     //! data to any calculations using its terms.
+    //! @param p_execution The Execution to retrieve the instruction from. This
+    //! is m_execution or another Execution of the same batch.
+    //! @param p_execute The "Execute" pipeline stage of p_execution.
     //! @param p_cycle The clock cycle number from which to retrieve the
     //! pipeline state.
+    //! @param p_registers The cursor used to retrieve the value of registers.
+    //! This is cheapest when clock cycles are retrieved in order.
     //! @returns The requested instruction as an instance of
     //! Assembly_Instruction_Power.
     //! @see https://en.wikipedia.org/wiki/Instruction_pipelining
     //! @see https://en.wikipedia.org/wiki/Clock_cycle
     const Assembly_Instruction_Power
-    get_instruction_terms(const std::size_t& p_cycle) const
+    get_instruction_terms(const Execution& p_execution,
+                          const Execution::Stage_Handle p_execute,
+                          const std::size_t& p_cycle,
+                          Register_History::Cursor& p_registers) const
     {
         // Prevents trying to calculate the hamming weight of stalls and
         // flushes.
-        if (!m_execution.Is_Normal_State_Unsafe(p_cycle, "Execute"))
+        if (!p_execution.Is_Normal_State_Unsafe(p_cycle, p_execute))
         {
             // Return a fake instruction to prevent crashing
             // Currently stalls and flushes are stored as zeros in
             // calculations.
             return Assembly_Instruction_Power(
-                Assembly_Instruction("Abnormal State", {"0", "0"}), 0, 0);
+                m_abnormal_state,
+                static_cast<std::uint32_t>(m_opcodes.size() - 1),
+                0,
+                0);
         }
 
         // Retrieves what is in the "Execute" pipeline stage at clock cycle
-        // "i".
+        // "i". This was decoded in advance by the Execution.
         const auto& instruction =
-            m_execution.Get_Instruction(p_cycle, "Execute");
+            p_execution.Get_Decoded_Instruction(p_cycle, p_execute);
 
         // Add the next set of operands.
         return Assembly_Instruction_Power(
-            m_execution.Get_Instruction(p_cycle, "Execute"),
-            m_execution.Get_Operand_Value(p_cycle, instruction, 1),
-            m_execution.Get_Operand_Value(p_cycle, instruction, 2));
+            p_execution.Get_Opcode(instruction),
+            instruction.Opcode,
+            p_execution.Get_Operand_Value(p_registers, p_cycle, instruction, 1),
+            p_execution.Get_Operand_Value(
+                p_registers, p_cycle, instruction, 2));
     }
 
     //! @todo document
@@ -340,21 +406,159 @@ private:
         return total;
     }
 
-    template <std::size_t N>
-    double calculate_term(const std::string& p_opcode,
-                          const std::string& p_term_name,
-                          const std::bitset<N>& p_instruction_term) const
-    // TODO: Replace bitset with vector of bools everywhere?
+    //! @brief Calculates a term that has a coefficient for each bit, such as
+    //! "Operand1".
+    //! @tparam value_t The precision of the coefficients, double, float or
+    //! Compiled_Coefficients::Fixed_Point.
+    //! @param p_instruction The instruction that the coefficients are
+    //! required for.
+    //! @param p_term The ID of the interaction term.
+    //! @param p_instruction_term The bits, e.g. the first operand.
+    //! @returns The total of the weighted bits.
+    template <typename value_t = double>
+    value_t calculate_term(const Assembly_Instruction_Power& p_instruction,
+                           const Compiled_Coefficients::Term_ID p_term,
+                           const std::bitset<32>& p_instruction_term) const
     {
+        // Unprofiled instructions and abnormal states use a category where
+        // everything is zero, so they are calculated like any other.
+        const auto category = m_opcodes[p_instruction.Opcode_ID].Category;
+        if (std::isnan(m_compiled.Get_Values(category, p_term)[0]))
+        {
+            // The term is missing from this category, look it up by name to
+            // report the error.
+            m_coefficients.Get_Coefficients(p_instruction.Get_Opcode(),
+                                            m_compiled.Get_Term_Name(p_term));
+        }
+
         // This is based off of what original Elmo does to calculate an
-        // individual term
-        const auto coefficients = Get_Coefficients(p_opcode, p_term_name);
-        double total{0};
-        for (std::size_t i{0}; i < N; ++i)
+        // individual term, the sum of each bit multiplied by its coefficient.
+        // The partial sums of each byte were calculated in advance.
+        return m_compiled.Weigh_Bits<value_t>(
+            category,
+            p_term,
+            static_cast<std::uint32_t>(p_instruction_term.to_ulong()));
+    }
+
+    //! @brief Calculates a term that has a coefficient for each pair of bits,
+    //! such as "Operand1_Bit_Interactions". Every pair of bits of
+    //! p_instruction_term that are both set is weighted by its coefficient.
+    //! @tparam value_t The precision of the coefficients, double, float or
+    //! Compiled_Coefficients::Fixed_Point.
+    //! @param p_instruction The instruction that the coefficients are
+    //! required for.
+    //! @param p_term The ID of the interaction term.
+    //! @param p_instruction_term The bits, e.g. the first operand.
+    //! @returns The total of the weighted pairs of bits.
+    template <typename value_t = double>
+    value_t
+    calculate_pair_term(const Assembly_Instruction_Power& p_instruction,
+                        const Compiled_Coefficients::Term_ID p_term,
+                        const std::uint32_t p_instruction_term) const
+    {
+        const auto category = m_opcodes[p_instruction.Opcode_ID].Category;
+        if (std::isnan(m_compiled.Get_Values(category, p_term)[0]))
         {
-            total += p_instruction_term[i] * coefficients[i];
+            // The term is missing from this category, look it up by name to
+            // report the error.
+            m_coefficients.Get_Coefficients(p_instruction.Get_Opcode(),
+                                            m_compiled.Get_Term_Name(p_term));
         }
-        return total;
+
+        // The partial sums of each byte and each two nibbles were
+        // calculated in advance.
+        return m_compiled.Weigh_Bit_Pairs<value_t>(
+            category, p_term, p_instruction_term);
+    }
+
+    //! @brief The type that the terms of a sample are added up in, for
+    //! coefficients of type value_t. Fixed point terms are added up in 64 bits
+    //! so that they cannot overflow.
+    template <typename value_t>
+    using total_t = std::conditional_t<
+        std::is_same_v<value_t, Compiled_Coefficients::Fixed_Point>,
+        std::int64_t,
+        value_t>;
+
+    //! @brief Converts a coefficient into the type that the terms of a
+    //! sample are added up in.
+    //! @tparam value_t The type, as given by total_t.
+    //! @param p_coefficient The coefficient.
+    //! @returns The converted coefficient.
+    template <typename value_t>
+    value_t to_total(const double p_coefficient) const noexcept
+    {
+        if constexpr (std::is_integral_v<value_t>)
+        {
+            return m_compiled.To_Fixed_Point(p_coefficient);
+        }
+        else
+        {
+            return static_cast<value_t>(p_coefficient);
+        }
+    }
+
+    //! @brief Converts the total of the terms of a sample back from fixed
+    //! point, if it is in fixed point.
+    //! @param p_total The total.
+    //! @returns The total, as a floating point value.
+    template <typename value_t>
+    auto from_total(const value_t p_total) const noexcept
+    {
+        if constexpr (std::is_integral_v<value_t>)
+        {
+            return m_compiled.From_Fixed_Point(p_total);
+        }
+        else
+        {
+            return p_total;
+        }
+    }
+
+    //! @brief Retrieves the coefficient of an interaction term that is chosen
+    //! by the category of another instruction.
+    //! @param p_instruction The instruction that the coefficient is required
+    //! for.
+    //! @param p_target_term The index of the term within m_target_terms.
+    //! @param p_target The other instruction, e.g. the previous instruction.
+    //! @returns The coefficient or 0 if p_instruction was not profiled.
+    double get_coefficient(const Assembly_Instruction_Power& p_instruction,
+                           const std::size_t p_target_term,
+                           const Assembly_Instruction_Power& p_target) const
+    {
+        const auto category = m_opcodes[p_instruction.Opcode_ID].Category;
+        const auto slot =
+            m_opcodes[p_target.Opcode_ID].Target_Slots[p_target_term];
+        if (Compiled_Coefficients::no_slot != slot)
+        {
+            const double coefficient = m_compiled.Get_Value(
+                category, m_terms.Targets[p_target_term], slot);
+            if (!std::isnan(coefficient))
+            {
+                return coefficient;
+            }
+        }
+
+        // The coefficient is missing, look it up by name to report the error.
+        return Get_Coefficient(
+            p_instruction.Get_Opcode(),
+            m_target_terms[p_target_term],
+            is_hamming_weight_term(p_target_term)
+                ? Get_Instruction_Category(p_target.Get_Opcode())
+                : p_target.Get_Opcode());
+    }
+
+    //! @brief Retrieves the constant of an instruction.
+    //! @param p_instruction The instruction that the constant is required for.
+    //! @returns The value of the constant for the category that the
+    //! instruction belongs to or 0 if the instruction was not profiled.
+    double get_constant(const Assembly_Instruction_Power& p_instruction) const
+    {
+        const double constant = m_compiled.Get_Constant(
+            m_opcodes[p_instruction.Opcode_ID].Category);
+        return std::isnan(constant)
+                   ? m_coefficients.Get_Constant(p_instruction.Get_Opcode())
+                   : constant;
     }
 
     //! @brief Used only when calling calculate_hamming_x functions.
@@ -365,111 +569,239 @@ private:
         Subsequent
     };
 
-    double calculate_hamming_weight_terms(
-        const Assembly_Instruction_Power& p_current_instruction,
-        const std::string& p_opcode_previous,
-        const std::string& p_opcode_next) const
+    //! @brief Retrieves the index within m_target_terms of a Hamming weight
+    //! or Hamming distance term.
+    //! @param p_first_term Either hamming_weight_terms or
+    //! hamming_distance_terms.
+    //! @param p_operand_index The operand, either 1 or 2.
+    //! @param p_previous_or_next_instruction The other instruction.
+    //! @returns The index of the term.
+    static constexpr std::size_t
+    target_term(const std::size_t p_first_term,
+                const std::size_t p_operand_index,
+                const Instruction p_previous_or_next_instruction)
     {
-        const auto category_previous =
-            Get_Instruction_Category(p_opcode_previous);
-
-        const auto category_next = Get_Instruction_Category(p_opcode_next);
-
-        return calculate_hamming_weight(p_current_instruction,
-                                        1,
-                                        Instruction::Previous,
-                                        category_previous) +
-               calculate_hamming_weight(p_current_instruction,
-                                        2,
-                                        Instruction::Previous,
-                                        category_previous) +
-               calculate_hamming_weight(p_current_instruction,
-                                        1,
-                                        Instruction::Subsequent,
-                                        category_next) +
-               calculate_hamming_weight(p_current_instruction,
-                                        2,
-                                        Instruction::Subsequent,
-                                        category_next);
+        return p_first_term +
+               (Instruction::Previous == p_previous_or_next_instruction ? 0
+                                                                        : 2) +
+               p_operand_index - 1;
     }
 
-    double calculate_hamming_distance_terms(
+    //! @brief Checks whether a term within m_target_terms is a Hamming weight
+    //! term. The category of the target of these is resolved twice.
+    //! @param p_target_term The index of the term.
+    //! @returns True if it is a Hamming weight term, false if not.
+    static constexpr bool
+    is_hamming_weight_term(const std::size_t p_target_term)
+    {
+        return hamming_weight_terms <= p_target_term &&
+               p_target_term < hamming_distance_terms;
+    }
+
+    //! @brief Retrieves the coefficients of the Hamming weight terms of an
+    //! instruction. These only depend on the opcodes of the instructions so
+    //! they are shared by every Execution of a batch.
+    //! @returns The coefficients, in the order of m_target_terms.
+    std::array<double, 4> get_hamming_weight_coefficients(
         const Assembly_Instruction_Power& p_current_instruction,
         const Assembly_Instruction_Power& p_previous_instruction,
         const Assembly_Instruction_Power& p_next_instruction) const
     {
-        return calculate_hamming_distance(p_current_instruction,
-                                          p_previous_instruction,
-                                          1,
-                                          Instruction::Previous) +
-               calculate_hamming_distance(p_current_instruction,
-                                          p_previous_instruction,
-                                          2,
-                                          Instruction::Previous) +
-               calculate_hamming_distance(p_current_instruction,
-                                          p_next_instruction,
-                                          1,
-                                          Instruction::Subsequent) +
-               calculate_hamming_distance(p_current_instruction,
-                                          p_next_instruction,
-                                          2,
-                                          Instruction::Subsequent);
+        // Each of these is multiplied by the weight of the first operand
+        // rather than that of the operand that it is for, as it was before,
+        // so that the Traces are kept the same.
+        return {get_coefficient(
+                    p_current_instruction,
+                    target_term(hamming_weight_terms, 1, Instruction::Previous),
+                    p_previous_instruction),
+                get_coefficient(
+                    p_current_instruction,
+                    target_term(hamming_weight_terms, 2, Instruction::Previous),
+                    p_previous_instruction),
+                get_coefficient(p_current_instruction,
+                                target_term(hamming_weight_terms,
+                                            1,
+                                            Instruction::Subsequent),
+                                p_next_instruction),
+                get_coefficient(p_current_instruction,
+                                target_term(hamming_weight_terms,
+                                            2,
+                                            Instruction::Subsequent),
+                                p_next_instruction)};
     }
 
-    double calculate_hamming_weight(
+    //! @brief Retrieves the coefficients of the Hamming distance terms of an
+    //! instruction. These only depend on the opcodes of the instructions so
+    //! they are shared by every Execution of a batch.
+    //! @returns The coefficients, in the order of m_target_terms.
+    std::array<double, 4> get_hamming_distance_coefficients(
         const Assembly_Instruction_Power& p_current_instruction,
-        const std::size_t p_operand_index,
-        const Instruction p_previous_or_next_instruction,
-        const std::string& p_opcode_target)
-        const  // TODO: Why is this type
-               // double?? What should it be?
+        const Assembly_Instruction_Power& p_previous_instruction,
+        const Assembly_Instruction_Power& p_next_instruction) const
     {
-        std::string instruction{Instruction::Previous ==
-                                        p_previous_or_next_instruction
-                                    ? "Previous"
-                                    : "Subsequent"};
-        // This is based off of what original elmo does to calculate an
-        // individual term
-        return Get_Coefficient(p_current_instruction.Get_Opcode(),
-                               "Hamming_Weight_Operand" +
-                                   std::to_string(p_operand_index) + "_" +
-                                   instruction + "_Instruction",
-                               p_opcode_target) *
-               // hamming_weight(current_instruction.Get_Operand(p_operand_index));
-               Model_Math::Hamming_Weight(p_current_instruction.Operand_1);
+        return {get_coefficient(p_current_instruction,
+                                target_term(hamming_distance_terms,
+                                            1,
+                                            Instruction::Previous),
+                                p_previous_instruction),
+                get_coefficient(p_current_instruction,
+                                target_term(hamming_distance_terms,
+                                            2,
+                                            Instruction::Previous),
+                                p_previous_instruction),
+                get_coefficient(p_current_instruction,
+                                target_term(hamming_distance_terms,
+                                            1,
+                                            Instruction::Subsequent),
+                                p_next_instruction),
+                get_coefficient(p_current_instruction,
+                                target_term(hamming_distance_terms,
+                                            2,
+                                            Instruction::Subsequent),
+                                p_next_instruction)};
     }
 
-    double calculate_hamming_distance(
+    //! @brief The coefficients used during a clock cycle that only depend on
+    //! the opcodes of the current, previous and next instructions and not on
+    //! the data.
+    struct Cycle_Coefficients
+    {
+        //! The opcode IDs of the current and next instructions that these
+        //! were looked up for.
+        std::uint32_t Opcode_ID;
+        std::uint32_t Next_Opcode_ID;
+
+        //! The constant, which is rounded to a float as it always has been.
+        float Constant;
+
+        double Previous_Instruction;
+        double Subsequent_Instruction;
+
+        //! The coefficients of the Hamming weight terms.
+        std::array<double, 4> Hamming_Weights;
+
+        //! The coefficients of the Hamming distance terms.
+        std::array<double, 4> Hamming_Distances;
+    };
+
+    //! @brief The Cycle_Coefficients of every clock cycle of a schedule of
+    //! instructions, built once and then shared by every Execution that ran
+    //! the same schedule with the same Coefficients.
+    struct Schedule_Plan
+    {
+        //! The hash of the opcodes, given by Execution::Get_Opcode_Hash().
+        std::uint64_t Opcode_Hash{0};
+
+        //! The text of every opcode, indexed by opcode ID.
+        std::vector<std::string> Opcodes{};
+
+        //! The opcode ID of the previous instruction.
+        std::uint32_t Previous_Opcode_ID{0};
+
+        //! The coefficients of every clock cycle that produces a sample.
+        std::vector<Cycle_Coefficients> Cycles{};
+    };
+
+    //! @brief The schedule most recently seen by a thread with a set of
+    //! Coefficients, and its plan once the schedule has been seen twice.
+    struct Recent_Schedule
+    {
+        std::uint64_t Opcode_Hash{0};
+        std::shared_ptr<const Schedule_Plan> Plan{};
+    };
+
+    //! The number of sets of Coefficients whose recent schedules are kept by
+    //! each thread.
+    static constexpr std::size_t max_recent_schedules{16};
+
+    Cycle_Coefficients get_cycle_coefficients(
         const Assembly_Instruction_Power& p_current_instruction,
-        const Assembly_Instruction_Power& p_target_instruction,
-        const std::size_t p_operand_index,
-        const Instruction p_previous_or_next_instruction)
-        const  // TODO: Why is this type
-               // double?? What should it be?
+        const Assembly_Instruction_Power& p_previous_instruction,
+        const Assembly_Instruction_Power& p_next_instruction) const;
+
+    std::shared_ptr<const Schedule_Plan> find_schedule_plan() const;
+
+    std::shared_ptr<const Schedule_Plan>
+    build_schedule_plan(std::uint64_t p_opcode_hash) const;
+
+    //! @brief One of the Executions whose Traces are generated together, and
+    //! everything that is read from it a block of clock cycles at a time.
+    struct Lane
     {
-        const std::string_view instruction{
-            Instruction::Previous == p_previous_or_next_instruction
-                ? "Previous"
-                : "Subsequent"};
+        Lane(const Model_Power& p_model,
+             const Execution& p_execution,
+             float* p_traces);
 
-        // This is based off of what original elmo does to calculate an
-        // individual term
-        return Get_Coefficient(
-                   p_current_instruction.Get_Opcode(),
-                   fmt::format("Hamming_Distance_Operand{}_{}_Instruction",
-                               p_operand_index,
-                               instruction),
-                   p_target_instruction.Get_Opcode()) *
-               Model_Math::Hamming_Distance(p_current_instruction.Operand_1,
-                                            p_target_instruction.Operand_1);
-    }
+        //! Lanes only point to the Execution and the Traces, which they don't
+        //! own, so they can be copied and moved. They can't be assigned as
+        //! they refer to their Execution.
+        Lane(const Lane&) = default;
+        Lane(Lane&&)      = default;
+        Lane& operator=(const Lane&) = delete;
+        Lane& operator=(Lane&&) = delete;
+
+        //! The Execution of the target program.
+        const Execution& Run;
+
+        //! The "Execute" pipeline stage of Run.
+        const Execution::Stage_Handle Execute;
+
+        //! Retrieves the registers for each clock cycle in turn.
+        Register_History::Cursor Registers;
+
+        //! The instruction of the first clock cycle, which is always used as
+        //! the previous instruction.
+        const Assembly_Instruction_Power Previous_Instruction;
+
+        //! The instructions of a block of clock cycles, followed by the next
+        //! instruction of the last of them.
+        std::array<Assembly_Instruction_Power, block_size + 1> Instructions;
+
+        //! The bit flips of the first clock cycle that produces a sample.
+        const Instruction_Terms_Interactions First_Interactions;
+
+        //! The bit flips of every later clock cycle.
+        const Instruction_Terms_Interactions Later_Interactions;
+
+        //! The values whose Hamming weights are needed by a block, which are
+        //! replaced by their Hamming weights.
+        alignas(64) std::array<std::uint32_t, 3 * block_size> Weights;
+
+        //! Receives the Traces, one sample for every clock cycle apart from
+        //! the first and last.
+        float* const Traces;
+
+        //! Receives the contribution of each term to every sample, in the
+        //! order of m_term_names, if the Traces are being decomposed. These
+        //! are null if not.
+        std::array<float*, number_of_terms> Terms{};
+    };
+
+    void generate_traces(Lane* p_lanes, std::size_t p_number_of_lanes) const;
+
+    template <typename value_t>
+    void generate_traces_in(Lane* p_lanes,
+                            std::size_t p_number_of_lanes) const;
+
+    std::vector<std::vector<float>> generate_batch_traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions,
+        Term_Traces* p_term_traces);
 
 public:
     //! @brief The constructor makes use of the base Model constructor to
     //! assist with initialisation of private member variables.
-    Model_Power(const Execution& p_execution,
-                const Coefficients& p_coefficients)
-        : Model_Interface<Model_Power>{p_execution, p_coefficients}
+    //! @param p_execution The recorded Execution of the target program.
+    //! @param p_coefficients The Coefficients.
+    //! @param p_precision The precision that the Traces are calculated in.
+    Model_Power(std::shared_ptr<const Execution> p_execution,
+                const Coefficients& p_coefficients,
+                const Precision p_precision = Precision::Double)
+        : Model_Interface<Model_Power>{std::move(p_execution), p_coefficients},
+          m_execute{m_execution.Get_Stage_Handle("Execute")},
+          m_compiled{m_coefficients.Get_Compiled()},
+          m_kernels{Model_Kernels::Get()}, m_precision{p_precision},
+          m_terms{m_compiled}, m_opcodes{resolve_opcodes()},
+          m_schedule_plan{find_schedule_plan()}
     {
     }
 
@@ -480,6 +812,44 @@ public:
     //! @returns The generated Traces for the target program
     const std::vector<float> Generate_Traces() override;
 
+    //! @brief Checks whether p_execution ran the same opcode as the Execution
+    //! of this Model in the "Execute" pipeline stage during every clock cycle.
+    //! Every coefficient used by the model is then the same for both.
+    //! @param p_execution The other Execution.
+    //! @returns True if the Executions can share a batch, false if not.
+    bool Has_Same_Schedule(const Execution& p_execution) const override
+    {
+        return m_execution.Has_Same_Opcodes(p_execution, "Execute");
+    }
+
+    //! @brief Checks whether the coefficients of every clock cycle were
+    //! planned in advance, because another Execution with the same schedule
+    //! of instructions has already been modelled by this thread using the
+    //! same Coefficients.
+    //! @returns True if there is a plan, false if not.
+    bool Has_Schedule_Plan() const noexcept
+    {
+        return nullptr != m_schedule_plan;
+    }
+
+    std::vector<std::vector<float>> Generate_Batch_Traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions)
+        override;
+
+    //! @brief Retrieves the names of the terms that every sample is the sum
+    //! of, once multiplied by the constant. These are named after the
+    //! interaction terms of the Coefficients, apart from "Hamming_Weight" and
+    //! "Hamming_Distance" which each combine the four terms of that kind.
+    //! @returns The names of the terms.
+    const std::vector<std::string>& Get_Term_Names() const override
+    {
+        return m_term_names;
+    }
+
+    std::vector<std::vector<float>> Generate_Batch_Term_Traces(
+        const std::vector<std::shared_ptr<const Execution>>& p_executions,
+        Term_Traces& p_term_traces) override;
+
     //! @brief Retrieves a list of the interaction terms that are used within
     //! the model. These must be provided by the Coefficients in order for
     //! the model to function.
@@ -489,11 +859,21 @@ public:
         return m_required_interaction_terms;
     }
 
+    //! @brief Retrieves the data recorded by the Emulator that is used
+    //! within the model. The Emulator does not need to record anything else.
+    //! @returns The data required by the model.
+    static const Data_Requirements& Get_Data_Requirements()
+    {
+        return m_data_requirements;
+    }
+
     //! @brief Retrieves the name of this Model.
     //! @returns The name as a string.
     //! @note This is needed to ensure self registration in the factory
     //! works. The factory registration requires this as unique identifier.
     static const std::string Get_Name() { return "Power"; }
+
+    static const std::string Get_Name(Precision p_precision);
 };  // namespace Internal
 }  // namespace Internal
 }  // namespace GILES
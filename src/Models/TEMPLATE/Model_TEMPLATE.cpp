@@ -51,6 +51,11 @@ const std::unordered_set<std::string>
         "Previous_Instruction",
         "Subsequent_Instruction"};
 
+//! The data used by this model. Anything that is not listed here will not be
+//! recorded by the Emulator. The default requires everything.
+const GILES::Internal::Data_Requirements
+    GILES::Internal::Model_TEMPLATE::m_data_requirements{};
+
 //! @brief This function contains the mathematical calculations that generate
 //! the Traces.
 //! @returns The generated Traces for the target program.
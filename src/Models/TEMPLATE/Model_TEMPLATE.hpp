@@ -31,8 +31,10 @@
 #ifndef MODEL_TEMPLATE_HPP
 #define MODEL_TEMPLATE_HPP
 
+#include <memory>         // for shared_ptr
 #include <string>         // for string
 #include <unordered_set>  // for unordered_set
+#include <utility>        // for move
 #include <vector>         // for vector
 
 #include "Model.hpp"  // for Model_Interface
@@ -55,13 +57,16 @@ class Model_TEMPLATE : public virtual Model_Interface<Model_TEMPLATE>
 {
 private:
     static const std::unordered_set<std::string> m_required_interaction_terms;
+    static const Data_Requirements m_data_requirements;
 
 public:
     //! @brief The constructor makes use of the base Model constructor to assist
     //! with initialisation of private member variables.
-    Model_TEMPLATE(const GILES::Internal::Execution& p_execution,
-                   const GILES::Internal::Coefficients& p_coefficients)
-        : Model_Interface<Model_TEMPLATE>(p_execution, p_coefficients)
+    Model_TEMPLATE(
+        std::shared_ptr<const GILES::Internal::Execution> p_execution,
+        const GILES::Internal::Coefficients& p_coefficients)
+        : Model_Interface<Model_TEMPLATE>(std::move(p_execution),
+                                          p_coefficients)
     {
     }
 
@@ -76,6 +81,14 @@ public:
         return m_required_interaction_terms;
     }
 
+    //! @brief Retrieves the data recorded by the Emulator that is used
+    //! within the model. The Emulator does not need to record anything else.
+    //! @returns The data required by the model.
+    static const Data_Requirements& Get_Data_Requirements()
+    {
+        return m_data_requirements;
+    }
+
     //! @brief Retrieves the name of this Model.
     //! @returns The name as a string.
     //! @note This is needed to ensure self registration in the factory works.
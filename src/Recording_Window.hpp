@@ -0,0 +1,144 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Recording_Window.hpp
+    @brief Restricts the clock cycles that an Emulator converts into an
+    Execution.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef RECORDING_WINDOW_HPP
+#define RECORDING_WINDOW_HPP
+
+#include <algorithm>  // for min
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <optional>   // for optional
+#include <utility>    // for pair
+
+namespace GILES
+{
+namespace Internal
+{
+//! @brief Describes the region of the target program that is of interest,
+//! such as a single round of AES, so that an Emulator only converts the clock
+//! cycles within it into the Execution. Everything outside of the region is
+//! never modelled or written to the traces.
+//! The region is narrowed down in order: first to the trigger, then to the
+//! address range and finally to the cycle window within that.
+//! A default constructed Recording_Window records everything.
+struct Recording_Window
+{
+    //! The number of clock cycles to skip from the start of the region.
+    std::size_t First_Cycle{0};
+
+    //! The number of clock cycles to record.
+    //! std::nullopt records until the end of the region.
+    std::optional<std::size_t> Number_of_Cycles{};
+
+    //! Recording starts at the first clock cycle during which the program
+    //! counter holds this address.
+    //! std::nullopt starts recording from the first clock cycle.
+    std::optional<std::uint32_t> Trigger_Start{};
+
+    //! Recording stops, without including it, at the first clock cycle after
+    //! recording started during which the program counter holds this address.
+    //! std::nullopt records until the last clock cycle.
+    std::optional<std::uint32_t> Trigger_Stop{};
+
+    //! The addresses [first, second) of the code of interest, such as a
+    //! function given by an ELF symbol. Recording starts at the first clock
+    //! cycle during which the program counter is within this range and stops
+    //! after the last.
+    std::optional<std::pair<std::uint32_t, std::uint32_t>> Address_Range{};
+
+    //! @brief Checks whether the program counter is needed to find the
+    //! region.
+    //! @returns True if the region depends on the program counter, false if
+    //! not.
+    bool Requires_Program_Counter() const
+    {
+        return Trigger_Start || Trigger_Stop || Address_Range;
+    }
+
+    //! @brief Finds the clock cycles that should be recorded.
+    //! @param p_number_of_cycles The number of clock cycles that the target
+    //! program ran for.
+    //! @param p_get_program_counter Retrieves the value of the program counter
+    //! during the clock cycle it is given. This is only called if
+    //! Requires_Program_Counter() is true.
+    //! @returns The clock cycles [first, second) to be recorded. These are
+    //! equal if nothing should be recorded.
+    template <typename T_Function>
+    std::pair<std::size_t, std::size_t>
+    Find_Cycles(const std::size_t p_number_of_cycles,
+                const T_Function& p_get_program_counter) const
+    {
+        std::size_t first{0};
+        std::size_t last{p_number_of_cycles};
+
+        if (Trigger_Start)
+        {
+            while (first < last &&
+                   p_get_program_counter(first) != Trigger_Start.value())
+            {
+                ++first;
+            }
+        }
+        if (Trigger_Stop)
+        {
+            std::size_t stop{first};
+            while (stop < last &&
+                   p_get_program_counter(stop) != Trigger_Stop.value())
+            {
+                ++stop;
+            }
+            last = stop;
+        }
+        if (Address_Range)
+        {
+            const auto in_range = [this, &p_get_program_counter](
+                                      const std::size_t p_cycle) {
+                const std::uint32_t address{p_get_program_counter(p_cycle)};
+                return Address_Range->first <= address &&
+                       address < Address_Range->second;
+            };
+            while (first < last && !in_range(first))
+            {
+                ++first;
+            }
+            while (first < last && !in_range(last - 1))
+            {
+                --last;
+            }
+        }
+
+        first = std::min(last, first + First_Cycle);
+        if (Number_of_Cycles)
+        {
+            last = std::min(last, first + Number_of_Cycles.value());
+        }
+        return {first, last};
+    }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
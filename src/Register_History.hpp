@@ -0,0 +1,335 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Register_History.hpp
+    @brief This file contains a compact, delta encoded, store of the state of
+    the processor registers during every clock cycle.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef REGISTER_HISTORY_HPP
+#define REGISTER_HISTORY_HPP
+
+#include <algorithm>        // for copy_n
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint16_t, uint32_t
+#include <memory_resource>  // for memory_resource, get_default_resource
+#include <vector>           // for pmr::vector
+
+namespace GILES
+{
+namespace Internal
+{
+// Forward Declarations
+class Execution_Record_Reader;
+class Execution_Record_Writer;
+
+//! @class Register_History
+//! @brief Stores the state of every register during every clock cycle. Only
+//! the registers that changed during a clock cycle are stored for that clock
+//! cycle, alongside a full snapshot of every register (a keyframe) once every
+//! m_keyframe_interval clock cycles. This avoids storing the whole register
+//! file for each of potentially millions of clock cycles whilst bounding the
+//! cost of retrieving the registers at any given clock cycle.
+//! @see https://en.wikipedia.org/wiki/Delta_encoding
+//! @see https://en.wikipedia.org/wiki/Key_frame
+class Register_History
+{
+    // These store and restore the internal representation directly.
+    friend class Execution_Record_Reader;
+    friend class Execution_Record_Writer;
+
+public:
+    //! The number of clock cycles between each keyframe, unless specified
+    //! otherwise.
+    static constexpr std::size_t default_keyframe_interval{64};
+
+    //! @brief A change to the value of a single register.
+    struct Delta
+    {
+        //! The ID of the register that changed.
+        std::uint16_t Register;
+
+        //! The new value of the register.
+        std::uint32_t Value;
+    };
+
+    //! @class Cursor
+    //! @brief Reconstructs the registers during successive clock cycles. Moving
+    //! a Cursor forward by one clock cycle only applies the changes made
+    //! during that clock cycle, so a sequential scan of the history costs
+    //! O(1) per clock cycle. Moving it anywhere else costs at most one
+    //! keyframe interval.
+    //! @note Each thread should use its own Cursor.
+    class Cursor
+    {
+    private:
+        //! The history that the registers are reconstructed from.
+        const Register_History* m_history;
+
+        //! The clock cycle that m_registers currently holds.
+        std::size_t m_cycle;
+
+        //! Whether m_registers holds any clock cycle yet.
+        bool m_valid;
+
+        //! The value of every register during the clock cycle m_cycle,
+        //! indexed by register ID.
+        std::pmr::vector<std::uint32_t> m_registers;
+
+    public:
+        //! @brief Constructs a Cursor that is not yet positioned at any clock
+        //! cycle. The Cursor allocates from the same memory resource as the
+        //! history.
+        //! @param p_history The history to read from. This must outlive the
+        //! Cursor.
+        explicit Cursor(const Register_History& p_history)
+            : m_history(&p_history), m_cycle(0), m_valid(false),
+              m_registers(p_history.m_number_of_registers,
+                          p_history.m_last.get_allocator())
+        {
+        }
+
+        //! Cursors only point to the history that they read from, so they
+        //! can be copied and moved freely.
+        Cursor(const Cursor&) = default;
+        Cursor(Cursor&&)      = default;
+        Cursor& operator=(const Cursor&) = default;
+        Cursor& operator=(Cursor&&) = default;
+
+        //! @brief Moves the Cursor to the clock cycle given by p_cycle.
+        //! @param p_cycle The clock cycle to move to. This must be less than
+        //! Get_Cycle_Count().
+        //! @returns The value of every register during that clock cycle,
+        //! indexed by register ID. This is valid until the Cursor is next
+        //! moved.
+        const std::uint32_t* Seek(const std::size_t p_cycle)
+        {
+            const std::size_t keyframe{m_history->get_keyframe(p_cycle)};
+
+            // Only go back to the keyframe if the changes since the current
+            // clock cycle can't simply be applied.
+            if (!m_valid || p_cycle < m_cycle || m_cycle < keyframe)
+            {
+                m_history->load_keyframe(keyframe, m_registers.data());
+                m_cycle = keyframe;
+                m_valid = true;
+            }
+
+            for (; m_cycle < p_cycle; ++m_cycle)
+            {
+                m_history->apply_deltas(m_cycle + 1, m_registers.data());
+            }
+            return m_registers.data();
+        }
+
+        //! @brief Retrieves the value of the register with the ID given by
+        //! p_register during the clock cycle given by p_cycle.
+        //! @param p_cycle The clock cycle to retrieve the value from.
+        //! @param p_register The ID of the register.
+        //! @returns The value of the register.
+        std::uint32_t Get_Value(const std::size_t p_cycle,
+                                const std::uint16_t p_register)
+        {
+            return Seek(p_cycle)[p_register];
+        }
+    };
+
+private:
+    //! The number of registers within each snapshot.
+    std::size_t m_number_of_registers;
+
+    //! The number of clock cycles between each keyframe.
+    std::size_t m_keyframe_interval;
+
+    //! A full snapshot of the registers once every m_keyframe_interval clock
+    //! cycles, stored one after another.
+    std::pmr::vector<std::uint32_t> m_keyframes;
+
+    //! The changes made during every clock cycle, stored one after another.
+    std::pmr::vector<Delta> m_deltas;
+
+    //! The position within m_deltas of the first change made during each
+    //! clock cycle. This contains one more entry than the number of clock
+    //! cycles so that the changes for clock cycle i are always
+    //! [m_delta_offsets[i], m_delta_offsets[i + 1]).
+    std::pmr::vector<std::size_t> m_delta_offsets;
+
+    //! The most recently appended snapshot, which new snapshots are compared
+    //! against.
+    std::pmr::vector<std::uint32_t> m_last;
+
+    //! @brief Retrieves the clock cycle of the closest keyframe at or before
+    //! the clock cycle given by p_cycle.
+    //! @param p_cycle The clock cycle.
+    //! @returns The clock cycle of the keyframe.
+    std::size_t get_keyframe(const std::size_t p_cycle) const noexcept
+    {
+        return p_cycle - p_cycle % m_keyframe_interval;
+    }
+
+    //! @brief Copies the keyframe stored at the clock cycle given by
+    //! p_keyframe into p_registers.
+    //! @param p_keyframe The clock cycle of the keyframe.
+    //! @param p_registers Where to copy the keyframe to. This must have room
+    //! for every register.
+    void load_keyframe(const std::size_t p_keyframe,
+                       std::uint32_t* const p_registers) const
+    {
+        const std::size_t keyframe_index{p_keyframe / m_keyframe_interval};
+        std::copy_n(std::begin(m_keyframes) +
+                        keyframe_index * m_number_of_registers,
+                    m_number_of_registers,
+                    p_registers);
+    }
+
+    //! @brief Applies the changes made during the clock cycle given by
+    //! p_cycle to p_registers.
+    //! @param p_cycle The clock cycle.
+    //! @param p_registers The registers as they were during the previous
+    //! clock cycle.
+    void apply_deltas(const std::size_t p_cycle,
+                      std::uint32_t* const p_registers) const
+    {
+        const std::size_t end{m_delta_offsets[p_cycle + 1]};
+        for (auto i = m_delta_offsets[p_cycle]; i < end; ++i)
+        {
+            p_registers[m_deltas[i].Register] = m_deltas[i].Value;
+        }
+    }
+
+public:
+    //! @brief Constructs an empty Register_History.
+    //! @param p_number_of_registers The number of registers within each
+    //! snapshot.
+    //! @param p_keyframe_interval The number of clock cycles between each
+    //! keyframe. Smaller values use more memory but make random access
+    //! cheaper.
+    //! @param p_resource The memory resource to allocate from.
+    explicit Register_History(
+        const std::size_t p_number_of_registers = 0,
+        const std::size_t p_keyframe_interval   = default_keyframe_interval,
+        std::pmr::memory_resource* const p_resource =
+            std::pmr::get_default_resource())
+        : m_number_of_registers(p_number_of_registers),
+          m_keyframe_interval(p_keyframe_interval), m_keyframes(p_resource),
+          m_deltas(p_resource), m_delta_offsets(1, 0, p_resource),
+          m_last(p_number_of_registers, p_resource)
+    {
+    }
+
+    //! @brief Removes every clock cycle from the history and changes the
+    //! number of registers within each snapshot.
+    //! @param p_number_of_registers The number of registers within each
+    //! snapshot.
+    void Clear(const std::size_t p_number_of_registers)
+    {
+        *this = Register_History(
+            p_number_of_registers, m_keyframe_interval, Get_Memory_Resource());
+    }
+
+    //! @brief Adds the registers during the next clock cycle to the end of
+    //! the history.
+    //! @param p_registers The value of every register, indexed by register
+    //! ID.
+    void Append(const std::uint32_t* const p_registers)
+    {
+        const std::size_t cycle{Get_Cycle_Count()};
+
+        // The first clock cycle is stored as the changes from all zeros.
+        for (std::uint16_t i{0}; i < m_number_of_registers; ++i)
+        {
+            if (p_registers[i] != m_last[i])
+            {
+                m_deltas.push_back({i, p_registers[i]});
+                m_last[i] = p_registers[i];
+            }
+        }
+        m_delta_offsets.push_back(m_deltas.size());
+
+        if (cycle == get_keyframe(cycle))
+        {
+            m_keyframes.insert(
+                std::end(m_keyframes), std::begin(m_last), std::end(m_last));
+        }
+    }
+
+    //! @brief Adds a clock cycle to the end of the history during which no
+    //! registers changed.
+    void Append_Unchanged() { Append(m_last.data()); }
+
+    //! @brief Retrieves the number of clock cycles stored within the
+    //! history.
+    //! @returns The number of clock cycles.
+    std::size_t Get_Cycle_Count() const noexcept
+    {
+        return m_delta_offsets.size() - 1;
+    }
+
+    //! @brief Retrieves the memory resource that the history allocates from.
+    //! @returns The memory resource.
+    std::pmr::memory_resource* Get_Memory_Resource() const noexcept
+    {
+        return m_last.get_allocator().resource();
+    }
+
+    //! @brief Retrieves the number of registers within each snapshot.
+    //! @returns The number of registers.
+    std::size_t Get_Number_of_Registers() const noexcept
+    {
+        return m_number_of_registers;
+    }
+
+    //! @brief Retrieves the value of the register with the ID given by
+    //! p_register during the clock cycle given by p_cycle. This searches back
+    //! through at most one keyframe interval of changes. When scanning
+    //! through clock cycles in order, a Cursor is cheaper.
+    //! @param p_cycle The clock cycle to retrieve the value from. This must be
+    //! less than Get_Cycle_Count().
+    //! @param p_register The ID of the register.
+    //! @returns The value of the register.
+    std::uint32_t Get_Value(const std::size_t p_cycle,
+                            const std::uint16_t p_register) const
+    {
+        const std::size_t keyframe{get_keyframe(p_cycle)};
+
+        // Find the most recent change, if there was one since the keyframe.
+        for (auto i = m_delta_offsets[p_cycle + 1];
+             i > m_delta_offsets[keyframe + 1];
+             --i)
+        {
+            if (p_register == m_deltas[i - 1].Register)
+            {
+                return m_deltas[i - 1].Value;
+            }
+        }
+        return m_keyframes[(keyframe / m_keyframe_interval) *
+                               m_number_of_registers +
+                           p_register];
+    }
+
+    //! @brief Retrieves a Cursor positioned before the first clock cycle.
+    //! @returns The Cursor.
+    Cursor Get_Cursor() const { return Cursor(*this); }
+};
+}  // namespace Internal
+}  // namespace GILES
+
+#endif
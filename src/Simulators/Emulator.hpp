@@ -27,13 +27,16 @@
 #ifndef EMULATOR_INTERFACE_HPP
 #define EMULATOR_INTERFACE_HPP
 
-#include <cstdio>  // for popen
-#include <string>  // for string
-#include <vector>  // for vector
+#include <cstdio>           // for popen
+#include <memory_resource>  // for memory_resource, get_default_resource
+#include <string>           // for string
+#include <vector>           // for vector
 
 #include "Abstract_Factory_Register.hpp"  // for Emulator_Factory_Register
 #include "Assembly_Instruction.hpp"
+#include "Data_Requirements.hpp"  // for Data_Requirements
 #include "Execution.hpp"
+#include "Recording_Window.hpp"  // for Recording_Window
 
 namespace GILES
 {
@@ -53,11 +56,26 @@ protected:
     //! The path to the target program.
     const std::string m_program_path;
 
+    //! The data that will be used from the recorded Execution. Emulators may
+    //! skip recording anything that is not required. By default, everything is
+    //! required.
+    Data_Requirements m_data_requirements;
+
+    //! The memory resource that the recorded Execution is allocated from.
+    std::pmr::memory_resource* m_memory_resource;
+
+    //! The region of the target program to be recorded into the Execution.
+    //! Emulators should skip converting every clock cycle outside of it. By
+    //! default, everything is recorded.
+    Recording_Window m_recording_window;
+
     //! @brief This constructor is marked as protected as it should only be
     //! called by derived classes to assist with initialisation.
     //! @param p_program_path The path where the program is.
     explicit Emulator(const std::string& p_program_path)
-        : m_program_path(p_program_path)
+        : m_program_path(p_program_path), m_data_requirements(),
+          m_memory_resource(std::pmr::get_default_resource()),
+          m_recording_window()
     {
     }
 
@@ -97,11 +115,17 @@ public:
     //! @see https://stackoverflow.com/a/461224
     virtual ~Emulator() = default;
 
+    //! Emulators hold the state of a running simulator, which cannot be
+    //! shared, so they cannot be copied.
+    Emulator(const Emulator&) = delete;
+    Emulator& operator=(const Emulator&) = delete;
+
     //! @brief A function to start the process of invoking the emulator and
     //! recording the results.
     //! @returns The recorded Execution of the target program as an Execution
-    //! object.
-    virtual const Execution Run_Code() = 0;
+    //! object. This is returned by non const value so that it can be moved
+    //! into the std::shared_ptr that is shared between Models.
+    virtual Execution Run_Code() = 0;
 
     //! @brief A function to request to inject a fault in the simulator.
     //! @param p_cycle_to_fault The clock cycle indicating when to inject the
@@ -116,6 +140,32 @@ public:
 
     virtual void Add_Timeout(const std::uint32_t p_number_of_cycles) = 0;
 
+    //! @brief Restricts the data recorded into the Execution to only the data
+    //! that will be used, as declared by the Model.
+    //! @param p_data_requirements The data that will be used.
+    //! @see Model::Get_Data_Requirements
+    void Set_Data_Requirements(const Data_Requirements& p_data_requirements)
+    {
+        m_data_requirements = p_data_requirements;
+    }
+
+    //! @brief Sets the memory resource that the recorded Execution will be
+    //! allocated from, such as the Arena of the current worker thread.
+    //! @param p_memory_resource The memory resource. This must outlive the
+    //! Execution returned by Run_Code().
+    void Set_Memory_Resource(std::pmr::memory_resource* const p_memory_resource)
+    {
+        m_memory_resource = p_memory_resource;
+    }
+
+    //! @brief Restricts the Execution to the clock cycles within a region of
+    //! the target program, such as a single function.
+    //! @param p_recording_window The region to be recorded.
+    void Set_Recording_Window(const Recording_Window& p_recording_window)
+    {
+        m_recording_window = p_recording_window;
+    }
+
     //! @todo Document
     virtual const std::string& Get_Extra_Data() = 0;
 };
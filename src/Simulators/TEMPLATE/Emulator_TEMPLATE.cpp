@@ -27,7 +27,7 @@
 #include "Error.hpp"
 #include "Execution.hpp"
 
-const GILES::Internal::Execution GILES::Internal::Emulator_TEMPLATE::Run_Code()
+GILES::Internal::Execution GILES::Internal::Emulator_TEMPLATE::Run_Code()
 {
     // *** Place your code here ***
     //! @note m_program_path Should contain the path to the target program.
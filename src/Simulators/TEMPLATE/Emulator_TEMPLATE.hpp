@@ -41,7 +41,7 @@ public:
     {
     }
 
-    const GILES::Internal::Execution Run_Code() override;
+    GILES::Internal::Execution Run_Code() override;
 
     const std::string& Get_Extra_Data() override;
 
@@ -23,49 +23,263 @@
     @copyright GNU Affero General Public License Version 3+
 */
 
-#include <string>   // for string
-#include <utility>  // for pair
+#include <algorithm>  // for equal, min
+#include <map>        // for map
+#include <optional>   // for nullopt, optional
+#include <string>     // for string
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+#include <boost/algorithm/string.hpp>  // for to_lower_copy
 
 #include "simulator/regfile.h"  // for Reg
 
 #include "Emulator_Thumb_Sim.hpp"
+#include "Error.hpp"  // for Report_Error
 #include "Execution.hpp"
 
-const GILES::Internal::Execution GILES::Internal::Emulator_Thumb_Sim::Run_Code()
+const std::array<std::string,
+                 GILES::Internal::Emulator_Thumb_Sim::number_of_registers>
+    GILES::Internal::Emulator_Thumb_Sim::register_names{"r0",
+                                                        "r1",
+                                                        "r2",
+                                                        "r3",
+                                                        "r4",
+                                                        "r5",
+                                                        "r6",
+                                                        "r7",
+                                                        "r8",
+                                                        "r9",
+                                                        "r10",
+                                                        "r11",
+                                                        "r12",
+                                                        "sp",
+                                                        "lr",
+                                                        "pc",
+                                                        "psp",
+                                                        "xpsr",
+                                                        "control"};
+
+GILES::Internal::Execution GILES::Internal::Emulator_Thumb_Sim::Run_Code()
 {
     m_simulator.run(m_program_path);
 
     m_execution_recording = m_simulator.Get_Cycle_Recorder();
 
-    // Retrieve the results from the simulator
-    const auto& fetch   = m_execution_recording.Get_Fetch();
-    const auto& decode  = m_execution_recording.Get_Decode();
-    const auto& execute = m_execution_recording.Get_Execute();
+    const auto& registers = m_execution_recording.Get_Registers();
+
+    // Only the clock cycles within the recording window are converted into
+    // the Execution.
+    const auto [first_cycle, last_cycle] = m_recording_window.Find_Cycles(
+        m_execution_recording.Get_Cycle_Count(),
+        [this, &registers](const std::size_t p_cycle) {
+            return get_program_counter(registers.at(p_cycle));
+        });
+
+    // An empty Execution can't be modelled, and means that the trigger or
+    // symbol was never reached or the cycle window starts after the program
+    // ended.
+    if (first_cycle == last_cycle)
+    {
+        Error::Report_Error(
+            "No clock cycles were recorded as the recording window is empty. "
+            "The program ran for {} clock cycles, check that it reaches the "
+            "trigger or symbol given and that --cycles is within it",
+            m_execution_recording.Get_Cycle_Count());
+    }
+
+    // Create an Execution object and add the required data to it.
+    Execution execution(last_cycle - first_cycle, m_memory_resource);
 
     // TODO: When are the registers recorded? Should it be once or between every
     // stage?
-    const auto& registers = m_execution_recording.Get_Registers();
+    if (m_data_requirements.Requires_Registers())
+    {
+        // Registers that are not required are left as zero so that they never
+        // change and therefore take up no space in the Execution.
+        for (std::size_t i{0}; i < number_of_registers; ++i)
+        {
+            m_required_registers[i] =
+                m_data_requirements.Requires_Register(register_names[i]);
+        }
 
-    // Create an Execution object and add the required data to it.
-    Execution execution(m_execution_recording.Get_Cycle_Count());
-    execution.Add_Registers_All(registers);
-    execution.Add_Pipeline_Stage("Fetch", fetch);
-    execution.Add_Pipeline_Stage("Decode", decode);
-    execution.Add_Pipeline_Stage("Execute", execute);
+        // Registers that are not Cortex-M0 registers are dropped, unless
+        // they are required, in which case every register is added by name.
+        if (first_cycle < registers.size() &&
+            requires_unknown_registers(registers[first_cycle]))
+        {
+            std::vector<std::map<std::string, std::size_t>> named_registers;
+            named_registers.reserve(last_cycle - first_cycle);
+            for (std::size_t cycle{first_cycle};
+                 cycle < std::min(last_cycle, registers.size());
+                 ++cycle)
+            {
+                named_registers.push_back(registers[cycle]);
+            }
+            execution.Add_Registers_All(std::move(named_registers));
+        }
+        else
+        {
+            std::vector<Register_File> register_files;
+            register_files.reserve(last_cycle - first_cycle);
+            for (std::size_t cycle{first_cycle};
+                 cycle < std::min(last_cycle, registers.size());
+                 ++cycle)
+            {
+                register_files.push_back(to_register_file(registers[cycle]));
+            }
+            execution.Add_Registers_All(register_names, register_files);
+        }
+    }
+
+    if (m_data_requirements.Requires_Pipeline_Stage("Fetch"))
+    {
+        execution.Add_Pipeline_Stage(
+            "Fetch", m_execution_recording.Get_Fetch(), first_cycle);
+    }
+    if (m_data_requirements.Requires_Pipeline_Stage("Decode"))
+    {
+        execution.Add_Pipeline_Stage(
+            "Decode", m_execution_recording.Get_Decode(), first_cycle);
+    }
+    if (!m_data_requirements.Requires_Pipeline_Stage("Execute"))
+    {
+        return execution;
+    }
+
+    const auto& execute = m_execution_recording.Get_Execute();
+    execution.Add_Pipeline_Stage("Execute", execute, first_cycle);
 
     // Correctly place stalls and flushes so that they can be easily identified.
     // TODO: Flushes
-    for (std::size_t i{0}; i < execute.size(); ++i)
+    for (std::size_t i{first_cycle}; i < std::min(last_cycle, execute.size());
+         ++i)
     {
         if ("Stalled, pending decode" == execute[i])
         {
-            execution.Add_Value(
-                i, "Execute", GILES::Internal::Execution::State::Stalled);
+            execution.Add_Value(i - first_cycle,
+                                "Execute",
+                                GILES::Internal::Execution::State::Stalled);
         }
     }
     return execution;
 }
 
+std::optional<GILES::Internal::Emulator_Thumb_Sim::Cortex_M0_Register>
+GILES::Internal::Emulator_Thumb_Sim::resolve_register(
+    const std::string& p_register_name)
+{
+    const auto name = boost::algorithm::to_lower_copy(p_register_name);
+
+    for (std::size_t i{0}; i < number_of_registers; ++i)
+    {
+        if (register_names[i] == name)
+        {
+            return static_cast<Cortex_M0_Register>(i);
+        }
+    }
+    if ("r13" == name || "msp" == name)
+    {
+        return Cortex_M0_Register::SP;
+    }
+    if ("r14" == name)
+    {
+        return Cortex_M0_Register::LR;
+    }
+    if ("r15" == name)
+    {
+        return Cortex_M0_Register::PC;
+    }
+    if ("psr" == name || "apsr" == name || "ipsr" == name || "epsr" == name)
+    {
+        return Cortex_M0_Register::XPSR;
+    }
+    return std::nullopt;
+}
+
+void GILES::Internal::Emulator_Thumb_Sim::resolve_recorded_registers(
+    const std::map<std::string, std::size_t>& p_registers)
+{
+    // thumb-sim records the same registers during every clock cycle so the
+    // names are only resolved again if they change. As the registers are
+    // stored in a std::map, they are always in the same order.
+    if (std::equal(std::begin(m_recorded_register_names),
+                   std::end(m_recorded_register_names),
+                   std::begin(p_registers),
+                   std::end(p_registers),
+                   [](const std::string& p_name, const auto& p_register) {
+                       return p_name == p_register.first;
+                   }))
+    {
+        return;
+    }
+
+    m_recorded_register_names.clear();
+    m_recorded_registers.clear();
+    for (const auto& reg : p_registers)
+    {
+        m_recorded_register_names.push_back(reg.first);
+        m_recorded_registers.push_back(resolve_register(reg.first));
+    }
+}
+
+bool GILES::Internal::Emulator_Thumb_Sim::requires_unknown_registers(
+    const std::map<std::string, std::size_t>& p_registers)
+{
+    resolve_recorded_registers(p_registers);
+
+    for (std::size_t i{0}; i < m_recorded_registers.size(); ++i)
+    {
+        if (!m_recorded_registers[i] &&
+            m_data_requirements.Requires_Register(m_recorded_register_names[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+GILES::Internal::Emulator_Thumb_Sim::Register_File
+GILES::Internal::Emulator_Thumb_Sim::to_register_file(
+    const std::map<std::string, std::size_t>& p_registers)
+{
+    resolve_recorded_registers(p_registers);
+
+    Register_File register_file{};
+    auto id = std::begin(m_recorded_registers);
+    for (const auto& reg : p_registers)
+    {
+        const auto& recorded_register = *id++;
+        if (!recorded_register)
+        {
+            continue;
+        }
+        const auto index = static_cast<std::size_t>(*recorded_register);
+        if (m_required_registers[index])
+        {
+            register_file[index] = static_cast<std::uint32_t>(reg.second);
+        }
+    }
+    return register_file;
+}
+
+std::uint32_t GILES::Internal::Emulator_Thumb_Sim::get_program_counter(
+    const std::map<std::string, std::size_t>& p_registers)
+{
+    resolve_recorded_registers(p_registers);
+
+    auto id = std::begin(m_recorded_registers);
+    for (const auto& reg : p_registers)
+    {
+        if (Cortex_M0_Register::PC == *id++)
+        {
+            return static_cast<std::uint32_t>(reg.second);
+        }
+    }
+    Error::Report_Error("Thumb Sim did not record the program counter, which "
+                        "is needed to find the recording window");
+}
+
 const std::string& GILES::Internal::Emulator_Thumb_Sim::Get_Extra_Data()
 {
     return m_execution_recording.Get_Extra_Data();
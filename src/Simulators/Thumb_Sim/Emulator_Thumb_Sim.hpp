@@ -18,8 +18,14 @@
 #ifndef EMULATOR_THUMB_SIM_HPP
 #define EMULATOR_THUMB_SIM_HPP
 
-#include <string>  // for string
-#include <vector>  // for vector
+#include <array>     // for array
+#include <bitset>    // for bitset
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint8_t, uint32_t
+#include <map>       // for map
+#include <optional>  // for optional
+#include <string>    // for string
+#include <vector>    // for vector
 
 #include "Emulator.hpp"   // for Emulator_Interface
 #include "Execution.hpp"  // for Execution
@@ -32,21 +38,125 @@ namespace Internal
 {
 class Emulator_Thumb_Sim : public virtual Emulator_Interface<Emulator_Thumb_Sim>
 {
+public:
+    //! The registers of the Cortex-M0 processor that is simulated by
+    //! thumb-sim. The value of each enumerator is the position of that
+    //! register within a register file snapshot and its ID within the
+    //! Execution.
+    //! @see https://en.wikipedia.org/wiki/ARM_Cortex-M#Cortex-M0
+    enum class Cortex_M0_Register : std::uint8_t
+    {
+        R0,
+        R1,
+        R2,
+        R3,
+        R4,
+        R5,
+        R6,
+        R7,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        SP,
+        LR,
+        PC,
+        PSP,
+        XPSR,
+        CONTROL,
+        //! The number of registers, this must remain last.
+        Count
+    };
+
+    //! The number of registers in the Cortex-M0 register file.
+    static constexpr std::size_t number_of_registers{
+        static_cast<std::size_t>(Cortex_M0_Register::Count)};
+
+    //! A snapshot of the Cortex-M0 register file during a single clock cycle,
+    //! indexed by Cortex_M0_Register.
+    using Register_File = std::array<std::uint32_t, number_of_registers>;
+
+    //! The name of each register, as it appears in disassembled instructions,
+    //! indexed by Cortex_M0_Register.
+    static const std::array<std::string, number_of_registers> register_names;
+
 private:
     Simulator m_simulator;
     Thumb_Simulator::Debug m_execution_recording;
 
+    //! The name of each register recorded by thumb-sim, in the order in
+    //! which they are recorded, that m_recorded_registers was resolved from.
+    std::vector<std::string> m_recorded_register_names;
+
+    //! The register that each register recorded by thumb-sim corresponds to,
+    //! in the order in which they are recorded, or std::nullopt if it is not
+    //! a Cortex-M0 register. This is resolved from the register names once,
+    //! rather than during every clock cycle.
+    std::vector<std::optional<Cortex_M0_Register>> m_recorded_registers;
+
+    //! Whether the value of each register is required by the Model, indexed by
+    //! Cortex_M0_Register.
+    std::bitset<number_of_registers> m_required_registers;
+
+    //! @brief Resolves the name of a register, as recorded by thumb-sim, into
+    //! a Cortex_M0_Register. This is case insensitive and accepts the common
+    //! aliases of registers such as "R13" and "MSP" for SP.
+    //! @param p_register_name The name of the register.
+    //! @returns The register, or std::nullopt if it is not a Cortex-M0
+    //! register.
+    static std::optional<Cortex_M0_Register>
+    resolve_register(const std::string& p_register_name);
+
+    //! @brief Resolves the names of the registers recorded by thumb-sim into
+    //! m_recorded_registers, unless they were already resolved from the same
+    //! names.
+    //! @param p_registers The registers recorded during one clock cycle,
+    //! indexed by name.
+    void resolve_recorded_registers(
+        const std::map<std::string, std::size_t>& p_registers);
+
+    //! @brief Checks whether the Model requires any of the registers recorded
+    //! by thumb-sim that are not Cortex-M0 registers. These have no place in
+    //! a Register_File.
+    //! @param p_registers The registers recorded during one clock cycle,
+    //! indexed by name.
+    //! @returns True if any such register is required, false if not.
+    bool requires_unknown_registers(
+        const std::map<std::string, std::size_t>& p_registers);
+
+    //! @brief Retrieves the value of the program counter from the registers
+    //! recorded by thumb-sim for one clock cycle.
+    //! @param p_registers The registers recorded during one clock cycle,
+    //! indexed by name.
+    //! @returns The value of the program counter.
+    std::uint32_t
+    get_program_counter(const std::map<std::string, std::size_t>& p_registers);
+
+    //! @brief Converts the registers recorded by thumb-sim for one clock cycle
+    //! into a fixed layout snapshot, resolving the register names into
+    //! m_recorded_registers if they have not yet been resolved. Registers
+    //! that are not in m_required_registers are left as zero and those that
+    //! are not Cortex-M0 registers are dropped.
+    //! @param p_registers The registers recorded during one clock cycle,
+    //! indexed by name.
+    //! @returns The snapshot of the register file.
+    Register_File
+    to_register_file(const std::map<std::string, std::size_t>& p_registers);
+
 public:
     //! @brief Constructs an Emulator that will simulate the program given by
     //! p_program_path.
     //! @param p_program_path The path to the program to be loaded into the
     //! simulator.
     explicit Emulator_Thumb_Sim(const std::string& p_program_path)
-        : Emulator_Interface{p_program_path}, m_simulator{}
+        : Emulator_Interface{p_program_path}, m_simulator{},
+          m_recorded_register_names{}, m_recorded_registers{},
+          m_required_registers{}
     {
     }
 
-    const GILES::Internal::Execution Run_Code() override;
+    GILES::Internal::Execution Run_Code() override;
 
     const std::string& Get_Extra_Data() override;
 
@@ -25,6 +25,7 @@
 
 #include <algorithm>  // for find
 #include <iostream>   // for ios_base::failure, ios_base
+#include <optional>   // for optional
 #include <string>     // for basic_string, string
 
 #include "Validator_Coefficients.hpp"
@@ -60,6 +61,31 @@ void GILES::Internal::Validator_Coefficients::Validate_Json(
     Validate_Not_Empty(p_coefficients.front().at("Coefficients"),
                        "There must be at least one interaction term in the "
                        "Coefficients file.");
+
+    // Index every category name and instruction once so that the uniqueness
+    // of each category's instructions can be checked without searching every
+    // other category. The names are owned by p_coefficients.
+    Category_Index category_index;
+    Instruction_Index instruction_index;
+    for (const auto& category : p_coefficients.items())
+    {
+        category_index.emplace(category.key());
+
+        const auto instructions = category.value().find("Instructions");
+        if (category.value().end() == instructions)
+        {
+            continue;
+        }
+        for (const auto& instruction : *instructions)
+        {
+            if (instruction.is_string())
+            {
+                instruction_index[instruction.get_ref<const std::string&>()]
+                    .emplace_back(category.key());
+            }
+        }
+    }
+
     for (const auto& category : p_coefficients.items())  // .items() is used as
     // Validate_category_Instruction_Unique
     // requires the key as well as the value
@@ -106,10 +132,12 @@ void GILES::Internal::Validator_Coefficients::Validate_Json(
         // objects with the same name.
         if (category.value().find("Instructions") != category.value().end())
         {
-            Validate_Category_Instructions_Unique(
-                category.value(), category.key(), p_coefficients);
+            Validate_Category_Instructions_Unique(category.value(),
+                                                  category.key(),
+                                                  p_coefficients,
+                                                  instruction_index);
             Validate_Category_Header_Unique(
-                category.value(), category.key(), p_coefficients);
+                category.value(), category.key(), category_index);
         }
     }
 }
@@ -252,9 +280,11 @@ void GILES::Internal::Validator_Coefficients::
     // If this is the first category don't compare against itself, instead
     // use the last element as a reference as it is easy to access. When not
     // checking the first category, compare against the first.
+    // The categories are compared by address as comparing their contents
+    // would take as long as validating them.
     const nlohmann::json& reference_category =
-        p_coefficients.front() == p_category ? p_coefficients.back()
-                                             : p_coefficients.front();
+        &p_coefficients.front() == &p_category ? p_coefficients.back()
+                                               : p_coefficients.front();
 
     // check each interaction term individually.
     for (const auto& interaction_term : p_category["Coefficients"].items())
@@ -306,37 +336,40 @@ void GILES::Internal::Validator_Coefficients::
 //! @param p_category The instruction category to be validated.
 //! @param p_category_key The heading of the category contained within
 //! p_category.
-//! @param p_coefficients The coefficients, in order to compare against the
-//! first category.
+//! @param p_category_index The name of every category.
 //! @exception std::ios_base::failure This is thrown in the case that this
 //! validation rule fails. In this case, an instruction was found to have
 //! more than one set of coefficients associated with it.
 void GILES::Internal::Validator_Coefficients::Validate_Category_Header_Unique(
     const nlohmann::json& p_category,
     const std::string& p_category_key,
-    const nlohmann::json& p_coefficients)
+    const Category_Index& p_category_index)
 {
-    // For each category
-    for (const auto& search_category : p_coefficients.items())
+    // If several instructions are category names, the first category is
+    // reported.
+    const nlohmann::json* duplicate{nullptr};
+    for (const auto& instruction : p_category["Instructions"])
     {
-        // For each instruction
-        for (const auto& instruction : p_category["Instructions"])
+        const auto& name = instruction.get_ref<const std::string&>();
+        if (p_category_index.count(name) &&
+            (nullptr == duplicate ||
+             name < duplicate->get_ref<const std::string&>()))
         {
-            // If the category has the same name as the instruction then
-            // throw an exception.
-            if (search_category.key() == instruction)
-            {
-                throw std::ios_base::failure(
-                    "Each instruction in the Coefficients file must have "
-                    "only one set of Coefficients associated with it. " +
-                    instruction.dump() +
-                    " was used as category name and also under the "
-                    "'Instructions' tag in the "
-                    "category: \"" +
-                    p_category_key + "\"");
-            }
+            duplicate = &instruction;
         }
     }
+
+    if (nullptr != duplicate)
+    {
+        throw std::ios_base::failure(
+            "Each instruction in the Coefficients file must have "
+            "only one set of Coefficients associated with it. " +
+            duplicate->dump() +
+            " was used as category name and also under the "
+            "'Instructions' tag in the "
+            "category: \"" +
+            p_category_key + "\"");
+    }
 }
 
 //! @brief Ensures that no instruction is contained within multiple
@@ -344,56 +377,64 @@ void GILES::Internal::Validator_Coefficients::Validate_Category_Header_Unique(
 //! @param p_category The instruction category to be validated.
 //! @param p_category_key The heading of the category contained within
 //! p_category.
-//! @param p_coefficients The coefficients, in order to compare against the
-//! first category.
+//! @param p_coefficients The coefficients, in order to report the other
+//! category.
+//! @param p_instruction_index The categories that list each instruction.
 //! @exception std::ios_base::failure This is thrown in the case that this
 //! validation rule fails. In this case, an instruction was found to have
 //! more than one set of coefficients associated with it.
 void GILES::Internal::Validator_Coefficients::
-    Validate_Category_Instructions_Unique(const nlohmann::json& p_category,
-                                          const std::string& p_category_key,
-                                          const nlohmann::json& p_coefficients)
+    Validate_Category_Instructions_Unique(
+        const nlohmann::json& p_category,
+        const std::string& p_category_key,
+        const nlohmann::json& p_coefficients,
+        const Instruction_Index& p_instruction_index)
 {
-    // Check against every other category
-    for (const auto& search_category : p_coefficients.items())
+    // Find the first other category that lists any of these instructions.
+    std::optional<std::string_view> other_category;
+    for (const auto& instruction : p_category["Instructions"])
     {
-        // Don't search the category it was originally found in.
-        if (p_category_key == search_category.key())
-        {
-            continue;
-        }
-
-        // For each instruction in the category
-        for (const auto& instruction : p_category["Instructions"])
+        for (const auto category : p_instruction_index.at(
+                 instruction.get_ref<const std::string&>()))
         {
-            // If the Instructions heading is not present there is
-            // nothing
-            // to check.
-            if (search_category.value().find("Instructions") ==
-                search_category.value().end())
+            // Don't search the category it was originally found in.
+            if (p_category_key == category)
             {
                 continue;
             }
-            // If the instruction is not the search category, there is
-            // no
-            // problem
-            if (std::find(search_category.value().at("Instructions").begin(),
-                          search_category.value().at("Instructions").end(),
-                          instruction.get<std::string>()) ==
-                search_category.value().at("Instructions").end())
+            if (!other_category || category < other_category.value())
             {
-                continue;
+                other_category = category;
             }
-            // If the above checks fail then throw an exception
-            throw std::ios_base::failure(
-                "Each instruction in the Coefficients file must have "
-                "only one set of Coefficients associated with it. Found: " +
-                instruction.dump() + " in: '" + p_category_key + "'" +
-                p_category.at("Instructions").dump() + "' and also in: '" +
-                search_category.key() + "'" +
-                search_category.value().at("Instructions").dump());
+            break;
         }
     }
+    if (!other_category)
+    {
+        return;
+    }
+
+    // Report the first of these instructions that it lists.
+    const std::string search_category_key{other_category.value()};
+    const auto& search_category = p_coefficients.at(search_category_key);
+    for (const auto& instruction : p_category["Instructions"])
+    {
+        const auto& categories = p_instruction_index.at(
+            instruction.get_ref<const std::string&>());
+        if (std::find(categories.begin(),
+                      categories.end(),
+                      other_category.value()) == categories.end())
+        {
+            continue;
+        }
+        throw std::ios_base::failure(
+            "Each instruction in the Coefficients file must have "
+            "only one set of Coefficients associated with it. Found: " +
+            instruction.dump() + " in: '" + p_category_key + "'" +
+            p_category.at("Instructions").dump() + "' and also in: '" +
+            search_category_key + "'" +
+            search_category.at("Instructions").dump());
+    }
 }
 }  // namespace Internal
 }  // namespace GILES
@@ -26,7 +26,11 @@
 #ifndef VALIDATOR_COEFFICIENTS_HPP
 #define VALIDATOR_COEFFICIENTS_HPP
 
-#include <string>  // for string
+#include <string>         // for string
+#include <string_view>    // for string_view
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+#include <vector>         // for vector
 
 #include <nlohmann/json.hpp>  // for json
 
@@ -44,6 +48,14 @@ namespace Internal
 class Validator_Coefficients
 {
 private:
+    //! The name of every category.
+    using Category_Index = std::unordered_set<std::string_view>;
+
+    //! Every instruction listed under an "Instructions" tag, along with the
+    //! names of the categories that list it, in the order of the categories.
+    using Instruction_Index =
+        std::unordered_map<std::string_view, std::vector<std::string_view>>;
+
     static void Validate_Not_Empty(const nlohmann::json& p_coefficients,
                                    const std::string& p_exception_message);
 
@@ -67,15 +79,16 @@ private:
     static void Validate_Category_Interaction_Terms_Size(
         const nlohmann::json& p_category, const nlohmann::json& p_coefficients);
 
-    static void
-    Validate_Category_Instructions_Unique(const nlohmann::json& p_category,
-                                          const std::string& p_category_key,
-                                          const nlohmann::json& p_coefficients);
+    static void Validate_Category_Instructions_Unique(
+        const nlohmann::json& p_category,
+        const std::string& p_category_key,
+        const nlohmann::json& p_coefficients,
+        const Instruction_Index& p_instruction_index);
 
     static void
     Validate_Category_Header_Unique(const nlohmann::json& p_category,
                                     const std::string& p_category_key,
-                                    const nlohmann::json& p_coefficients);
+                                    const Category_Index& p_category_index);
 
     //! @brief This has been deleted to ensure the constructor and the copy
     //! constructor cannot be called as this is just a utility class containing
@@ -0,0 +1,117 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Arena.cpp
+    @brief Contains the tests for the Arena class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <array>            // for array
+#include <cstdint>          // for uint32_t
+#include <memory_resource>  // for get_default_resource
+#include <string>           // for string
+#include <vector>           // for vector
+
+#include "Arena.hpp"
+#include "Execution.hpp"
+#include "Test_Utility.hpp"  // for Make_Execution
+
+namespace
+{
+//! @brief Records a small Execution, allocating it from p_arena, in the same
+//! way that an Emulator would during one trace.
+//! @param p_arena The Arena to allocate from.
+//! @returns The number of clock cycles in the Execution.
+std::size_t record_test_execution(GILES::Internal::Arena& p_arena)
+{
+    const auto execution = GILES::Test::Make_Execution(
+        200,
+        {{"Execute", {"adds r0, r1", "eors r1, r0", "eors r1, r0"}}},
+        std::array<std::string, 2>{"r0", "r1"},
+        [](const std::size_t p_cycle,
+           std::array<std::uint32_t, 2>& p_registers) {
+            p_registers = {static_cast<std::uint32_t>(p_cycle),
+                           static_cast<std::uint32_t>(p_cycle * 7)};
+        },
+        &p_arena);
+    return execution.Get_Cycle_Count();
+}
+}  // namespace
+
+TEST_CASE("Arena class testing"
+          "[arena]")
+{
+    GILES::Internal::Arena arena;
+
+    SECTION("Allocations are counted")
+    {
+        std::pmr::vector<std::uint32_t> values(100, &arena);
+
+        REQUIRE(1 == arena.Get_Statistics().Allocations);
+        REQUIRE(100 * sizeof(std::uint32_t) ==
+                arena.Get_Statistics().Bytes_Allocated);
+    }
+
+    SECTION("The buffer grows to fit the largest trace")
+    {
+        REQUIRE(200 == record_test_execution(arena));
+        arena.Reset();
+
+        // The first trace did not fit into the empty buffer.
+        REQUIRE(1 == arena.Get_Statistics().Overflows);
+        REQUIRE(0 < arena.Get_Statistics().Capacity);
+
+        // Every following trace of the same size fits within the buffer.
+        for (std::size_t i{0}; i < 5; ++i)
+        {
+            REQUIRE(200 == record_test_execution(arena));
+            arena.Reset();
+        }
+        REQUIRE(1 == arena.Get_Statistics().Overflows);
+        REQUIRE(6 == arena.Get_Statistics().Resets);
+    }
+
+    SECTION("Execution allocates from the given memory resource")
+    {
+        const GILES::Internal::Execution execution{10, &arena};
+        REQUIRE(&arena == execution.Get_Memory_Resource());
+        REQUIRE(0 < arena.Get_Statistics().Allocations);
+
+        // Copies must not refer to the Arena as they may outlive it.
+        const auto copy = execution;
+        REQUIRE(std::pmr::get_default_resource() ==
+                copy.Get_Memory_Resource());
+    }
+
+    SECTION("Statistics can be combined")
+    {
+        GILES::Internal::Arena::Statistics total;
+        total += {1, 2, 3, 4, 5};
+        total += {10, 20, 30, 40, 50};
+
+        REQUIRE(11 == total.Allocations);
+        REQUIRE(22 == total.Bytes_Allocated);
+        REQUIRE(33 == total.Resets);
+        REQUIRE(44 == total.Overflows);
+        REQUIRE(50 == total.Capacity);
+    }
+}
@@ -25,6 +25,14 @@
 
 #include <catch.hpp>  // for catch
 
+#include <algorithm>  // for min
+#include <bitset>     // for bitset
+#include <cmath>      // for abs, ldexp
+#include <cstdint>    // for int64_t, uintptr_t, uint32_t
+#include <random>     // for mt19937, uniform_real_distribution
+#include <utility>    // for pair
+#include <vector>     // for vector
+
 #include <nlohmann/json.hpp>  // for json
 
 #include "Coefficients.hpp"
@@ -147,6 +155,72 @@ TEST_CASE("Coefficients"
             coefficients.Get_Interaction_Terms());
     }
 
+    SECTION("Get_ID")
+    {
+        // Copies share an ID, separately loaded Coefficients do not.
+        const GILES::Internal::Coefficients copy{coefficients};
+        const GILES::Internal::Coefficients reloaded{json};
+        REQUIRE(0 != coefficients.Get_ID());
+        REQUIRE(coefficients.Get_ID() == copy.Get_ID());
+        REQUIRE(coefficients.Get_ID() != reloaded.Get_ID());
+    }
+
+    SECTION("Get_Compiled")
+    {
+        const auto& compiled = coefficients.Get_Compiled();
+        using Compiled       = GILES::Internal::Compiled_Coefficients;
+
+        REQUIRE(3 == compiled.Get_Category_Count());
+        const auto alu    = compiled.Find_Category("add");
+        const auto shifts = compiled.Find_Category("lsls");
+        const auto eors   = compiled.Find_Category("eors");
+        REQUIRE(alu == compiled.Find_Category("odd"));
+        REQUIRE("ALU" == compiled.Get_Category_Name(alu));
+        REQUIRE("Shifts" == compiled.Get_Category_Name(shifts));
+        REQUIRE("eors" == compiled.Get_Category_Name(eors));
+        REQUIRE(Compiled::no_category == compiled.Find_Category("Invalid"));
+
+        // Everything within the unprofiled category is zero.
+        const auto unprofiled = compiled.Get_Unprofiled();
+        REQUIRE(compiled.Get_Category_Count() == unprofiled);
+        REQUIRE(0 == compiled.Get_Constant(unprofiled));
+        const auto operand_1 = compiled.Find_Term("Operand1");
+        for (std::size_t i{0}; i < compiled.Get_Term_Size(operand_1); ++i)
+        {
+            REQUIRE(0 == compiled.Get_Value(unprofiled, operand_1, i));
+        }
+        REQUIRE(0 == compiled.Weigh_Bits(unprofiled, operand_1, ~0u));
+
+        // Lists are padded with zeros to the length of the longest list.
+        const auto operand_2 = compiled.Find_Term("Operand2");
+        REQUIRE(Compiled::no_term == compiled.Find_Term("Invalid"));
+        REQUIRE(3 == compiled.Get_Term_Size(operand_2));
+        const double* const values = compiled.Get_Values(shifts, operand_2);
+        REQUIRE(0 == reinterpret_cast<std::uintptr_t>(values) %
+                         Compiled::alignment);
+        REQUIRE(std::vector<double>{11, 12, 13} ==
+                std::vector<double>(values, values + 3));
+
+        // Keys that are not category names are given their own slot.
+        const auto hello = compiled.Find_Term("Hello");
+        const auto world = compiled.Find_Slot(hello, "World");
+        const auto hi    = compiled.Find_Slot(hello, "Hi");
+        REQUIRE(Compiled::no_slot != world);
+        REQUIRE(world != hi);
+        REQUIRE(Compiled::no_slot == compiled.Find_Slot(hello, "Invalid"));
+        REQUIRE(coefficients.Get_Coefficient("add", "Hello", "World") ==
+                compiled.Get_Value(alu, hello, world));
+        REQUIRE(coefficients.Get_Coefficient("lsrs", "Hello", "Hi") ==
+                compiled.Get_Value(shifts, hello, hi));
+        REQUIRE(coefficients.Get_Coefficient("eors", "Hello", "Hi") ==
+                compiled.Get_Value(eors, hello, hi));
+
+        REQUIRE(coefficients.Get_Constant("lsls") ==
+                compiled.Get_Constant(shifts));
+        REQUIRE(coefficients.Get_Constant("eors") ==
+                compiled.Get_Constant(eors));
+    }
+
     // TODO: Find a way of testing these invalid results that don't return.
     /*
      *SECTION("Get_Coefficients Invalid")
@@ -163,3 +237,237 @@ TEST_CASE("Coefficients"
      *}
      */
 }
+
+TEST_CASE("Compiled_Coefficients bit weighing"
+          "[coefficients]")
+{
+    using Compiled = GILES::Internal::Compiled_Coefficients;
+
+    std::mt19937 generator{2019};
+    std::uniform_real_distribution<double> coefficient{-1, 1};
+
+    // Lists that are shorter, the same length as and longer than the number
+    // of bits weighed.
+    nlohmann::json json;
+    for (const auto& category : {"ALU", "Shifts"})
+    {
+        for (const auto& [term, size] : {std::pair{"Operand1", 32},
+                                         std::pair{"Operand2", 4},
+                                         std::pair{"Bit_Flip1", 40}})
+        {
+            for (int i{0}; i < size; ++i)
+            {
+                json[category]["Coefficients"][term].push_back(
+                    coefficient(generator));
+            }
+        }
+    }
+    const Compiled compiled{json};
+
+    // The original loop from Model_Power, weighting one bit at a time.
+    const auto weigh_each_bit = [&compiled](const Compiled::Category_ID p_cat,
+                                            const Compiled::Term_ID p_term,
+                                            const std::bitset<32>& p_bits) {
+        const double* const values = compiled.Get_Values(p_cat, p_term);
+        double total{0};
+        for (std::size_t i{0};
+             i < std::min<std::size_t>(32, compiled.Get_Term_Size(p_term));
+             ++i)
+        {
+            total += p_bits[i] * values[i];
+        }
+        return total;
+    };
+
+    std::uniform_int_distribution<std::uint32_t> bits;
+    for (const auto& category : {"ALU", "Shifts"})
+    {
+        for (const auto& term : {"Operand1", "Operand2", "Bit_Flip1"})
+        {
+            const auto category_id = compiled.Find_Category(category);
+            const auto term_id     = compiled.Find_Term(term);
+
+            for (const std::uint32_t value : {0x00000000u, 0xFFFFFFFFu})
+            {
+                REQUIRE(Approx(weigh_each_bit(category_id, term_id, value)) ==
+                        compiled.Weigh_Bits(category_id, term_id, value));
+            }
+            for (int i{0}; i < 1000; ++i)
+            {
+                const auto value = bits(generator);
+                REQUIRE(Approx(weigh_each_bit(category_id, term_id, value)) ==
+                        compiled.Weigh_Bits(category_id, term_id, value));
+            }
+        }
+    }
+
+    SECTION("Single precision and fixed point")
+    {
+        // The largest value is scaled as close to the limit as it can be.
+        double largest{0};
+        for (const auto& category : {"ALU", "Shifts"})
+        {
+            for (const auto& term : {"Operand1", "Operand2", "Bit_Flip1"})
+            {
+                const auto term_id = compiled.Find_Term(term);
+                const double* const values =
+                    compiled.Get_Values(compiled.Find_Category(category),
+                                        term_id);
+                for (std::size_t i{0}; i < compiled.Get_Term_Size(term_id);
+                     ++i)
+                {
+                    largest = std::max(largest, std::abs(values[i]));
+                }
+            }
+        }
+        REQUIRE(std::abs(compiled.To_Fixed_Point(largest)) <=
+                Compiled::fixed_point_limit);
+        REQUIRE(std::abs(compiled.To_Fixed_Point(largest)) * 2 >
+                Compiled::fixed_point_limit);
+
+        for (const auto& category : {"ALU", "Shifts"})
+        {
+            for (const auto& term : {"Operand1", "Operand2", "Bit_Flip1"})
+            {
+                const auto category_id = compiled.Find_Category(category);
+                const auto term_id     = compiled.Find_Term(term);
+                const double* const values =
+                    compiled.Get_Values(category_id, term_id);
+
+                for (int i{0}; i < 1000; ++i)
+                {
+                    const std::bitset<32> value{bits(generator)};
+                    const auto expected =
+                        weigh_each_bit(category_id, term_id, value);
+
+                    REQUIRE(std::abs(expected -
+                                     compiled.Weigh_Bits<float>(
+                                         category_id,
+                                         term_id,
+                                         value.to_ulong())) < 1e-5);
+
+                    // The total of the rounded values is exact.
+                    std::int64_t fixed_point{0};
+                    for (std::size_t j{0};
+                         j < std::min<std::size_t>(
+                                 32, compiled.Get_Term_Size(term_id));
+                         ++j)
+                    {
+                        fixed_point +=
+                            value[j] ? compiled.To_Fixed_Point(values[j]) : 0;
+                    }
+                    REQUIRE(fixed_point ==
+                            compiled.Weigh_Bits<Compiled::Fixed_Point>(
+                                category_id, term_id, value.to_ulong()));
+                    REQUIRE(std::abs(expected -
+                                     compiled.From_Fixed_Point(fixed_point)) <=
+                            32 * std::ldexp(1.0,
+                                            -compiled.Get_Fixed_Point_Bits() -
+                                                1));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Compiled_Coefficients pair weighing"
+          "[coefficients]")
+{
+    using Compiled = GILES::Internal::Compiled_Coefficients;
+
+    std::mt19937 generator{2019};
+    std::uniform_real_distribution<double> coefficient{-1, 1};
+
+    // Lists that are shorter, the same length as and longer than the number
+    // of pairs of bits.
+    nlohmann::json json;
+    for (const auto& [term, size] : {std::pair{"Operand1_Operand2", 100},
+                                     std::pair{"Operand1_Bit_Flip1", 496},
+                                     std::pair{"Operand2_Bit_Flip2", 500}})
+    {
+        for (int i{0}; i < size; ++i)
+        {
+            json["ALU"]["Coefficients"][term].push_back(coefficient(generator));
+        }
+    }
+    // A list that is all zero, which has no tables.
+    json["ALU"]["Coefficients"]["Operand1_Bit_Flip2"] =
+        std::vector<double>(496, 0.0);
+    const Compiled compiled{json};
+    const auto alu = compiled.Find_Category("ALU");
+
+    // The reference, weighting one pair of bits at a time in the order of
+    // the coefficients.
+    const auto weigh_each_pair = [&compiled, alu](
+                                     const Compiled::Term_ID p_term,
+                                     const std::bitset<32>& p_bits) {
+        const double* const values = compiled.Get_Values(alu, p_term);
+        const std::size_t size{compiled.Get_Term_Size(p_term)};
+        double total{0};
+        std::size_t k{0};
+        for (std::size_t i{0}; i < 32; ++i)
+        {
+            for (std::size_t j{i + 1}; j < 32 && k < size; ++j, ++k)
+            {
+                total += p_bits[i] * p_bits[j] * values[k];
+            }
+        }
+        return total;
+    };
+
+    std::uniform_int_distribution<std::uint32_t> bits;
+    std::vector<std::uint32_t> inputs{0x00000000u, 0xFFFFFFFFu, 0x80000001u};
+    for (int i{0}; i < 1000; ++i)
+    {
+        inputs.push_back(bits(generator));
+    }
+
+    // The fixed point reference, adding up the rounded coefficients of one
+    // pair of bits at a time.
+    const auto weigh_each_pair_fixed_point =
+        [&compiled, alu](const Compiled::Term_ID p_term,
+                         const std::bitset<32>& p_bits) {
+            const double* const values = compiled.Get_Values(alu, p_term);
+            const std::size_t size{compiled.Get_Term_Size(p_term)};
+            std::int64_t total{0};
+            std::size_t k{0};
+            for (std::size_t i{0}; i < 32; ++i)
+            {
+                for (std::size_t j{i + 1}; j < 32 && k < size; ++j, ++k)
+                {
+                    total += p_bits[i] && p_bits[j]
+                                 ? compiled.To_Fixed_Point(values[k])
+                                 : 0;
+                }
+            }
+            return total;
+        };
+
+    for (const auto& term : {"Operand1_Operand2",
+                             "Operand1_Bit_Flip1",
+                             "Operand2_Bit_Flip2",
+                             "Operand1_Bit_Flip2"})
+    {
+        const auto term_id = compiled.Find_Term(term);
+
+        // The unprofiled category weighs nothing.
+        REQUIRE(0 == compiled.Weigh_Bit_Pairs(compiled.Get_Unprofiled(),
+                                              term_id,
+                                              ~0u));
+
+        for (const auto value : inputs)
+        {
+            const double expected{weigh_each_pair(term_id, value)};
+            const double weighed{compiled.Weigh_Bit_Pairs(alu, term_id, value)};
+            REQUIRE(Approx(expected) == weighed);
+
+            // Single precision is close, and fixed point is exact for the
+            // rounded coefficients.
+            REQUIRE(std::abs(weighed - compiled.Weigh_Bit_Pairs<float>(
+                                           alu, term_id, value)) < 1e-4);
+            REQUIRE(weigh_each_pair_fixed_point(term_id, value) ==
+                    compiled.Weigh_Bit_Pairs<Compiled::Fixed_Point>(
+                        alu, term_id, value));
+        }
+    }
+}
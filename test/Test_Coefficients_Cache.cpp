@@ -0,0 +1,137 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Coefficients_Cache.cpp
+    @brief Contains the tests for the Coefficients_Cache class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <cstdio>    // for remove
+#include <cstdlib>   // for getenv, setenv, unsetenv
+#include <fstream>   // for ofstream, fstream
+#include <optional>  // for nullopt, optional
+#include <string>    // for string
+
+#include <unistd.h>  // for rmdir
+
+#include <nlohmann/json.hpp>  // for json
+
+#include "Coefficients_Cache.hpp"
+
+TEST_CASE("Coefficients_Cache class testing"
+          "[coefficients_cache]")
+{
+    using GILES::Internal::Coefficients_Cache;
+
+    const std::string path{"GILES_Test_Coefficients_Cache.bin"};
+    const std::string contents{R"({"ALU" : {"Constant" : 1.5}})"};
+    const auto json = nlohmann::json::parse(contents);
+    const auto hash = Coefficients_Cache::Hash(contents);
+
+    // Nothing is written next to the Coefficients file by default.
+    const auto default_path = Coefficients_Cache::Get_Path("coeffs.json");
+    REQUIRE((!default_path || 0 != default_path->rfind("coeffs.json", 0)));
+    REQUIRE(Coefficients_Cache::Is_Enabled());
+    REQUIRE(hash != Coefficients_Cache::Hash(contents + " "));
+
+    std::remove(path.c_str());
+    REQUIRE_FALSE(Coefficients_Cache::Load(path, hash));
+
+    REQUIRE(Coefficients_Cache::Store(path, hash, json));
+
+    SECTION("Fresh cache")
+    {
+        const auto cached = Coefficients_Cache::Load(path, hash);
+        REQUIRE(cached);
+        REQUIRE(json == *cached);
+    }
+
+    SECTION("Stale cache")
+    {
+        REQUIRE_FALSE(Coefficients_Cache::Load(path, hash + 1));
+    }
+
+    SECTION("Different version")
+    {
+        std::fstream file{path,
+                          std::ios::binary | std::ios::in | std::ios::out};
+        const auto version = Coefficients_Cache::version + 1;
+        file.seekp(Coefficients_Cache::magic.size());
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.close();
+        REQUIRE_FALSE(Coefficients_Cache::Load(path, hash));
+    }
+
+    SECTION("Damaged cache")
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::app};
+        file << "trailing";
+        file.close();
+        REQUIRE_FALSE(Coefficients_Cache::Load(path, hash));
+
+        std::ofstream truncated{path, std::ios::binary};
+        truncated << "GILESCOE";
+        truncated.close();
+        REQUIRE_FALSE(Coefficients_Cache::Load(path, hash));
+    }
+
+    SECTION("Cache directory")
+    {
+        Coefficients_Cache::Set_Directory("/tmp/caches");
+        const auto cache_path = Coefficients_Cache::Get_Path("a/coeffs.json");
+        REQUIRE(cache_path);
+        REQUIRE(0 == cache_path->rfind("/tmp/caches/coeffs.json.", 0));
+        REQUIRE(cache_path != Coefficients_Cache::Get_Path("b/coeffs.json"));
+        Coefficients_Cache::Set_Directory(std::nullopt);
+    }
+
+    SECTION("User cache directory")
+    {
+        const char* const previous{std::getenv("XDG_CACHE_HOME")};
+        const std::optional<std::string> previous_cache_home{
+            previous ? std::optional<std::string>{previous} : std::nullopt};
+
+        const std::string cache_home{"GILES_Test_Cache_Home"};
+        setenv("XDG_CACHE_HOME", cache_home.c_str(), 1);
+        const auto cache_path = Coefficients_Cache::Get_Path("a/coeffs.json");
+        REQUIRE(cache_path);
+        REQUIRE(0 == cache_path->rfind(cache_home + "/giles/coeffs.json.", 0));
+
+        // The directory is created when the first cache is stored.
+        REQUIRE(Coefficients_Cache::Store(*cache_path, hash, json));
+        REQUIRE(json == Coefficients_Cache::Load(*cache_path, hash));
+        std::remove(cache_path->c_str());
+        rmdir((cache_home + "/giles").c_str());
+        rmdir(cache_home.c_str());
+
+        if (previous_cache_home)
+        {
+            setenv("XDG_CACHE_HOME", previous_cache_home->c_str(), 1);
+        }
+        else
+        {
+            unsetenv("XDG_CACHE_HOME");
+        }
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,131 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Data_Requirements.cpp
+    @brief Contains the tests for the Data_Requirements struct and their
+    registration by Models.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <memory>         // for shared_ptr
+#include <optional>       // for nullopt
+#include <string>         // for string
+#include <unordered_set>  // for unordered_set
+#include <utility>        // for move
+#include <vector>         // for vector
+
+#include "Coefficients.hpp"
+#include "Data_Requirements.hpp"
+#include "Execution.hpp"
+#include "Model.hpp"
+
+namespace
+{
+//! A Model that does nothing other than declare its Data_Requirements.
+class Model_Data_Requirements_Test
+    : public GILES::Internal::Model_Interface<Model_Data_Requirements_Test>
+{
+public:
+    Model_Data_Requirements_Test(
+        std::shared_ptr<const GILES::Internal::Execution> p_execution,
+        const GILES::Internal::Coefficients& p_coefficients)
+        : Model_Interface<Model_Data_Requirements_Test>(std::move(p_execution),
+                                                       p_coefficients)
+    {
+    }
+
+    const std::vector<float> Generate_Traces() override { return {}; }
+
+    static const std::unordered_set<std::string>& Get_Interaction_Terms()
+    {
+        static const std::unordered_set<std::string> terms{};
+        return terms;
+    }
+
+    static const GILES::Internal::Data_Requirements& Get_Data_Requirements()
+    {
+        static const GILES::Internal::Data_Requirements requirements{
+            std::unordered_set<std::string>{"Execute"},
+            std::unordered_set<std::string>{"r0", "r1"},
+            false};
+        return requirements;
+    }
+
+    static const std::string Get_Name() { return "Data Requirements Test"; }
+};
+}  // namespace
+
+TEST_CASE("Data_Requirements testing"
+          "[data_requirements]")
+{
+    SECTION("Everything is required by default")
+    {
+        const GILES::Internal::Data_Requirements requirements{};
+
+        REQUIRE(requirements.Requires_Pipeline_Stage("Fetch"));
+        REQUIRE(requirements.Requires_Pipeline_Stage("Execute"));
+        REQUIRE(requirements.Requires_Registers());
+        REQUIRE(requirements.Requires_Register("r0"));
+        REQUIRE(requirements.Requires_Register("control"));
+        REQUIRE(requirements.Memory);
+    }
+
+    SECTION("Only the listed data is required")
+    {
+        const GILES::Internal::Data_Requirements requirements{
+            std::unordered_set<std::string>{"Execute"},
+            std::unordered_set<std::string>{"r0", "sp"},
+            false};
+
+        REQUIRE_FALSE(requirements.Requires_Pipeline_Stage("Fetch"));
+        REQUIRE(requirements.Requires_Pipeline_Stage("Execute"));
+        REQUIRE(requirements.Requires_Registers());
+        REQUIRE(requirements.Requires_Register("r0"));
+        REQUIRE(requirements.Requires_Register("sp"));
+        REQUIRE_FALSE(requirements.Requires_Register("r1"));
+        REQUIRE_FALSE(requirements.Memory);
+    }
+
+    SECTION("No registers are required")
+    {
+        const GILES::Internal::Data_Requirements requirements{
+            std::nullopt, std::unordered_set<std::string>{}, false};
+
+        REQUIRE(requirements.Requires_Pipeline_Stage("Decode"));
+        REQUIRE_FALSE(requirements.Requires_Registers());
+        REQUIRE_FALSE(requirements.Requires_Register("r0"));
+    }
+
+    SECTION("Retrieving the requirements of a Model by name")
+    {
+        const auto& requirements =
+            GILES::Internal::Model::Get_Data_Requirements(
+                Model_Data_Requirements_Test::Get_Name());
+
+        // The requirements declared by the Model are returned, not a copy.
+        REQUIRE(&Model_Data_Requirements_Test::Get_Data_Requirements() ==
+                &requirements);
+        REQUIRE_FALSE(requirements.Requires_Pipeline_Stage("Decode"));
+        REQUIRE(requirements.Requires_Register("r1"));
+        REQUIRE_FALSE(requirements.Requires_Register("r2"));
+    }
+}
@@ -79,6 +79,53 @@ TEST_CASE("Execution class testing"
             "The requested pipeline state is not stored as the requested type");
     }
 
+    SECTION("Add_Value & Get_Value mixed types")
+    {
+        REQUIRE_NOTHROW(execution.Add_Pipeline_Stage(
+            "Execute", std::vector<std::string>{"add r0, 10", "add r0, 10"}));
+        REQUIRE_NOTHROW(
+            execution.Add_Value<std::uint8_t>(1, "Execute", 0b0101101));
+        REQUIRE_NOTHROW(execution.Add_Value<bool>(2, "Execute", true));
+
+        REQUIRE("add r0, 10" == execution.Get_Value<std::string>(0, "Execute"));
+        REQUIRE(0b0101101 == execution.Get_Value<std::uint8_t>(1, "Execute"));
+        REQUIRE(execution.Get_Value<bool>(2, "Execute"));
+
+        REQUIRE_THROWS_WITH(
+            execution.Get_Value<std::string>(1, "Execute"),
+            "The requested pipeline state is not stored as the requested type");
+        REQUIRE_THROWS_WITH(
+            execution.Get_Value<std::uint8_t>(0, "Execute"),
+            "The requested pipeline state is not stored as the requested type");
+    }
+
+    SECTION("Get_Stage_Handle")
+    {
+        REQUIRE_NOTHROW(execution.Add_Pipeline_Stage(
+            "Execute", std::vector<std::string>{"add r0, 10", "eors r1, r2"}));
+        REQUIRE_NOTHROW(execution.Add_Value(
+            2, "Execute", GILES::Internal::Execution::State::Stalled));
+
+        const auto execute = execution.Get_Stage_Handle("Execute");
+        REQUIRE(execute.Is_Valid());
+        REQUIRE_FALSE(execution.Get_Stage_Handle("Fetch").Is_Valid());
+
+        REQUIRE("eors r1, r2" ==
+                execution.Get_Value<std::string>(1, execute));
+        REQUIRE("eors" == execution.Get_Instruction(1, execute).Get_Opcode());
+        REQUIRE(execution.Is_Normal_State(0, execute));
+        REQUIRE_FALSE(execution.Is_Normal_State_Unsafe(2, execute));
+        REQUIRE(GILES::Internal::Execution::State::Stalled ==
+                execution.Get_Value<GILES::Internal::Execution::State>(
+                    2, execute));
+
+        // Copies must not share storage with the original.
+        GILES::Internal::Execution copy{execution};
+        REQUIRE_NOTHROW(copy.Add_Value<std::string>(0, "Execute", "nop"));
+        REQUIRE("nop" == copy.Get_Value<std::string>(0, execute));
+        REQUIRE("add r0, 10" == execution.Get_Value<std::string>(0, execute));
+    }
+
     SECTION("Get_Cycle_Count")
     {
         REQUIRE_NOTHROW(3 == execution.Get_Cycle_Count());
@@ -123,6 +170,64 @@ TEST_CASE("Execution class testing"
         REQUIRE(10 == execution.Get_Operand_Value(0, instruction, 2));
     }
 
+    SECTION("Get_Decoded_Instruction")
+    {
+        REQUIRE_NOTHROW(execution.Add_Value<std::string>(
+            0, "Execute", "ldr r0, [r1, #4]"));
+        REQUIRE_NOTHROW(
+            execution.Add_Value<std::string>(1, "Execute", "ldr r0, 10"));
+        REQUIRE_NOTHROW(execution.Add_Value(
+            2, "Execute", GILES::Internal::Execution::State::Stalled));
+
+        // Registers added after the instructions must still be resolved.
+        REQUIRE_NOTHROW(
+            execution.Add_Registers_All({{{"r0", 7}, {"r1", 3}, {"sp", 9}},
+                                         {{"r0", 8}, {"r1", 4}, {"sp", 9}},
+                                         {{"r0", 9}, {"r1", 5}, {"sp", 9}}}));
+
+        const auto execute = execution.Get_Stage_Handle("Execute");
+        const auto& first  = execution.Get_Decoded_Instruction(0, execute);
+        const auto& second = execution.Get_Decoded_Instruction(1, execute);
+
+        // Identical opcodes share an ID.
+        REQUIRE(first.Opcode == second.Opcode);
+        REQUIRE(1 == execution.Get_Opcode_Count());
+        REQUIRE("ldr" == execution.Get_Opcode(first));
+
+        REQUIRE(3 == first.Number_of_Operands);
+        REQUIRE(GILES::Internal::Operand_Type::Register ==
+                first.Operands[0].Type);
+        REQUIRE(GILES::Internal::Operand_Type::Memory ==
+                first.Operands[1].Type);
+        REQUIRE(GILES::Internal::Decoded_Operand::no_register !=
+                first.Operands[1].Register);
+        REQUIRE(GILES::Internal::Operand_Type::Memory ==
+                first.Operands[2].Type);
+        REQUIRE(GILES::Internal::Operand_Type::None == first.Operands[3].Type);
+        REQUIRE(GILES::Internal::Operand_Type::Immediate ==
+                second.Operands[1].Type);
+
+        // The values must match those of the non decoded instruction.
+        for (std::uint32_t cycle{0}; cycle < 2; ++cycle)
+        {
+            const auto& decoded =
+                execution.Get_Decoded_Instruction(cycle, execute);
+            const auto instruction = execution.Get_Instruction(cycle, execute);
+
+            for (std::uint8_t operand{0}; operand < 5; ++operand)
+            {
+                REQUIRE(
+                    execution.Get_Operand_Value(cycle, instruction, operand) ==
+                    execution.Get_Operand_Value(cycle, decoded, operand));
+            }
+        }
+
+        REQUIRE_THROWS(execution.Get_Decoded_Instruction(2, execute));
+        REQUIRE_THROWS(execution.Get_Decoded_Instruction(3, execute));
+        REQUIRE_THROWS(execution.Get_Decoded_Instruction(
+            0, execution.Get_Stage_Handle("Fetch")));
+    }
+
     SECTION("Get_Registers")
     {
         std::map<std::string, std::size_t> registers{
@@ -140,6 +245,55 @@ TEST_CASE("Execution class testing"
         REQUIRE_THROWS(execution.Get_Registers(-1));
     }
 
+    SECTION("Add_Registers_All fixed layout")
+    {
+        const std::array<std::string, 3> names{"r0", "r1", "sp"};
+        REQUIRE_NOTHROW(execution.Add_Registers_All(
+            names,
+            std::vector<std::array<std::uint32_t, 3>>{
+                {7, 3, 9}, {8, 4, 9}, {9, 5, 9}}));
+
+        // The position of a register within the layout is its ID.
+        REQUIRE(0 == execution.Get_Register_ID("r0"));
+        REQUIRE(2 == execution.Get_Register_ID("sp"));
+        REQUIRE(GILES::Internal::Decoded_Operand::no_register ==
+                execution.Get_Register_ID("r2"));
+
+        REQUIRE(5 == execution.Get_Register_Value(2, 1));
+        REQUIRE(5 == execution.Get_Register_Value(2, "r1"));
+        REQUIRE(execution.Is_Register("sp"));
+
+        const std::map<std::string, std::size_t> registers{
+            {"r0", 8}, {"r1", 4}, {"sp", 9}};
+        REQUIRE(registers == execution.Get_Registers(1));
+
+        REQUIRE_THROWS(execution.Get_Register_Value(0, 3));
+        REQUIRE_THROWS(execution.Get_Register_Value(3, 0));
+    }
+
+    SECTION("Add_Registers_Cycle out of order")
+    {
+        REQUIRE_NOTHROW(execution.Add_Registers_Cycle(2, {{"r1", 3}}));
+        REQUIRE_NOTHROW(execution.Add_Registers_Cycle(0, {{"r1", 1}}));
+
+        REQUIRE(1 == execution.Get_Register_Value(0, "r1"));
+        REQUIRE(3 == execution.Get_Register_Value(2, "r1"));
+
+        // Cycle 1 was skipped so nothing was recorded.
+        REQUIRE(execution.Get_Registers(1).empty());
+        REQUIRE_THROWS(execution.Get_Register_Value(1, "r1"));
+
+        // A new register changes the layout but keeps the existing values.
+        REQUIRE_NOTHROW(execution.Add_Registers_Cycle(1, {{"r0", 2}}));
+        REQUIRE(1 == execution.Get_Register_Value(0, "r1"));
+        REQUIRE(2 == execution.Get_Register_Value(1, "r0"));
+        REQUIRE(3 == execution.Get_Register_Value(2, "r1"));
+
+        auto cursor = execution.Get_Register_Cursor();
+        REQUIRE(1 == cursor.Get_Value(0, execution.Get_Register_ID("r1")));
+        REQUIRE(3 == cursor.Get_Value(2, execution.Get_Register_ID("r1")));
+    }
+
     SECTION("Get_Register_Value")
     {
         REQUIRE_NOTHROW(execution.Add_Registers_Cycle(
@@ -222,5 +376,30 @@ TEST_CASE("Execution class testing"
         REQUIRE_FALSE(execution.Is_Normal_State_Unsafe(1, "Execute"));
 
         REQUIRE_FALSE(execution.Is_Normal_State_Unsafe(100, "Execute"));
+
+        // Test Find_State with valid parameters.
+        REQUIRE(GILES::Internal::Execution::State::Normal ==
+                execution.Find_State(0, "Execute"));
+
+        REQUIRE(GILES::Internal::Execution::State::Stalled ==
+                execution.Find_State(0, "Stalled"));
+
+        REQUIRE(GILES::Internal::Execution::State::Flushing ==
+                execution.Find_State(1, "Flush"));
+
+        // Test Find_State with invalid parameters.
+        REQUIRE_FALSE(execution.Find_State(0, "Invalid").has_value());
+
+        REQUIRE_FALSE(execution.Find_State(-1, "Execute").has_value());
+
+        REQUIRE_FALSE(execution.Find_State(1, "Execute").has_value());
+
+        REQUIRE_FALSE(execution.Find_State(100, "Execute").has_value());
+
+        // None of the state queries should require exceptions.
+        const auto execute = execution.Get_Stage_Handle("Execute");
+        STATIC_REQUIRE(noexcept(execution.Find_State(0, execute)));
+        STATIC_REQUIRE(noexcept(execution.Get_State_Unsafe(0, execute)));
+        STATIC_REQUIRE(noexcept(execution.Is_Normal_State_Unsafe(0, execute)));
     }
 }
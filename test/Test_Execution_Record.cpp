@@ -0,0 +1,162 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Execution_Record.cpp
+    @brief Contains the tests for the Execution_Record_Writer and
+    Execution_Record_Reader classes.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <array>    // for array
+#include <cstdint>  // for uint32_t
+#include <cstdio>   // for remove
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "Arena.hpp"
+#include "Execution.hpp"
+#include "Execution_Record.hpp"
+#include "Test_Utility.hpp"  // for Make_Execution
+
+namespace
+{
+//! @brief Creates an Execution containing p_number_of_cycles clock cycles of
+//! instructions, registers and stalls.
+//! @param p_number_of_cycles The number of clock cycles in the Execution.
+//! @param p_seed Varies the contents of the Execution.
+//! @returns The Execution.
+GILES::Internal::Execution
+make_recorded_execution(const std::size_t p_number_of_cycles,
+                        const std::uint32_t p_seed)
+{
+    auto execution = GILES::Test::Make_Execution(
+        p_number_of_cycles,
+        {{"Decode", {"lsls r1, r2, #3", "movs r0, #7"}},
+         {"Execute", {"adds r0, r1", "eors r2, r0", "eors r2, r0"}}},
+        std::array<std::string, 3>{"r0", "r1", "r2"},
+        [p_seed](const std::size_t p_cycle,
+                 std::array<std::uint32_t, 3>& p_registers) {
+            p_registers = {static_cast<std::uint32_t>(p_cycle * p_seed),
+                           static_cast<std::uint32_t>(p_cycle / 5),
+                           static_cast<std::uint32_t>(p_cycle ^ p_seed)};
+        });
+    execution.Add_Value(
+        1, "Execute", GILES::Internal::Execution::State::Stalled);
+    execution.Add_Value(
+        2, "Decode", GILES::Internal::Execution::State::Flushing);
+    return execution;
+}
+
+//! @brief Checks that p_replayed contains exactly the same data as
+//! p_original.
+void require_same_execution(const GILES::Internal::Execution& p_original,
+                            const GILES::Internal::Execution& p_replayed)
+{
+    REQUIRE(p_original.Get_Cycle_Count() == p_replayed.Get_Cycle_Count());
+    REQUIRE(p_original.Get_Opcode_Count() == p_replayed.Get_Opcode_Count());
+
+    for (const auto& stage_name : {"Decode", "Execute"})
+    {
+        const auto original = p_original.Get_Stage_Handle(stage_name);
+        const auto replayed = p_replayed.Get_Stage_Handle(stage_name);
+        REQUIRE(replayed.Is_Valid());
+
+        for (std::uint32_t cycle{0}; cycle < p_original.Get_Cycle_Count();
+             ++cycle)
+        {
+            REQUIRE(p_original.Get_State(cycle, original) ==
+                    p_replayed.Get_State(cycle, replayed));
+            if (!p_original.Is_Normal_State(cycle, original))
+            {
+                continue;
+            }
+
+            REQUIRE(p_original.Get_Value<std::string>(cycle, original) ==
+                    p_replayed.Get_Value<std::string>(cycle, replayed));
+
+            const auto& expected =
+                p_original.Get_Decoded_Instruction(cycle, original);
+            const auto& instruction =
+                p_replayed.Get_Decoded_Instruction(cycle, replayed);
+            REQUIRE(p_original.Get_Opcode(expected) ==
+                    p_replayed.Get_Opcode(instruction));
+            for (std::uint8_t operand{1};
+                 operand <= instruction.Number_of_Operands;
+                 ++operand)
+            {
+                REQUIRE(
+                    p_original.Get_Operand_Value(cycle, expected, operand) ==
+                    p_replayed.Get_Operand_Value(cycle, instruction, operand));
+            }
+        }
+    }
+
+    for (std::size_t cycle{0}; cycle < p_original.Get_Cycle_Count(); ++cycle)
+    {
+        for (const auto& register_name : {"r0", "r1", "r2"})
+        {
+            REQUIRE(p_original.Get_Register_Value(cycle, register_name) ==
+                    p_replayed.Get_Register_Value(cycle, register_name));
+        }
+    }
+}
+}  // namespace
+
+TEST_CASE("Execution_Record class testing"
+          "[execution_record]")
+{
+    const std::string path{"GILES_Test_Execution_Record.bin"};
+
+    const auto first  = make_recorded_execution(150, 3);
+    const auto second = make_recorded_execution(70, 11);
+    {
+        GILES::Internal::Execution_Record_Writer writer{path};
+        writer.Write(first, "first extra data");
+        writer.Write(second, "");
+    }
+
+    const GILES::Internal::Execution_Record_Reader reader{path};
+
+    SECTION("Every record is stored")
+    {
+        REQUIRE(2 == reader.Get_Record_Count());
+        REQUIRE("first extra data" == reader.Get_Extra_Data(0));
+        REQUIRE(reader.Get_Extra_Data(1).empty());
+    }
+
+    SECTION("Replayed Executions are identical to those recorded")
+    {
+        require_same_execution(first, reader.Read_Execution(0));
+        require_same_execution(second, reader.Read_Execution(1));
+    }
+
+    SECTION("Records can be read in any order from any memory resource")
+    {
+        GILES::Internal::Arena arena;
+        const auto replayed = reader.Read_Execution(1, &arena);
+        REQUIRE(&arena == replayed.Get_Memory_Resource());
+        require_same_execution(second, replayed);
+        require_same_execution(first, reader.Read_Execution(0, &arena));
+    }
+
+    std::remove(path.c_str());
+}
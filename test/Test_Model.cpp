@@ -0,0 +1,460 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Model.cpp
+    @brief Contains the tests for the Model class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <algorithm>  // for find
+#include <array>      // for array
+#include <atomic>     // for atomic
+#include <cmath>      // for abs, ldexp
+#include <cstdint>    // for uint32_t
+#include <cstdlib>    // for free, malloc
+#include <memory>     // for make_shared, shared_ptr
+#include <new>        // for bad_alloc, nothrow_t
+#include <string>     // for string
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+#include <nlohmann/json.hpp>  // for json
+
+#include "Abstract_Factory.hpp"  // for Model_Factory
+#include "Coefficients.hpp"
+#include "Execution.hpp"
+#include "Model.hpp"
+#include "Power/Model_Power.hpp"  // for Model_Power
+#include "Test_Utility.hpp"       // for Make_Execution
+
+namespace
+{
+//! The number of times that memory has been dynamically allocated by the tests.
+std::atomic<std::size_t> number_of_allocations{0};
+
+//! @brief Counts the number of allocations made whilst an Execution containing
+//! p_number_of_cycles clock cycles is handed to p_number_of_models Models.
+//! @param p_number_of_cycles The number of clock cycles in the Execution.
+//! @param p_number_of_models The number of Models to construct.
+//! @returns The number of allocations.
+std::size_t count_hand_off_allocations(const std::size_t p_number_of_cycles,
+                                       const std::size_t p_number_of_models)
+{
+    const GILES::Internal::Coefficients coefficients{nlohmann::json::object()};
+    const std::string model_name{"Hamming Weight"};
+    auto execution = GILES::Test::Make_Execution(p_number_of_cycles);
+
+    std::vector<std::unique_ptr<GILES::Internal::Model>> models;
+    models.reserve(p_number_of_models);
+
+    const auto allocations_before = number_of_allocations.load();
+
+    const auto shared_execution =
+        std::make_shared<const GILES::Internal::Execution>(
+            std::move(execution));
+    for (std::size_t i{0}; i < p_number_of_models; ++i)
+    {
+        models.push_back(GILES::Internal::Model_Factory::Construct(
+            model_name, shared_execution, coefficients));
+    }
+
+    return number_of_allocations.load() - allocations_before;
+}
+
+//! @brief Counts the number of allocations made whilst the Power model
+//! generates the trace of an Execution containing p_number_of_cycles clock
+//! cycles.
+//! @param p_number_of_cycles The number of clock cycles in the Execution.
+//! @returns The number of allocations and the length of the trace.
+std::pair<std::size_t, std::size_t>
+count_power_allocations(const std::size_t p_number_of_cycles)
+{
+    const GILES::Internal::Coefficients coefficients{
+        GILES::Test::Make_Power_Coefficients()};
+    const auto model = GILES::Internal::Model_Factory::Construct(
+        "Power",
+        std::make_shared<const GILES::Internal::Execution>(
+            GILES::Test::Make_Execution(p_number_of_cycles)),
+        coefficients);
+
+    const auto allocations_before = number_of_allocations.load();
+    const auto trace              = model->Generate_Traces();
+    return {number_of_allocations.load() - allocations_before, trace.size()};
+}
+}  // namespace
+
+//! @brief Replaces the global operator new so that allocations can be counted.
+//! @see https://en.cppreference.com/w/cpp/memory/new/operator_new
+void* operator new(std::size_t p_size)
+{
+    ++number_of_allocations;
+    if (void* memory = std::malloc(0 == p_size ? 1 : p_size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+//! @brief Replaces the global operator delete to match the replaced operator
+//! new, as memory allocated with std::malloc must be freed with std::free.
+//! @see https://en.cppreference.com/w/cpp/memory/new/operator_delete
+void operator delete(void* p_memory) noexcept
+{
+    std::free(p_memory);
+}
+
+//! @brief Replaces the sized global operator delete to match the replaced
+//! operator new.
+//! @see https://en.cppreference.com/w/cpp/memory/new/operator_delete
+void operator delete(void* p_memory, std::size_t) noexcept
+{
+    std::free(p_memory);
+}
+
+//! @brief Replaces the non-throwing global operator new, which is used by
+//! Catch and is not always implemented using the replaced operator new.
+//! @see https://en.cppreference.com/w/cpp/memory/new/operator_new
+void* operator new(std::size_t p_size, const std::nothrow_t&) noexcept
+{
+    ++number_of_allocations;
+    return std::malloc(0 == p_size ? 1 : p_size);
+}
+
+//! @brief Replaces the non-throwing global operator delete to match the
+//! replaced non-throwing operator new.
+//! @see https://en.cppreference.com/w/cpp/memory/new/operator_delete
+void operator delete(void* p_memory, const std::nothrow_t&) noexcept
+{
+    std::free(p_memory);
+}
+
+TEST_CASE("Model class testing"
+          "[model]")
+{
+    const GILES::Internal::Coefficients coefficients{nlohmann::json::object()};
+
+    SECTION("The Execution is moved, not copied, into a shared Execution")
+    {
+        auto execution = GILES::Test::Make_Execution(100);
+
+        const auto allocations_before = number_of_allocations.load();
+        const auto shared_execution =
+            std::make_shared<const GILES::Internal::Execution>(
+                std::move(execution));
+
+        // Only the shared_ptr itself is allocated.
+        REQUIRE(1 == number_of_allocations.load() - allocations_before);
+        REQUIRE(100 == shared_execution->Get_Cycle_Count());
+        REQUIRE(99 == shared_execution->Get_Register_Value(99, "r0"));
+    }
+
+    SECTION("Models share the Execution")
+    {
+        const auto shared_execution =
+            std::make_shared<const GILES::Internal::Execution>(
+                GILES::Test::Make_Execution(100));
+
+        {
+            const auto first = GILES::Internal::Model_Factory::Construct(
+                "Hamming Weight", shared_execution, coefficients);
+            const auto second = GILES::Internal::Model_Factory::Construct(
+                "Hamming Weight", shared_execution, coefficients);
+
+            REQUIRE(3 == shared_execution.use_count());
+            REQUIRE(first->Generate_Traces() == second->Generate_Traces());
+        }
+
+        // The Models no longer hold on to the Execution once destroyed.
+        REQUIRE(1 == shared_execution.use_count());
+    }
+
+    SECTION("Allocations per trace do not depend on the size of the Execution")
+    {
+        // Handing an Execution to the Models must never copy it so the
+        // number of allocations is the same no matter how many clock cycles
+        // it contains.
+        REQUIRE(count_hand_off_allocations(10, 1) ==
+                count_hand_off_allocations(10000, 1));
+        REQUIRE(count_hand_off_allocations(10, 4) ==
+                count_hand_off_allocations(10000, 4));
+    }
+
+    SECTION("The Power model allocates nothing per clock cycle")
+    {
+        const auto [short_allocations, short_size] =
+            count_power_allocations(10);
+        const auto [long_allocations, long_size] =
+            count_power_allocations(10000);
+
+        // The first and last clock cycles do not produce a sample.
+        REQUIRE(8 == short_size);
+        REQUIRE(9998 == long_size);
+
+        // Only the trace itself is allocated.
+        REQUIRE(1 == short_allocations);
+        REQUIRE(short_allocations == long_allocations);
+    }
+
+    SECTION("Executions with too few clock cycles produce no samples")
+    {
+        const GILES::Internal::Coefficients power_coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+        for (const std::size_t cycles : {0, 1, 2})
+        {
+            INFO(cycles << " clock cycles");
+            const auto execution =
+                std::make_shared<const GILES::Internal::Execution>(
+                    GILES::Test::Make_Execution(cycles));
+
+            REQUIRE(cycles == GILES::Internal::Model_Factory::Construct(
+                                  "Hamming Weight", execution, coefficients)
+                                  ->Generate_Traces()
+                                  .size());
+
+            for (const std::string name :
+                 {"Power", "Power Float", "Power Fixed Point"})
+            {
+                const auto model = GILES::Internal::Model_Factory::Construct(
+                    name, execution, power_coefficients);
+                REQUIRE(model->Generate_Traces().empty());
+
+                GILES::Internal::Model::Term_Traces term_traces;
+                const auto batch =
+                    model->Generate_Batch_Term_Traces({execution}, term_traces);
+                REQUIRE(2 == batch.size());
+                REQUIRE(batch[0].empty());
+                REQUIRE(batch[1].empty());
+                REQUIRE(2 == term_traces.size());
+                REQUIRE(model->Get_Term_Names().size() ==
+                        term_traces[1].size());
+                REQUIRE(term_traces[1][0].empty());
+            }
+        }
+    }
+
+    SECTION("Batches of traces match traces generated one at a time")
+    {
+        using Executions =
+            std::vector<std::shared_ptr<const GILES::Internal::Execution>>;
+        const GILES::Internal::Coefficients power_coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+
+        // Executions with the same instructions but different data. More
+        // clock cycles than fit in a block are used.
+        Executions executions;
+        for (const std::uint32_t data : {0u, 7u, 0xDEADu})
+        {
+            executions.push_back(
+                std::make_shared<const GILES::Internal::Execution>(
+                    GILES::Test::Make_Execution(300, data)));
+        }
+
+        const auto model = GILES::Internal::Model_Factory::Construct(
+            "Power", executions[0], power_coefficients);
+        REQUIRE(model->Has_Same_Schedule(*executions[1]));
+        REQUIRE(model->Has_Same_Schedule(*executions[2]));
+
+        const auto batch = model->Generate_Batch_Traces(
+            Executions(executions.begin() + 1, executions.end()));
+        REQUIRE(executions.size() == batch.size());
+        REQUIRE(batch[0] != batch[1]);
+        for (std::size_t i{0}; i < executions.size(); ++i)
+        {
+            REQUIRE(GILES::Internal::Model_Factory::Construct(
+                        "Power", executions[i], power_coefficients)
+                        ->Generate_Traces() == batch[i]);
+        }
+
+        // Executions that ran different instructions, or for a different
+        // number of clock cycles, are not batched.
+        REQUIRE_FALSE(model->Has_Same_Schedule(
+            GILES::Test::Make_Execution(300, 0, "lsls r2, r0")));
+        REQUIRE_FALSE(
+            model->Has_Same_Schedule(GILES::Test::Make_Execution(301)));
+
+        // Models that are not batched generate each trace in turn.
+        const auto hamming_weight = GILES::Internal::Model_Factory::Construct(
+            "Hamming Weight", executions[0], coefficients);
+        REQUIRE_FALSE(hamming_weight->Has_Same_Schedule(*executions[0]));
+        const auto traces =
+            hamming_weight->Generate_Batch_Traces({executions[1]});
+        REQUIRE(2 == traces.size());
+        REQUIRE(hamming_weight->Generate_Traces() == traces[0]);
+    }
+
+    SECTION("Schedules that are seen again are planned in advance")
+    {
+        const GILES::Internal::Coefficients power_coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+        const auto make_model = [&power_coefficients](
+                                    const std::uint32_t p_data,
+                                    const std::string& p_odd_instruction) {
+            return GILES::Internal::Model_Power{
+                std::make_shared<const GILES::Internal::Execution>(
+                    GILES::Test::Make_Execution(
+                        300, p_data, p_odd_instruction)),
+                power_coefficients};
+        };
+
+        // The first sighting of a schedule is not planned, in case it is
+        // never seen again.
+        auto first = make_model(0, "eors r2, r0");
+        REQUIRE_FALSE(first.Has_Schedule_Plan());
+        auto second = make_model(7, "eors r2, r0");
+        REQUIRE(second.Has_Schedule_Plan());
+        auto third = make_model(0xDEAD, "eors r2, r0");
+        REQUIRE(third.Has_Schedule_Plan());
+
+        // Planned traces match those that are not. Separate Coefficients
+        // are not planned for, even though they hold the same values.
+        const GILES::Internal::Coefficients other_coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+        GILES::Internal::Model_Power unplanned{
+            std::make_shared<const GILES::Internal::Execution>(
+                GILES::Test::Make_Execution(300, 7)),
+            other_coefficients};
+        REQUIRE_FALSE(unplanned.Has_Schedule_Plan());
+        REQUIRE(second.Generate_Traces() == unplanned.Generate_Traces());
+        REQUIRE(second.Generate_Batch_Traces({}) ==
+                unplanned.Generate_Batch_Traces({}));
+
+        // A different schedule is not planned until it is seen again.
+        auto other = make_model(0, "lsls r2, r0");
+        REQUIRE_FALSE(other.Has_Schedule_Plan());
+        REQUIRE(make_model(0, "lsls r2, r0").Has_Schedule_Plan());
+    }
+
+    SECTION("Traces are decomposed into terms in the same pass")
+    {
+        using Executions =
+            std::vector<std::shared_ptr<const GILES::Internal::Execution>>;
+        const GILES::Internal::Coefficients power_coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+
+        Executions executions;
+        for (const std::uint32_t data : {0u, 0xDEADu})
+        {
+            executions.push_back(
+                std::make_shared<const GILES::Internal::Execution>(
+                    GILES::Test::Make_Execution(300, data)));
+        }
+
+        for (const std::string name :
+             {"Power", "Power Float", "Power Fixed Point"})
+        {
+            const auto model = GILES::Internal::Model_Factory::Construct(
+                name, executions[0], power_coefficients);
+            const auto& term_names = model->Get_Term_Names();
+            REQUIRE(12 == term_names.size());
+
+            // The Traces are the same as when they are not decomposed.
+            GILES::Internal::Model::Term_Traces term_traces;
+            const auto traces = model->Generate_Batch_Term_Traces(
+                {executions[1]}, term_traces);
+            REQUIRE(model->Generate_Batch_Traces({executions[1]}) == traces);
+
+            // Each term is a separate column of samples and the terms of a
+            // sample add up to it.
+            REQUIRE(traces.size() == term_traces.size());
+            for (std::size_t i{0}; i < traces.size(); ++i)
+            {
+                REQUIRE(term_names.size() == term_traces[i].size());
+                for (std::size_t sample{0}; sample < traces[i].size();
+                     ++sample)
+                {
+                    double total{0};
+                    for (const auto& term : term_traces[i])
+                    {
+                        REQUIRE(traces[i].size() == term.size());
+                        total += term[sample];
+                    }
+                    REQUIRE(Approx(traces[i][sample]).epsilon(1e-5) == total);
+                }
+            }
+
+            // The operands differ between the Executions, so their terms do.
+            const auto operand_1 = static_cast<std::size_t>(
+                std::find(term_names.begin(), term_names.end(), "Operand1") -
+                term_names.begin());
+            REQUIRE(operand_1 < term_names.size());
+            REQUIRE(term_traces[0][operand_1] != term_traces[1][operand_1]);
+        }
+
+        // Models whose Traces are not sums of terms have none.
+        REQUIRE(GILES::Internal::Model_Factory::Construct(
+                    "Hamming Weight", executions[0], coefficients)
+                    ->Get_Term_Names()
+                    .empty());
+    }
+
+    SECTION("Reduced precisions stay within their error bounds")
+    {
+        using GILES::Internal::Model_Power;
+        const GILES::Internal::Coefficients power_coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+
+        // Each precision is its own Model, which records the same data.
+        for (const auto precision :
+             {Model_Power::Precision::Float,
+              Model_Power::Precision::Fixed_Point})
+        {
+            REQUIRE(&GILES::Internal::Model::Get_Data_Requirements("Power") ==
+                    &GILES::Internal::Model::Get_Data_Requirements(
+                        Model_Power::Get_Name(precision)));
+        }
+
+        // Every coefficient is rounded by at most half of the smallest fixed
+        // point step and the constant is one.
+        const double fixed_point_bound{
+            2370 * std::ldexp(1.0,
+                              -power_coefficients.Get_Compiled()
+                                      .Get_Fixed_Point_Bits() -
+                                  1)};
+
+        for (const std::uint32_t data : {0u, 7u, 0xDEADu})
+        {
+            const auto execution =
+                std::make_shared<const GILES::Internal::Execution>(
+                    GILES::Test::Make_Execution(300, data));
+            const auto generate_traces = [&](const std::string& p_model) {
+                return GILES::Internal::Model_Factory::Construct(
+                           p_model, execution, power_coefficients)
+                    ->Generate_Traces();
+            };
+            const auto reference   = generate_traces("Power");
+            const auto single      = generate_traces("Power Float");
+            const auto fixed_point = generate_traces("Power Fixed Point");
+
+            REQUIRE(reference.size() == single.size());
+            REQUIRE(reference.size() == fixed_point.size());
+            for (std::size_t i{0}; i < reference.size(); ++i)
+            {
+                REQUIRE(Approx(reference[i]).epsilon(1e-5) == single[i]);
+
+                // Each sample is also rounded to a float.
+                REQUIRE(std::abs(reference[i] - fixed_point[i]) <=
+                        fixed_point_bound +
+                            std::abs(reference[i]) * std::ldexp(1.0, -23));
+            }
+        }
+    }
+}
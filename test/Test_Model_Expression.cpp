@@ -0,0 +1,302 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Model_Expression.cpp
+    @brief Contains the tests for the expression language and the
+    Model_Expression class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <cmath>      // for abs
+#include <cstdint>    // for uint32_t
+#include <cstdio>     // for remove
+#include <fstream>    // for ofstream
+#include <memory>     // for make_shared
+#include <stdexcept>  // for invalid_argument
+#include <string>     // for string
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+#include <nlohmann/json.hpp>  // for json
+
+#include "Abstract_Factory.hpp"               // for Model_Factory
+#include "Coefficients.hpp"                   // for Coefficients
+#include "Execution.hpp"                      // for Execution
+#include "Expression/Expression_Program.hpp"  // for Expression_Program
+#include "Expression/Model_Expression.hpp"    // for Model_Expression
+#include "Test_Utility.hpp"                   // for Make_Execution
+
+namespace
+{
+//! @brief Retrieves an operand of the instruction in the "Execute" pipeline
+//! stage, or zero if there is no instruction, as the expression language
+//! does.
+//! @param p_execution The Execution.
+//! @param p_cycle The clock cycle, which may be out of range.
+//! @param p_operand The operand, starting from 1.
+//! @returns The value of the operand.
+std::uint32_t get_operand(const GILES::Internal::Execution& p_execution,
+                          const std::size_t p_cycle,
+                          const std::uint8_t p_operand)
+{
+    if (p_execution.Get_Cycle_Count() <= p_cycle)
+    {
+        return 0;
+    }
+    const auto execute = p_execution.Get_Stage_Handle("Execute");
+    return static_cast<std::uint32_t>(p_execution.Get_Operand_Value(
+        p_cycle,
+        p_execution.Get_Decoded_Instruction(
+            static_cast<std::uint32_t>(p_cycle), execute),
+        p_operand));
+}
+}  // namespace
+
+TEST_CASE("Expression language testing"
+          "[expression]")
+{
+    using GILES::Internal::Expression_Program;
+
+    SECTION("Models are compiled into instructions")
+    {
+        const auto program = Expression_Program::Compile(
+            "# The Hamming distance of the first operands.\n"
+            "flips = op1 ^ prev.op1;\n"
+            "unused = hw(op2) * 3;\n"
+            "leakage = 0.5 * hw(flips) + bits(\"Operand1\", 0x0F);\n");
+
+        // The unused assignment is removed. What is left is the Xor and
+        // Hamming weight, the literals, a multiplication, the bits and the
+        // addition.
+        REQUIRE(7 == program.Get_Instructions().size());
+        REQUIRE(std::vector<std::string>{"Operand1"} == program.Get_Terms());
+        REQUIRE(std::vector<double>{0.5} == program.Get_Reals());
+        REQUIRE_FALSE(program.Uses_Constant());
+        REQUIRE(Expression_Program::number_of_operand_registers <=
+                program.Get_Integer_Register_Count());
+
+        REQUIRE(Expression_Program::Compile("leakage = constant * hw(op1);")
+                    .Uses_Constant());
+        REQUIRE_FALSE(Expression_Program::Compile(
+                          "unused = constant; leakage = hw(op1);")
+                          .Uses_Constant());
+
+        // The terms, coefficients and literals of removed instructions are
+        // removed too, and the rest are renumbered.
+        const auto renumbered = Expression_Program::Compile(
+            "x = coefficient(\"Nope\", prev) * 2.5;\n"
+            "leakage = 0.5 * bits(\"Operand1\", op1);\n");
+        REQUIRE(std::vector<std::string>{"Operand1"} ==
+                renumbered.Get_Terms());
+        REQUIRE(renumbered.Get_Coefficients().empty());
+        REQUIRE(std::vector<double>{0.5} == renumbered.Get_Reals());
+        for (const auto& instruction : renumbered.Get_Instructions())
+        {
+            if (Expression_Program::Operation::Weigh_Bits == instruction.Op ||
+                Expression_Program::Operation::Load_Real == instruction.Op)
+            {
+                REQUIRE(0 == instruction.Argument);
+            }
+        }
+    }
+
+    SECTION("Integers are decimal unless they start with 0x")
+    {
+        for (const auto& [source, value] :
+             {std::pair{"leakage = 010;", 10u},
+              std::pair{"leakage = 09;", 9u},
+              std::pair{"leakage = 0x10;", 16u},
+              std::pair{"leakage = 0XfF;", 255u}})
+        {
+            INFO(source);
+            const auto program = Expression_Program::Compile(source);
+            REQUIRE(Expression_Program::Operation::Load_Integer ==
+                    program.Get_Instructions().front().Op);
+            REQUIRE(value == program.Get_Instructions().front().Argument);
+        }
+    }
+
+    SECTION("Invalid models are rejected with their position")
+    {
+        const std::vector<std::string> invalid{
+            "",
+            "x = hw(op1);",
+            "leakage = hw(op1)",
+            "leakage = hw(op3);",
+            "leakage = hw(prev.op3);",
+            "leakage = ~1.5;",
+            "leakage = hw(op1 + 1);",
+            "leakage = undefined;",
+            "leakage = 1; leakage = 2;",
+            "op1 = 1; leakage = op1;",
+            "leakage = bits(Operand1, op1);",
+            "leakage = coefficient(\"Previous_Instruction\", op1);",
+            "leakage = unknown(op1);",
+            "leakage = 0x100000000;",
+            "leakage = (hw(op1);",
+            "leakage = hw(op1) $ 2;",
+            "leakage = bits(\"Operand1, op1);",
+            "leakage = 0x;",
+            "leakage = 0x1g;"};
+        for (const auto& source : invalid)
+        {
+            INFO(source);
+            REQUIRE_THROWS_AS(Expression_Program::Compile(source),
+                              std::invalid_argument);
+        }
+
+        REQUIRE_THROWS_WITH(Expression_Program::Compile("\n  leakage = x;"),
+                            Catch::Contains("Line 2, column 13"));
+
+        // Each argument of hd() is reported at its own position.
+        REQUIRE_THROWS_WITH(
+            Expression_Program::Compile("leakage = hd(1.5, op1);"),
+            Catch::Contains("Line 1, column 14"));
+        REQUIRE_THROWS_WITH(
+            Expression_Program::Compile("leakage = hd(op1, 1.5);"),
+            Catch::Contains("Line 1, column 19"));
+    }
+
+    SECTION("The Hamming weight model can be written as an expression")
+    {
+        GILES::Internal::Model_Expression::Register("Expression HW",
+                                                    "leakage = hw(op1);");
+        REQUIRE(GILES::Internal::Model_Factory::Get_All().count(
+            "Expression HW"));
+        REQUIRE(GILES::Internal::Model::Get_Data_Requirements("Expression HW")
+                    .Pipeline_Stages ==
+                GILES::Internal::Model_Expression::Get_Data_Requirements()
+                    .Pipeline_Stages);
+
+        const GILES::Internal::Coefficients coefficients{
+            nlohmann::json::object()};
+        // Enough clock cycles for several blocks and a partial one.
+        const auto execution =
+            std::make_shared<const GILES::Internal::Execution>(
+                GILES::Test::Make_Execution(1000, 5));
+
+        const auto expected = GILES::Internal::Model_Factory::Construct(
+            "Hamming Weight", execution, coefficients);
+        const auto model = GILES::Internal::Model_Factory::Construct(
+            "Expression HW", execution, coefficients);
+        REQUIRE(expected->Generate_Traces() == model->Generate_Traces());
+    }
+
+    SECTION("Neighbouring instructions and coefficients are used")
+    {
+        const nlohmann::json json = GILES::Test::Make_Power_Coefficients();
+        const GILES::Internal::Coefficients coefficients{json};
+        const auto execution =
+            std::make_shared<const GILES::Internal::Execution>(
+                GILES::Test::Make_Execution(200, 3, "lsls r2, r0"));
+
+        GILES::Internal::Model_Expression model{
+            execution,
+            coefficients,
+            std::make_shared<const Expression_Program>(
+                Expression_Program::Compile(
+                    "flips = op1 ^ prev.op1;\n"
+                    "leakage = constant * (bits(\"Operand1\", op2)\n"
+                    "    + hd(flips, next.op2) / 2\n"
+                    "    + coefficient(\"Previous_Instruction\", prev)\n"
+                    "    - coefficient(\"Subsequent_Instruction\", next));"))};
+        const auto trace = model.Generate_Traces();
+        REQUIRE(200 == trace.size());
+
+        const auto category = [](const std::size_t p_cycle) {
+            return 0 == p_cycle % 2 ? "ALU" : "Shifts";
+        };
+        for (std::size_t i{0}; i < trace.size(); ++i)
+        {
+            const auto& terms = json[category(i)]["Coefficients"];
+            double expected{0};
+            const std::uint32_t operand_2{get_operand(*execution, i, 2)};
+            for (std::size_t bit{0}; bit < 32; ++bit)
+            {
+                if (operand_2 >> bit & 1)
+                {
+                    expected += terms["Operand1"][bit].get<double>();
+                }
+            }
+
+            const std::uint32_t flips{
+                get_operand(*execution, i, 1) ^
+                (0 == i ? 0 : get_operand(*execution, i - 1, 1))};
+            const std::uint32_t distance{flips ^
+                                         get_operand(*execution, i + 1, 2)};
+            std::uint32_t weight{0};
+            for (std::size_t bit{0}; bit < 32; ++bit)
+            {
+                weight += distance >> bit & 1;
+            }
+            expected += weight / 2.0;
+
+            // The first and last clock cycles have no neighbour so their
+            // coefficients are zero.
+            if (0 != i)
+            {
+                expected += terms["Previous_Instruction"][category(i - 1)]
+                                .get<double>();
+            }
+            if (trace.size() - 1 != i)
+            {
+                expected -= terms["Subsequent_Instruction"][category(i + 1)]
+                                .get<double>();
+            }
+            expected *= json[category(i)]["Constant"].get<double>();
+
+            INFO("Clock cycle " << i);
+            REQUIRE(std::abs(expected - trace[i]) <=
+                    1e-6 * std::abs(expected) + 1e-6);
+        }
+    }
+
+    SECTION("Terms that the leakage doesn't use are not required")
+    {
+        // The Coefficients have no "Nope" term.
+        const GILES::Internal::Coefficients coefficients{
+            GILES::Test::Make_Power_Coefficients()};
+        const auto execution =
+            std::make_shared<const GILES::Internal::Execution>(
+                GILES::Test::Make_Execution(100, 3));
+
+        GILES::Internal::Model_Expression model{
+            execution,
+            coefficients,
+            std::make_shared<const Expression_Program>(
+                Expression_Program::Compile("x = bits(\"Nope\", op1);\n"
+                                            "leakage = hw(op1);"))};
+        REQUIRE(100 == model.Generate_Traces().size());
+    }
+
+    SECTION("Models are named after their file")
+    {
+        const std::string path{"GILES_Test_Expression.expr"};
+        std::ofstream{path} << "leakage = hd(op1, op2);\n";
+        REQUIRE("GILES_Test_Expression" ==
+                GILES::Internal::Model_Expression::Load(path));
+        std::remove(path.c_str());
+
+        REQUIRE(GILES::Internal::Model_Factory::Get_All().count(
+            "GILES_Test_Expression"));
+    }
+}
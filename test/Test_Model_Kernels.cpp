@@ -0,0 +1,88 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Model_Kernels.cpp
+    @brief Contains the tests for the Model_Kernels class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <cstdint>  // for uint32_t
+#include <random>   // for mt19937, uniform_int_distribution
+#include <vector>   // for vector
+
+#include "Model_Kernels.hpp"
+
+TEST_CASE("Model_Kernels"
+          "[model_kernels]")
+{
+    using GILES::Internal::Model_Kernels;
+
+    SECTION("The best supported level is used")
+    {
+        REQUIRE(Model_Kernels::Is_Supported(Model_Kernels::ISA::Scalar));
+        REQUIRE(Model_Kernels::Is_Supported(Model_Kernels::Get_Supported()));
+        REQUIRE(Model_Kernels::Get_Supported() == Model_Kernels::Get().Level);
+    }
+
+    SECTION("Every supported level matches the portable kernels")
+    {
+        std::mt19937 generator{2019};
+        std::uniform_int_distribution<std::uint32_t> values;
+        const auto& scalar = Model_Kernels::Get(Model_Kernels::ISA::Scalar);
+
+        for (const auto level : Model_Kernels::All_ISAs)
+        {
+            if (!Model_Kernels::Is_Supported(level))
+            {
+                continue;
+            }
+            const auto& kernels = Model_Kernels::Get(level);
+            REQUIRE(level == kernels.Level);
+
+            // Include counts of every size, including none.
+            for (std::size_t count{0}; count < 70; ++count)
+            {
+                std::vector<std::uint32_t> input{0x00000000u, 0xFFFFFFFFu};
+                while (input.size() < count + 2)
+                {
+                    input.push_back(values(generator));
+                }
+
+                std::vector<std::uint32_t> expected(input.size());
+                std::vector<std::uint32_t> weights(input.size(), 99);
+                scalar.Hamming_Weights(input.data(), expected.data(), count);
+                kernels.Hamming_Weights(input.data(), weights.data(), count);
+
+                REQUIRE(std::vector<std::uint32_t>(expected.begin(),
+                                                   expected.begin() + count) ==
+                        std::vector<std::uint32_t>(weights.begin(),
+                                                   weights.begin() + count));
+
+                // Nothing is written past the end.
+                for (std::size_t i{count}; i < weights.size(); ++i)
+                {
+                    REQUIRE(99 == weights[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Recording_Window.cpp
+    @brief Contains the tests for the Recording_Window struct.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <cstdint>  // for uint32_t
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "Recording_Window.hpp"
+
+TEST_CASE("Recording_Window class testing"
+          "[recording_window]")
+{
+    // The program counter during each clock cycle. The function of interest
+    // occupies 0x200 to 0x210 and calls a helper at 0x300.
+    const std::vector<std::uint32_t> program_counter{
+        0x100, 0x104, 0x200, 0x204, 0x300, 0x304, 0x208, 0x20C, 0x108, 0x10C};
+    const auto get_program_counter = [&program_counter](
+                                         const std::size_t p_cycle) {
+        return program_counter.at(p_cycle);
+    };
+    const auto find_cycles =
+        [&program_counter,
+         &get_program_counter](const GILES::Internal::Recording_Window& p) {
+            return p.Find_Cycles(program_counter.size(), get_program_counter);
+        };
+
+    GILES::Internal::Recording_Window window;
+
+    SECTION("Everything is recorded by default")
+    {
+        REQUIRE_FALSE(window.Requires_Program_Counter());
+        REQUIRE(std::pair<std::size_t, std::size_t>{0, 10} ==
+                find_cycles(window));
+    }
+
+    SECTION("Cycle window")
+    {
+        window.First_Cycle      = 3;
+        window.Number_of_Cycles = 4;
+        REQUIRE_FALSE(window.Requires_Program_Counter());
+        REQUIRE(std::pair<std::size_t, std::size_t>{3, 7} ==
+                find_cycles(window));
+
+        // The window is clamped to the end of the program.
+        window.Number_of_Cycles = 100;
+        REQUIRE(std::pair<std::size_t, std::size_t>{3, 10} ==
+                find_cycles(window));
+        window.First_Cycle = 100;
+        REQUIRE(std::pair<std::size_t, std::size_t>{10, 10} ==
+                find_cycles(window));
+    }
+
+    SECTION("Trigger")
+    {
+        window.Trigger_Start = 0x200;
+        window.Trigger_Stop  = 0x108;
+        REQUIRE(window.Requires_Program_Counter());
+        REQUIRE(std::pair<std::size_t, std::size_t>{2, 8} ==
+                find_cycles(window));
+
+        // The cycle window is counted from the start of the trigger.
+        window.First_Cycle      = 1;
+        window.Number_of_Cycles = 2;
+        REQUIRE(std::pair<std::size_t, std::size_t>{3, 5} ==
+                find_cycles(window));
+
+        // Nothing is recorded if the trigger is never reached.
+        window.Trigger_Start = 0x400;
+        REQUIRE(find_cycles(window).first == find_cycles(window).second);
+    }
+
+    SECTION("Address range")
+    {
+        // Calls made from within the range are included.
+        window.Address_Range = {0x200, 0x210};
+        REQUIRE(window.Requires_Program_Counter());
+        REQUIRE(std::pair<std::size_t, std::size_t>{2, 8} ==
+                find_cycles(window));
+
+        window.Address_Range = {0x300, 0x304};
+        REQUIRE(std::pair<std::size_t, std::size_t>{4, 5} ==
+                find_cycles(window));
+    }
+
+    SECTION("Windows that are never reached are empty")
+    {
+        // The Emulator reports these as an error rather than recording an
+        // Execution with no clock cycles.
+        window.Address_Range = {0x400, 0x410};
+        const auto [first, last] = find_cycles(window);
+        REQUIRE(first == last);
+
+        window.Address_Range.reset();
+        window.Trigger_Start = 0x200;
+        window.Trigger_Stop  = 0x200;
+        REQUIRE(std::pair<std::size_t, std::size_t>{2, 2} ==
+                find_cycles(window));
+
+        // Nothing is recorded from a program that never ran.
+        window.Trigger_Start.reset();
+        window.Trigger_Stop.reset();
+        REQUIRE(std::pair<std::size_t, std::size_t>{0, 0} ==
+                window.Find_Cycles(0, get_program_counter));
+    }
+}
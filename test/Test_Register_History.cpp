@@ -0,0 +1,115 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+    @file Test_Register_History.cpp
+    @brief Contains the tests for the Register_History class.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#include <catch.hpp>  // for catch
+
+#include <array>    // for array
+#include <cstdint>  // for uint32_t
+#include <vector>   // for vector
+
+#include "Register_History.hpp"
+
+TEST_CASE("Register_History class testing"
+          "[register_history]")
+{
+    // A small keyframe interval so that several keyframes are tested.
+    GILES::Internal::Register_History history{3, 4};
+
+    // The expected value of every register during every clock cycle.
+    std::vector<std::array<std::uint32_t, 3>> expected;
+    std::uint32_t value{1};
+    for (std::size_t cycle{0}; cycle < 21; ++cycle)
+    {
+        std::array<std::uint32_t, 3> registers{
+            expected.empty() ? std::array<std::uint32_t, 3>{}
+                             : expected.back()};
+
+        // Change a varying number of registers, including none at all.
+        for (std::size_t i{0}; i < cycle % 4; ++i)
+        {
+            registers[(cycle + i) % 3] = value++;
+        }
+        expected.push_back(registers);
+        history.Append(registers.data());
+    }
+
+    REQUIRE(21 == history.Get_Cycle_Count());
+    REQUIRE(3 == history.Get_Number_of_Registers());
+
+    SECTION("Get_Value")
+    {
+        for (std::size_t cycle{0}; cycle < expected.size(); ++cycle)
+        {
+            for (std::uint16_t i{0}; i < 3; ++i)
+            {
+                REQUIRE(expected[cycle][i] == history.Get_Value(cycle, i));
+            }
+        }
+    }
+
+    SECTION("Cursor sequential")
+    {
+        auto cursor = history.Get_Cursor();
+        for (std::size_t cycle{0}; cycle < expected.size(); ++cycle)
+        {
+            const auto* const registers = cursor.Seek(cycle);
+            for (std::uint16_t i{0}; i < 3; ++i)
+            {
+                REQUIRE(expected[cycle][i] == registers[i]);
+            }
+        }
+    }
+
+    SECTION("Cursor random access")
+    {
+        auto cursor = history.Get_Cursor();
+        for (const std::size_t cycle : {17, 3, 4, 20, 0, 9, 9, 10, 1})
+        {
+            for (std::uint16_t i{0}; i < 3; ++i)
+            {
+                REQUIRE(expected[cycle][i] == cursor.Get_Value(cycle, i));
+            }
+        }
+    }
+
+    SECTION("Append_Unchanged")
+    {
+        history.Append_Unchanged();
+
+        REQUIRE(22 == history.Get_Cycle_Count());
+        for (std::uint16_t i{0}; i < 3; ++i)
+        {
+            REQUIRE(expected.back()[i] == history.Get_Value(21, i));
+        }
+    }
+
+    SECTION("Clear")
+    {
+        history.Clear(2);
+
+        REQUIRE(0 == history.Get_Cycle_Count());
+        REQUIRE(2 == history.Get_Number_of_Registers());
+    }
+}
@@ -0,0 +1,169 @@
+/*
+    This file is part of GILES.
+
+    GILES is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GILES is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with GILES.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+    @file Test_Utility.hpp
+    @brief Contains helpers for creating the inputs used by the tests.
+    @author Scott Egerton
+    @date 2017-2019
+    @copyright GNU Affero General Public License Version 3+
+*/
+
+#ifndef TEST_UTILITY_HPP
+#define TEST_UTILITY_HPP
+
+#include <array>            // for array
+#include <cstddef>          // for size_t
+#include <cstdint>          // for uint32_t
+#include <memory_resource>  // for memory_resource
+#include <string>           // for string
+#include <utility>          // for pair
+#include <vector>           // for vector
+
+#include <nlohmann/json.hpp>  // for json
+
+#include "Execution.hpp"
+#include "Power/Model_Power.hpp"  // for Model_Power
+
+namespace GILES
+{
+namespace Test
+{
+//! @brief Creates an Execution a clock cycle at a time, in the same way that
+//! an Emulator records one. Each pipeline stage runs its own program, which
+//! is repeated for as long as the Execution lasts, and the registers keep
+//! their values from one clock cycle to the next unless they are changed.
+//! @tparam number_of_registers The number of registers recorded.
+//! @tparam update_t The type of p_update_registers.
+//! @param p_number_of_cycles The number of clock cycles in the Execution.
+//! @param p_stages The name of each pipeline stage, along with its program.
+//! @param p_register_names The name of each register recorded.
+//! @param p_update_registers Called with the clock cycle and the values of
+//! the registers, which are all zero to start with, to change the values of
+//! the registers during that clock cycle.
+//! @param p_resource The memory resource that the Execution is allocated
+//! from.
+//! @returns The Execution.
+template <std::size_t number_of_registers, typename update_t>
+GILES::Internal::Execution Make_Execution(
+    const std::size_t p_number_of_cycles,
+    const std::vector<std::pair<std::string, std::vector<std::string>>>&
+        p_stages,
+    const std::array<std::string, number_of_registers>& p_register_names,
+    update_t p_update_registers,
+    std::pmr::memory_resource* const p_resource =
+        std::pmr::get_default_resource())
+{
+    std::vector<std::vector<std::string>> stages(p_stages.size());
+    std::vector<std::array<std::uint32_t, number_of_registers>> registers;
+    registers.reserve(p_number_of_cycles);
+
+    std::array<std::uint32_t, number_of_registers> current_registers{};
+    for (std::size_t i{0}; i < p_number_of_cycles; ++i)
+    {
+        for (std::size_t stage{0}; stage < p_stages.size(); ++stage)
+        {
+            const auto& program = p_stages[stage].second;
+            stages[stage].push_back(program[i % program.size()]);
+        }
+        p_update_registers(i, current_registers);
+        registers.push_back(current_registers);
+    }
+
+    GILES::Internal::Execution execution{p_number_of_cycles, p_resource};
+    execution.Add_Registers_All(p_register_names, registers);
+    for (std::size_t stage{0}; stage < p_stages.size(); ++stage)
+    {
+        execution.Add_Pipeline_Stage(p_stages[stage].first, stages[stage]);
+    }
+    return execution;
+}
+
+//! @brief Creates an Execution containing p_number_of_cycles clock cycles of
+//! instructions and registers, using the instructions that the Coefficients
+//! of Make_Power_Coefficients() are given for.
+//! @param p_number_of_cycles The number of clock cycles in the Execution.
+//! @param p_data Changes the values of the registers, but not the
+//! instructions.
+//! @param p_odd_instruction The instruction of every odd clock cycle.
+//! @returns The Execution.
+inline GILES::Internal::Execution
+Make_Execution(const std::size_t p_number_of_cycles,
+               const std::uint32_t p_data          = 0,
+               const std::string& p_odd_instruction = "eors r2, r0")
+{
+    return Make_Execution(
+        p_number_of_cycles,
+        {{"Execute", {"adds r0, r1", p_odd_instruction}}},
+        std::array<std::string, 3>{"r0", "r1", "r2"},
+        [p_data](const std::size_t p_cycle,
+                 std::array<std::uint32_t, 3>& p_registers) {
+            p_registers = {static_cast<std::uint32_t>(p_cycle) + p_data,
+                           static_cast<std::uint32_t>(p_cycle * 3) *
+                               (p_data + 1),
+                           static_cast<std::uint32_t>(p_cycle ^ 0xFF) ^
+                               p_data};
+        });
+}
+
+//! @brief Creates Coefficients containing every interaction term used by the
+//! Power model, for the instructions used by Make_Execution().
+//! @returns The Coefficients as JSON.
+inline nlohmann::json Make_Power_Coefficients()
+{
+    const std::array<std::string, 2> categories{"ALU", "Shifts"};
+    const std::array<std::string, 8> list_terms{"Operand1",
+                                                "Operand2",
+                                                "Operand1_Bit_Interactions",
+                                                "Operand2_Bit_Interactions",
+                                                "Bit_Flip1",
+                                                "Bit_Flip2",
+                                                "Bit_Flip1_Bit_Interactions",
+                                                "Bit_Flip2_Bit_Interactions"};
+
+    nlohmann::json json;
+    double value{0};
+    for (const auto& category : categories)
+    {
+        json[category]["Constant"] = 1;
+        for (const auto& term : list_terms)
+        {
+            for (std::size_t i{0}; i < 32; ++i)
+            {
+                json[category]["Coefficients"][term].push_back(value += 0.25);
+            }
+        }
+        for (const auto& term :
+             GILES::Internal::Model_Power::Get_Interaction_Terms())
+        {
+            if (!json[category]["Coefficients"].contains(term))
+            {
+                for (const auto& target : categories)
+                {
+                    json[category]["Coefficients"][term][target] =
+                        value += 0.25;
+                }
+            }
+        }
+    }
+    json["ALU"]["Instructions"]    = {"adds", "eors"};
+    json["Shifts"]["Instructions"] = {"lsls"};
+    return json;
+}
+}  // namespace Test
+}  // namespace GILES
+
+#endif
@@ -33,7 +33,16 @@
 #include <catch.hpp>  // for catch
 
 // The actual tests
+#include "Test_Arena.cpp"
 #include "Test_Coefficients.cpp"
+#include "Test_Coefficients_Cache.cpp"
+#include "Test_Data_Requirements.cpp"
 #include "Test_Execution.cpp"
+#include "Test_Execution_Record.cpp"
 #include "Test_Factory.cpp"
+#include "Test_Model.cpp"
+#include "Test_Model_Expression.cpp"
+#include "Test_Model_Kernels.cpp"
+#include "Test_Recording_Window.cpp"
+#include "Test_Register_History.cpp"
 #include "Test_Validator_Coefficients.cpp"